@@ -0,0 +1,129 @@
+// Abilities.cpp
+
+#include "Abilities.h"
+
+void FAbilityBatch::AddUnit(int32 Handle, int32 BoardId, int32 TeamIndex, const FVector& Location)
+{
+    FSnapshotUnit& Unit = Units.AddDefaulted_GetRef();
+    Unit.Handle = Handle;
+    Unit.BoardId = BoardId;
+    Unit.TeamIndex = TeamIndex;
+    Unit.Location = FVector2D(Location);
+}
+
+void FAbilityBatch::Reset()
+{
+    Units.Reset();
+    Handles.Reset();
+    PositionsX.Reset();
+    PositionsY.Reset();
+    Ranges.Reset();
+}
+
+void FAbilityBatch::SortSnapshot()
+{
+    Units.Sort([](const FSnapshotUnit& A, const FSnapshotUnit& B)
+    {
+        if (A.BoardId != B.BoardId)
+        {
+            return A.BoardId < B.BoardId;
+        }
+        if (A.TeamIndex != B.TeamIndex)
+        {
+            return A.TeamIndex < B.TeamIndex;
+        }
+        return A.Handle < B.Handle;
+    });
+
+    Handles.SetNumUninitialized(Units.Num(), EAllowShrinking::No);
+    PositionsX.SetNumUninitialized(Units.Num(), EAllowShrinking::No);
+    PositionsY.SetNumUninitialized(Units.Num(), EAllowShrinking::No);
+    Ranges.Reset();
+
+    for (int32 Index = 0; Index < Units.Num(); ++Index)
+    {
+        const FSnapshotUnit& Unit = Units[Index];
+        Handles[Index] = Unit.Handle;
+        PositionsX[Index] = Unit.Location.X;
+        PositionsY[Index] = Unit.Location.Y;
+
+        if (Ranges.Num() == 0 || Ranges.Last().BoardId != Unit.BoardId || Ranges.Last().TeamIndex != Unit.TeamIndex)
+        {
+            FTeamRange& Range = Ranges.AddDefaulted_GetRef();
+            Range.BoardId = Unit.BoardId;
+            Range.TeamIndex = Unit.TeamIndex;
+            Range.Start = Index;
+        }
+        ++Ranges.Last().Num;
+    }
+}
+
+void FAbilityBatch::Resolve(TConstArrayView<FAbilityCast> Casts, TArray<FAbilityHit>& OutHits)
+{
+    SortSnapshot();
+
+    for (int32 CastIndex = 0; CastIndex < Casts.Num(); ++CastIndex)
+    {
+        const FAbilityCast& Cast = Casts[CastIndex];
+        if (Cast.Shape == EAbilityShape::None)
+        {
+            continue;
+        }
+
+        for (const FTeamRange& Range : Ranges)
+        {
+            const bool bAlly = Range.TeamIndex == Cast.TeamIndex;
+            if (Range.BoardId != Cast.BoardId || bAlly != (Cast.Targets == EAbilityTargets::Allies))
+            {
+                continue;
+            }
+
+            const int32 End = Range.Start + Range.Num;
+            for (int32 Index = Range.Start; Index < End; ++Index)
+            {
+                if (IsInside(Cast, PositionsX[Index], PositionsY[Index]))
+                {
+                    OutHits.Add({ CastIndex, Handles[Index] });
+                }
+            }
+        }
+    }
+}
+
+bool FAbilityBatch::IsInside(const FAbilityCast& Cast, float X, float Y)
+{
+    const float DeltaX = X - Cast.Origin.X;
+    const float DeltaY = Y - Cast.Origin.Y;
+    const float DistanceSq = DeltaX * DeltaX + DeltaY * DeltaY;
+
+    switch (Cast.Shape)
+    {
+    case EAbilityShape::Circle:
+        return DistanceSq <= Cast.Radius * Cast.Radius;
+
+    case EAbilityShape::Line:
+    {
+        const float Along = DeltaX * Cast.Direction.X + DeltaY * Cast.Direction.Y;
+        const float Across = DeltaX * Cast.Direction.Y - DeltaY * Cast.Direction.X;
+        return Along >= 0.0f && Along <= Cast.Radius && FMath::Abs(Across) <= Cast.HalfWidth;
+    }
+
+    case EAbilityShape::Cone:
+    {
+        // Compared squared to skip the square root; the sign check keeps the back half out
+        if (DistanceSq > Cast.Radius * Cast.Radius)
+        {
+            return false;
+        }
+        const float Along = DeltaX * Cast.Direction.X + DeltaY * Cast.Direction.Y;
+        if (Cast.CosHalfAngle <= 0.0f)
+        {
+            return Along >= 0.0f || Along * Along <= Cast.CosHalfAngle * Cast.CosHalfAngle * DistanceSq;
+        }
+        return Along >= 0.0f && Along * Along >= Cast.CosHalfAngle * Cast.CosHalfAngle * DistanceSq;
+    }
+
+    default:
+        return false;
+    }
+}
@@ -0,0 +1,184 @@
+// AbilitySubsystem.cpp
+
+#include "AbilitySubsystem.h"
+#include "CombatStats.h"
+#include "StatusEffectSubsystem.h"
+#include "UnitBase.h"
+#include "UnitRegistrySubsystem.h"
+#include "Engine/World.h"
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+void UAbilitySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    UnitRegistry = Collection.InitializeDependency<UUnitRegistrySubsystem>();
+    StatusEffects = Collection.InitializeDependency<UStatusEffectSubsystem>();
+}
+
+void UAbilitySubsystem::Deinitialize()
+{
+    Batch.Reset();
+    PendingCasts.Reset();
+    PendingPayloads.Reset();
+    PendingAbilityCopies.Reset();
+    ResolvingCasts.Reset();
+    ResolvingPayloads.Reset();
+    ResolvingAbilityCopies.Reset();
+    Hits.Reset();
+    UnitRegistry = nullptr;
+    StatusEffects = nullptr;
+
+    Super::Deinitialize();
+}
+
+void UAbilitySubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+    TFT_COMBAT_FRAME_SCOPE(AbilityResolve);
+
+    ResolveCasts();
+}
+
+TStatId UAbilitySubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UAbilitySubsystem, STATGROUP_Tickables);
+}
+
+bool UAbilitySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+// ============================================================================
+// CASTS
+// ============================================================================
+
+bool UAbilitySubsystem::QueueCast(AUnitBase* Caster, const FAbilityDefinition& Ability, const FVector& AimLocation)
+{
+    if (!Caster || Caster->GetUnitHandle() == INDEX_NONE || Ability.Shape == EAbilityShape::None)
+    {
+        return false;
+    }
+
+    const FVector2D CasterLocation(Caster->GetActorLocation());
+    const FVector2D Aim(AimLocation);
+
+    FAbilityCast& Cast = PendingCasts.AddDefaulted_GetRef();
+    Cast.Shape = Ability.Shape;
+    Cast.Targets = Ability.Targets;
+    Cast.Radius = Ability.Radius;
+    Cast.HalfWidth = Ability.Width * 0.5f;
+    Cast.CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(Ability.ConeAngle * 0.5f));
+    Cast.BoardId = UUnitRegistrySubsystem::ClampBoardId(Caster->BoardId);
+    Cast.TeamIndex = (int32)Caster->Team;
+
+    if (Ability.Shape == EAbilityShape::Circle)
+    {
+        Cast.Origin = Ability.bCenterOnCaster ? CasterLocation : Aim;
+    }
+    else
+    {
+        // Aiming at yourself points the way the caster faces
+        Cast.Origin = CasterLocation;
+        Cast.Direction = (Aim - CasterLocation).GetSafeNormal();
+        if (Cast.Direction.IsZero())
+        {
+            Cast.Direction = FVector2D(Caster->GetActorForwardVector()).GetSafeNormal();
+        }
+    }
+
+    FQueuedPayload& Payload = PendingPayloads.AddDefaulted_GetRef();
+    Payload.Caster = Caster->GetUnitHandle();
+
+    // Blueprint callers can pass any definition; it has to outlive their call
+    if (&Ability != &Caster->Ability)
+    {
+        Payload.CopiedAbility = PendingAbilityCopies.Add(Ability);
+    }
+    return true;
+}
+
+void UAbilitySubsystem::ResolveCasts()
+{
+    if (!UnitRegistry || PendingCasts.Num() == 0)
+    {
+        HitsLastFrame = 0;
+        return;
+    }
+
+    // Swap first: a payload can fill a caster's mana and queue the next cast
+    Swap(PendingCasts, ResolvingCasts);
+    Swap(PendingPayloads, ResolvingPayloads);
+    Swap(PendingAbilityCopies, ResolvingAbilityCopies);
+    PendingCasts.Reset();
+    PendingPayloads.Reset();
+    PendingAbilityCopies.Reset();
+
+    // One snapshot and one pass for every cast of the frame
+    BuildSnapshot();
+    Hits.Reset();
+    Batch.Resolve(ResolvingCasts, Hits);
+    HitsLastFrame = Hits.Num();
+
+    for (const FAbilityHit& Hit : Hits)
+    {
+        // Earlier hits this frame may already have killed the target
+        AUnitBase* Target = UnitRegistry->GetUnit(Hit.Target);
+        if (Target && Target->bIsAlive)
+        {
+            ApplyHit(ResolvingPayloads[Hit.Cast], Target);
+        }
+    }
+
+    ResolvingCasts.Reset();
+    ResolvingPayloads.Reset();
+    ResolvingAbilityCopies.Reset();
+}
+
+void UAbilitySubsystem::BuildSnapshot()
+{
+    Batch.Reset();
+
+    for (int32 Handle = 0; Handle < UnitRegistry->GetNumHandles(); ++Handle)
+    {
+        const AUnitBase* Unit = UnitRegistry->GetUnit(Handle);
+        if (Unit && Unit->bIsAlive && Unit->GetState() == EUnitState::Combat)
+        {
+            Batch.AddUnit(Handle, UUnitRegistrySubsystem::ClampBoardId(Unit->BoardId), (int32)Unit->Team, Unit->GetActorLocation());
+        }
+    }
+}
+
+void UAbilitySubsystem::ApplyHit(const FQueuedPayload& Payload, AUnitBase* Target) const
+{
+    // A caster that died mid-cast still lands it; one that left play does not
+    AUnitBase* Caster = UnitRegistry->GetUnit(Payload.Caster);
+    if (!Caster)
+    {
+        return;
+    }
+
+    const FAbilityDefinition& Ability = Payload.CopiedAbility == INDEX_NONE ? Caster->Ability : ResolvingAbilityCopies[Payload.CopiedAbility];
+
+    if (Ability.Damage > 0.0f)
+    {
+        Caster->DealDamage(Target, Ability.Damage, Ability.DamageType);
+    }
+
+    if (Ability.Heal > 0.0f)
+    {
+        Target->Heal(Ability.Heal);
+    }
+
+    if (StatusEffects)
+    {
+        for (const FStatusEffectSpec& Effect : Ability.Effects)
+        {
+            StatusEffects->ApplyEffect(Target, Effect, Caster);
+        }
+    }
+}
@@ -0,0 +1,83 @@
+// AbilitySubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Abilities.h"
+#include "AbilitySubsystem.generated.h"
+
+// Forward declarations
+class AUnitBase;
+class UUnitRegistrySubsystem;
+class UStatusEffectSubsystem;
+
+// ============================================================================
+// ABILITY SUBSYSTEM
+// ============================================================================
+
+/**
+ * Area-of-effect abilities. Casts are queued during the frame and resolved together
+ * once per frame against a single snapshot of unit positions (see FAbilityBatch).
+ * Every hit then gets its cast's payload: damage goes through the caster's DealDamage
+ * like an auto attack, heals and status effects are applied directly.
+ */
+UCLASS()
+class TFTUNREALDEMO_API UAbilitySubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    /**
+     * Queues Ability for this frame's resolve. Circles are centered on AimLocation unless
+     * they center on the caster; lines and cones point from the caster towards it.
+     * Returns false for shapeless abilities and casters not in play.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Abilities")
+    bool QueueCast(AUnitBase* Caster, const FAbilityDefinition& Ability, const FVector& AimLocation);
+
+    /** Resolves every queued cast now. Called automatically once per frame. */
+    void ResolveCasts();
+
+    UFUNCTION(BlueprintPure, Category = "Abilities")
+    int32 GetNumHitsLastFrame() const { return HitsLastFrame; }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    /** Casts of the caster's own Ability read it at resolve time; only other definitions are copied. */
+    struct FQueuedPayload
+    {
+        int32 Caster = INDEX_NONE;
+
+        /** Index into the frame's copied definitions, or INDEX_NONE for the caster's Ability. */
+        int32 CopiedAbility = INDEX_NONE;
+    };
+
+    void BuildSnapshot();
+    void ApplyHit(const FQueuedPayload& Payload, AUnitBase* Target) const;
+
+    UPROPERTY()
+    UUnitRegistrySubsystem* UnitRegistry;
+
+    UPROPERTY()
+    UStatusEffectSubsystem* StatusEffects;
+
+    FAbilityBatch Batch;
+
+    /** Filled during the frame; swapped out before resolving so payloads can queue new casts. */
+    TArray<FAbilityCast> PendingCasts;
+    TArray<FQueuedPayload> PendingPayloads;
+    TArray<FAbilityDefinition> PendingAbilityCopies;
+    TArray<FAbilityCast> ResolvingCasts;
+    TArray<FQueuedPayload> ResolvingPayloads;
+    TArray<FAbilityDefinition> ResolvingAbilityCopies;
+
+    TArray<FAbilityHit> Hits;
+    int32 HitsLastFrame = 0;
+};
@@ -0,0 +1,167 @@
+// BoardGridSubsystem.cpp
+
+#include "BoardGridSubsystem.h"
+#include "UnitBase.h"
+#include "Engine/World.h"
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+void UBoardGridSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    for (int32& Occupant : Occupants)
+    {
+        Occupant = INDEX_NONE;
+    }
+}
+
+void UBoardGridSubsystem::Deinitialize()
+{
+    UnitCells.Reset();
+    bBoardPlaced = false;
+
+    Super::Deinitialize();
+}
+
+bool UBoardGridSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+// ============================================================================
+// BOARD PLACEMENT
+// ============================================================================
+
+void UBoardGridSubsystem::SetBoardTransform(const FVector& InOrigin, float InHexWidth)
+{
+    Origin = InOrigin;
+    HexWidth = InHexWidth > 0.0f ? InHexWidth : FHexBoard::DefaultHexWidth;
+    bBoardPlaced = true;
+}
+
+FVector UBoardGridSubsystem::GetCellLocation(int32 Cell) const
+{
+    if (!FHexBoard::IsValidCell(Cell))
+    {
+        return Origin;
+    }
+
+    const FVector2f Center = FHexBoard::GetCellCenter(Cell, HexWidth);
+    return Origin + FVector(Center.X, Center.Y, 0.0f);
+}
+
+int32 UBoardGridSubsystem::GetCellAtLocation(const FVector& Location) const
+{
+    // Without a placed board every unit is off it, so Blueprint AttackRange stays in charge
+    if (!bBoardPlaced)
+    {
+        return INDEX_NONE;
+    }
+
+    const FVector Local = Location - Origin;
+    return FHexBoard::FindCellAt(FVector2f(Local.X, Local.Y), HexWidth);
+}
+
+// ============================================================================
+// UNITS
+// ============================================================================
+
+bool UBoardGridSubsystem::PlaceUnit(AUnitBase* Unit, int32 Cell)
+{
+    const int32 Handle = Unit ? Unit->GetUnitHandle() : INDEX_NONE;
+    if (!bBoardPlaced || Handle == INDEX_NONE || Unit->BoardId != GridBoardId || !FHexBoard::IsValidCell(Cell))
+    {
+        return false;
+    }
+
+    if (Occupants[Cell] != INDEX_NONE && Occupants[Cell] != Handle)
+    {
+        return false;
+    }
+
+    // Release the unit's previous reservation
+    for (int32& Occupant : Occupants)
+    {
+        if (Occupant == Handle)
+        {
+            Occupant = INDEX_NONE;
+        }
+    }
+
+    Occupants[Cell] = Handle;
+
+    const FVector CellLocation = GetCellLocation(Cell);
+    Unit->SetActorLocation(FVector(CellLocation.X, CellLocation.Y, Unit->GetActorLocation().Z));
+    UpdateUnit(Handle, Unit->BoardId, Unit->GetActorLocation());
+    return true;
+}
+
+void UBoardGridSubsystem::UpdateUnit(int32 Handle, int32 BoardId, const FVector& Location)
+{
+    if (Handle == INDEX_NONE)
+    {
+        return;
+    }
+
+    while (UnitCells.Num() <= Handle)
+    {
+        UnitCells.Add(INDEX_NONE);
+    }
+
+    // Other boards can overlap this one in the world
+    UnitCells[Handle] = BoardId == GridBoardId ? GetCellAtLocation(Location) : INDEX_NONE;
+}
+
+void UBoardGridSubsystem::RemoveUnit(int32 Handle)
+{
+    if (UnitCells.IsValidIndex(Handle))
+    {
+        UnitCells[Handle] = INDEX_NONE;
+    }
+
+    for (int32& Occupant : Occupants)
+    {
+        if (Occupant == Handle)
+        {
+            Occupant = INDEX_NONE;
+        }
+    }
+}
+
+int32 UBoardGridSubsystem::GetUnitCell(const AUnitBase* Unit) const
+{
+    // BoardId is checked as well, in case the unit changed board since the last sync
+    return Unit && Unit->BoardId == GridBoardId ? GetHandleCell(Unit->GetUnitHandle()) : INDEX_NONE;
+}
+
+int32 UBoardGridSubsystem::GetCellOccupant(int32 Cell) const
+{
+    return FHexBoard::IsValidCell(Cell) ? Occupants[Cell] : INDEX_NONE;
+}
+
+// ============================================================================
+// RANGE
+// ============================================================================
+
+int32 UBoardGridSubsystem::GetHexDistance(const AUnitBase* UnitA, const AUnitBase* UnitB) const
+{
+    const int32 CellA = GetUnitCell(UnitA);
+    const int32 CellB = GetUnitCell(UnitB);
+    return CellA != INDEX_NONE && CellB != INDEX_NONE ? FHexBoard::GetDistance(CellA, CellB) : INDEX_NONE;
+}
+
+bool UBoardGridSubsystem::TryIsInRange(const AUnitBase* Unit, const AUnitBase* Target, int32 RangeInHexes, bool& OutInRange) const
+{
+    const int32 UnitCell = GetUnitCell(Unit);
+    const int32 TargetCell = GetUnitCell(Target);
+    if (UnitCell == INDEX_NONE || TargetCell == INDEX_NONE)
+    {
+        return false;
+    }
+
+    OutInRange = FHexBoard::IsInRange(UnitCell, TargetCell, RangeInHexes);
+    return true;
+}
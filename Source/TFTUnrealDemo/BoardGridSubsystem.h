@@ -0,0 +1,104 @@
+// BoardGridSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "HexBoard.h"
+#include "BoardGridSubsystem.generated.h"
+
+// Forward declarations
+class AUnitBase;
+
+// ============================================================================
+// BOARD GRID SUBSYSTEM
+// ============================================================================
+
+/**
+ * Places the FHexBoard in the world and tracks which cell every registered unit stands
+ * in. Units can reserve a cell (placement during prep); the current cell follows the
+ * unit's position as it walks. Range checks between two units on the board are hex
+ * distance table lookups.
+ *
+ * The grid stays inactive until SetBoardTransform is called: no unit has a cell and
+ * range checks fall back to each unit's AttackRange.
+ */
+UCLASS()
+class TFTUNREALDEMO_API UBoardGridSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** The one board (AUnitBase::BoardId) this grid models; units on every other board have no cell. */
+    static constexpr int32 GridBoardId = 0;
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // ========================================================================
+    // BOARD PLACEMENT
+    // ========================================================================
+
+    /** World location of cell 0's center and the distance between neighboring cell centers. Activates the grid. */
+    UFUNCTION(BlueprintCallable, Category = "Board")
+    void SetBoardTransform(const FVector& InOrigin, float InHexWidth);
+
+    UFUNCTION(BlueprintPure, Category = "Board")
+    bool IsBoardPlaced() const { return bBoardPlaced; }
+
+    UFUNCTION(BlueprintPure, Category = "Board")
+    float GetHexWidth() const { return HexWidth; }
+
+    UFUNCTION(BlueprintPure, Category = "Board")
+    FVector GetCellLocation(int32 Cell) const;
+
+    /** Cell under a world location, or INDEX_NONE off the board or before the board is placed. */
+    UFUNCTION(BlueprintPure, Category = "Board")
+    int32 GetCellAtLocation(const FVector& Location) const;
+
+    // ========================================================================
+    // UNITS
+    // ========================================================================
+
+    /** Reserves Cell for Unit and moves the unit onto it. Fails if another unit holds the cell or the board is not placed. */
+    UFUNCTION(BlueprintCallable, Category = "Board")
+    bool PlaceUnit(AUnitBase* Unit, int32 Cell);
+
+    /** Updates the unit's current cell from its world location. Units off GridBoardId get none. */
+    void UpdateUnit(int32 Handle, int32 BoardId, const FVector& Location);
+
+    /** Drops the unit's current cell and any reservation it holds. */
+    void RemoveUnit(int32 Handle);
+
+    UFUNCTION(BlueprintPure, Category = "Board")
+    int32 GetUnitCell(const AUnitBase* Unit) const;
+
+    /** Registry handle of the unit holding the reservation on Cell, or INDEX_NONE. */
+    int32 GetCellOccupant(int32 Cell) const;
+
+    // ========================================================================
+    // RANGE
+    // ========================================================================
+
+    /** Hex distance between two units, or INDEX_NONE if either is off the board. */
+    UFUNCTION(BlueprintPure, Category = "Board")
+    int32 GetHexDistance(const AUnitBase* UnitA, const AUnitBase* UnitB) const;
+
+    /** True when both units are on the board; OutInRange is then the hex range check. */
+    bool TryIsInRange(const AUnitBase* Unit, const AUnitBase* Target, int32 RangeInHexes, bool& OutInRange) const;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    int32 GetHandleCell(int32 Handle) const { return UnitCells.IsValidIndex(Handle) ? UnitCells[Handle] : INDEX_NONE; }
+
+    FVector Origin = FVector::ZeroVector;
+    float HexWidth = FHexBoard::DefaultHexWidth;
+    bool bBoardPlaced = false;
+
+    /** Current cell per unit registry handle. */
+    TArray<int32> UnitCells;
+
+    /** Registry handle holding each cell's reservation. */
+    int32 Occupants[FHexBoard::NumCells];
+};
@@ -0,0 +1,787 @@
+// CombatBenchmarkCommandlet.cpp
+
+#include "CombatBenchmarkCommandlet.h"
+#include "UnitBase.h"
+#include "UnitPoolSubsystem.h"
+#include "UnitAISchedulerSubsystem.h"
+#include "UnitRegistrySubsystem.h"
+#include "UnitSpatialHash.h"
+#include "UnitStatStore.h"
+#include "TFTUnrealDemo.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Components/StaticMeshComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "GameFramework/WorldSettings.h"
+#include "AI/NavigationSystemBase.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Math/RandomStream.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace CombatBenchmarkPrivate
+{
+    constexpr int32 NumTeams = 2;
+
+    // Growth below these is noise on small boards, whatever the tolerance
+    constexpr double FrameMsSlack = 0.05;
+    constexpr double AllocsSlack = 2.0;
+
+    struct FBenchmarkSettings
+    {
+        TArray<int32> UnitsPerTeam = { 8, 32, 128, 512 };
+        UClass* UnitClass = nullptr;
+        float DeltaTime = 1.0f / 30.0f;
+        float MaxFightSeconds = 120.0f;
+        float Spacing = 150.0f;
+    };
+
+    struct FScenarioResult
+    {
+        FString Name;
+        int32 UnitsPerTeam = 0;
+        int32 Frames = 0;
+        float FightSeconds = 0.0f;
+        bool bTimedOut = false;
+        int32 Survivors[NumTeams] = {};
+
+        double SpawnMs = 0.0;
+        double FrameMsAverage = 0.0;
+        double FrameMsP50 = 0.0;
+        double FrameMsP95 = 0.0;
+        double FrameMsP99 = 0.0;
+        double FrameMsMax = 0.0;
+        double AIMsPerFrame = 0.0;
+        double ThinksPerFrame = 0.0;
+        double AllocsPerFrame = 0.0;
+
+        TArray<FString> Regressions;
+    };
+
+    // ========================================================================
+    // ALLOCATION COUNTING
+    // ========================================================================
+
+    /** Forwards to the real allocator and counts allocations. Only installed while no other thread runs. */
+    class FMallocCounter final : public FMalloc
+    {
+    public:
+        FMalloc* Inner = nullptr;
+        uint64 NumAllocs = 0;
+
+        virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+        {
+            ++NumAllocs;
+            return Inner->Malloc(Count, Alignment);
+        }
+
+        virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+        {
+            ++NumAllocs;
+            return Inner->TryMalloc(Count, Alignment);
+        }
+
+        virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+        {
+            NumAllocs += Count > 0 ? 1 : 0;
+            return Inner->Realloc(Original, Count, Alignment);
+        }
+
+        virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+        {
+            NumAllocs += Count > 0 ? 1 : 0;
+            return Inner->TryRealloc(Original, Count, Alignment);
+        }
+
+        virtual void Free(void* Original) override { Inner->Free(Original); }
+        virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+        virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+        virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+        virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+        virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+        virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+        virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+        virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+        virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+    };
+
+    /**
+     * Puts the counter in front of GMalloc for the scope. GMalloc is a plain pointer read by
+     * every thread, so it is only swapped when the engine runs without worker, render or audio
+     * threads (-nothreading); otherwise nothing is counted. Memory allocated before the swap
+     * is freed through the counter, which forwards it.
+     */
+    class FScopedMallocCounter
+    {
+    public:
+        FScopedMallocCounter()
+            : bCounting(!FPlatformProcess::SupportsMultithreading())
+        {
+            if (bCounting)
+            {
+                Counter.Inner = GMalloc;
+                GMalloc = &Counter;
+            }
+        }
+
+        ~FScopedMallocCounter()
+        {
+            if (bCounting)
+            {
+                GMalloc = Counter.Inner;
+            }
+        }
+
+        bool IsCounting() const { return bCounting; }
+        uint64 GetNumAllocs() const { return Counter.NumAllocs; }
+
+    private:
+        FMallocCounter Counter;
+        bool bCounting;
+    };
+
+    // ========================================================================
+    // WORLD
+    // ========================================================================
+
+    /** Empty game world with a flat floor. No navmesh, so units walk straight at their targets. */
+    UWorld* CreateBenchmarkWorld(float FloorSize)
+    {
+        UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("TFTCombatBenchmark"));
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(World);
+
+        World->InitializeActorsForPlay(FURL());
+
+        // Straight moves go through the abstract nav data, which needs a navigation system
+        FNavigationSystem::AddNavigationSystemToWorld(*World, FNavigationSystemRunMode::GameMode);
+
+        // Engine cube scaled to a slab whose top face sits at Z = 0
+        if (AStaticMeshActor* Floor = World->SpawnActor<AStaticMeshActor>(FVector(0.0, 0.0, -50.0), FRotator::ZeroRotator))
+        {
+            Floor->SetMobility(EComponentMobility::Movable);
+            Floor->GetStaticMeshComponent()->SetStaticMesh(LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube")));
+            Floor->SetActorScale3D(FVector(FloorSize / 100.0f, FloorSize / 100.0f, 1.0f));
+        }
+
+        // No game mode: start play directly so spawned units run BeginPlay
+        World->GetWorldSettings()->NotifyBeginPlay();
+        return World;
+    }
+
+    void DestroyBenchmarkWorld(UWorld* World)
+    {
+        GEngine->DestroyWorldContext(World);
+        World->DestroyWorld(false);
+        CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+    }
+
+    void TickWorld(UWorld* World, float DeltaTime)
+    {
+        ++GFrameCounter;
+        World->Tick(LEVELTICK_All, DeltaTime);
+
+        // Async path results and other game thread tasks land here as they would in the engine loop
+        FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+    }
+
+    int32 CountAlive(TConstArrayView<AUnitBase*> Units)
+    {
+        int32 NumAlive = 0;
+        for (const AUnitBase* Unit : Units)
+        {
+            NumAlive += IsValid(Unit) && Unit->bIsAlive && !Unit->IsInPool() ? 1 : 0;
+        }
+        return NumAlive;
+    }
+
+    /** Nearest-rank percentile of sorted values. */
+    double GetPercentile(TConstArrayView<double> SortedValues, double Percentile)
+    {
+        if (SortedValues.Num() == 0)
+        {
+            return 0.0;
+        }
+
+        const int32 Index = FMath::Clamp(FMath::CeilToInt(Percentile * SortedValues.Num()) - 1, 0, SortedValues.Num() - 1);
+        return SortedValues[Index];
+    }
+
+    // ========================================================================
+    // SCENARIOS
+    // ========================================================================
+
+    /** Both teams stand in square-ish blocks facing each other across X = 0. */
+    int32 GetNumColumns(int32 UnitsPerTeam)
+    {
+        return FMath::Max(1, FMath::CeilToInt(FMath::Sqrt((float)UnitsPerTeam)));
+    }
+
+    bool RunScenario(const FBenchmarkSettings& Settings, int32 UnitsPerTeam, float FloorSize, FScenarioResult& OutResult)
+    {
+        OutResult = FScenarioResult();
+        OutResult.Name = FString::Printf(TEXT("2x%d"), UnitsPerTeam);
+        OutResult.UnitsPerTeam = UnitsPerTeam;
+
+        UWorld* World = CreateBenchmarkWorld(FloorSize);
+        UUnitPoolSubsystem* Pool = World->GetSubsystem<UUnitPoolSubsystem>();
+        UUnitAISchedulerSubsystem* AIScheduler = World->GetSubsystem<UUnitAISchedulerSubsystem>();
+
+        if (!Pool || !AIScheduler)
+        {
+            UE_LOG(LogTFTCombat, Error, TEXT("Combat subsystems are missing from the benchmark world"));
+            DestroyBenchmarkWorld(World);
+            return false;
+        }
+
+        const AUnitBase* UnitDefaults = Settings.UnitClass->GetDefaultObject<AUnitBase>();
+        const float SpawnHeight = UnitDefaults->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() + 2.0f;
+        const int32 NumColumns = GetNumColumns(UnitsPerTeam);
+
+        TArray<AUnitBase*> Units[NumTeams];
+        const double SpawnStart = FPlatformTime::Seconds();
+
+        for (int32 TeamIndex = 0; TeamIndex < NumTeams; ++TeamIndex)
+        {
+            const double Side = TeamIndex == 0 ? -1.0 : 1.0;
+            const FRotator Facing(0.0, TeamIndex == 0 ? 0.0 : 180.0, 0.0);
+            const ETeam Team = TeamIndex == 0 ? ETeam::Player : ETeam::Enemy;
+
+            for (int32 Index = 0; Index < UnitsPerTeam; ++Index)
+            {
+                const int32 Row = Index / NumColumns;
+                const int32 Column = Index % NumColumns;
+                const FVector Location(
+                    Side * Settings.Spacing * (Row + 2),
+                    (Column - (NumColumns - 1) * 0.5) * Settings.Spacing,
+                    SpawnHeight);
+
+                if (AUnitBase* Unit = Pool->AcquireUnit(Settings.UnitClass, FTransform(Facing, Location), Team))
+                {
+                    Units[TeamIndex].Add(Unit);
+                }
+            }
+        }
+
+        OutResult.SpawnMs = (FPlatformTime::Seconds() - SpawnStart) * 1000.0;
+
+        if (Units[0].Num() != UnitsPerTeam || Units[1].Num() != UnitsPerTeam)
+        {
+            UE_LOG(LogTFTCombat, Error, TEXT("%s: spawned %d + %d units"), *OutResult.Name, Units[0].Num(), Units[1].Num());
+            DestroyBenchmarkWorld(World);
+            return false;
+        }
+
+        // ====================================================================
+        // FIGHT
+        // ====================================================================
+
+        const int32 MaxFrames = FMath::CeilToInt(Settings.MaxFightSeconds / Settings.DeltaTime);
+        TArray<double> FrameMs;
+        FrameMs.Reserve(MaxFrames);
+
+        double AIMs = 0.0;
+        int64 NumThinks = 0;
+        uint64 NumAllocs = 0;
+        bool bCountedAllocs = false;
+
+        {
+            FScopedMallocCounter MallocCounter;
+            const uint64 AllocsAtStart = MallocCounter.GetNumAllocs();
+
+            while (FrameMs.Num() < MaxFrames)
+            {
+                const uint64 StartCycles = FPlatformTime::Cycles64();
+                TickWorld(World, Settings.DeltaTime);
+                FrameMs.Add(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles));
+
+                const FAISchedulerFrameStats AIStats = AIScheduler->GetLastFrameStats();
+                AIMs += AIStats.ThinkMilliseconds;
+                NumThinks += AIStats.ThinksRun;
+
+                if (CountAlive(Units[0]) == 0 || CountAlive(Units[1]) == 0)
+                {
+                    break;
+                }
+            }
+
+            NumAllocs = MallocCounter.GetNumAllocs() - AllocsAtStart;
+            bCountedAllocs = MallocCounter.IsCounting();
+        }
+
+        for (int32 TeamIndex = 0; TeamIndex < NumTeams; ++TeamIndex)
+        {
+            OutResult.Survivors[TeamIndex] = CountAlive(Units[TeamIndex]);
+        }
+
+        OutResult.Frames = FrameMs.Num();
+        OutResult.FightSeconds = OutResult.Frames * Settings.DeltaTime;
+        OutResult.bTimedOut = OutResult.Survivors[0] > 0 && OutResult.Survivors[1] > 0;
+
+        const double NumFrames = FMath::Max(1, OutResult.Frames);
+        double TotalMs = 0.0;
+        for (const double Ms : FrameMs)
+        {
+            TotalMs += Ms;
+        }
+
+        FrameMs.Sort();
+        OutResult.FrameMsAverage = TotalMs / NumFrames;
+        OutResult.FrameMsP50 = GetPercentile(FrameMs, 0.50);
+        OutResult.FrameMsP95 = GetPercentile(FrameMs, 0.95);
+        OutResult.FrameMsP99 = GetPercentile(FrameMs, 0.99);
+        OutResult.FrameMsMax = FrameMs.Num() > 0 ? FrameMs.Last() : 0.0;
+        OutResult.AIMsPerFrame = AIMs / NumFrames;
+        OutResult.ThinksPerFrame = NumThinks / NumFrames;
+        OutResult.AllocsPerFrame = bCountedAllocs ? NumAllocs / NumFrames : -1.0;
+
+        DestroyBenchmarkWorld(World);
+        return true;
+    }
+
+    // ========================================================================
+    // MICRO BENCHMARKS
+    // ========================================================================
+
+    struct FMicroResult
+    {
+        FString Name;
+        int32 NumUnits = 0;
+        FString BaselineName;
+        FString OptimizedName;
+        double BaselineNsPerOp = 0.0;
+        double OptimizedNsPerOp = 0.0;
+        int32 Mismatches = 0;
+    };
+
+    /** Registry spatial hash against a scan over every unit, on a board-density random layout. */
+    FMicroResult RunNearestEnemyBenchmark(int32 NumUnits)
+    {
+        constexpr int32 NumQueries = 50000;
+
+        FMicroResult Result;
+        Result.Name = TEXT("NearestEnemy");
+        Result.NumUnits = NumUnits;
+        Result.BaselineName = TEXT("LinearScan");
+        Result.OptimizedName = TEXT("SpatialHash");
+
+        FRandomStream Random(NumUnits);
+        const float Extent = FMath::Sqrt((float)NumUnits) * UUnitRegistrySubsystem::DefaultCellSize;
+
+        FUnitSpatialHash SpatialHash(UUnitRegistrySubsystem::DefaultCellSize);
+        TArray<FVector> Locations;
+        TArray<int32> Teams;
+
+        for (int32 Handle = 0; Handle < NumUnits; ++Handle)
+        {
+            Locations.Add(FVector(Random.FRandRange(0.0f, Extent), Random.FRandRange(0.0f, Extent), 0.0f));
+            Teams.Add(Handle % NumTeams);
+            SpatialHash.Add(Handle, Teams[Handle], SpatialHash.GetCell(Locations[Handle]));
+        }
+
+        TArray<int32> Expected;
+        Expected.SetNumUninitialized(NumQueries);
+
+        // Ascending handles with a strict compare keep the lower handle on ties, like the hash
+        uint64 StartCycles = FPlatformTime::Cycles64();
+        for (int32 Query = 0; Query < NumQueries; ++Query)
+        {
+            const int32 Origin = Query % NumUnits;
+            int32 BestHandle = INDEX_NONE;
+            double BestDistanceSq = TNumericLimits<double>::Max();
+
+            for (int32 Handle = 0; Handle < NumUnits; ++Handle)
+            {
+                if (Teams[Handle] == Teams[Origin])
+                {
+                    continue;
+                }
+
+                const double DistanceSq = FVector::DistSquared(Locations[Origin], Locations[Handle]);
+                if (DistanceSq < BestDistanceSq)
+                {
+                    BestDistanceSq = DistanceSq;
+                    BestHandle = Handle;
+                }
+            }
+            Expected[Query] = BestHandle;
+        }
+        Result.BaselineNsPerOp = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1.0e6 / NumQueries;
+
+        TArray<int32> Found;
+        Found.SetNumUninitialized(NumQueries);
+
+        StartCycles = FPlatformTime::Cycles64();
+        for (int32 Query = 0; Query < NumQueries; ++Query)
+        {
+            const FVector& Origin = Locations[Query % NumUnits];
+            Found[Query] = SpatialHash.FindNearest(Origin, Teams[Query % NumUnits], [&](int32 Handle, double& OutDistanceSq)
+                {
+                    OutDistanceSq = FVector::DistSquared(Origin, Locations[Handle]);
+                    return true;
+                });
+        }
+        Result.OptimizedNsPerOp = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1.0e6 / NumQueries;
+
+        for (int32 Query = 0; Query < NumQueries; ++Query)
+        {
+            Result.Mismatches += Found[Query] != Expected[Query] ? 1 : 0;
+        }
+
+        return Result;
+    }
+
+    /** Stat store cooldown kernel against the same update over one struct per unit. */
+    FMicroResult RunStatStoreBenchmark(int32 NumUnits)
+    {
+        constexpr int32 NumIterations = 20000;
+        constexpr float DeltaTime = 1.0f / 60.0f;
+
+        struct FUnitStats
+        {
+            float CurrentHealth;
+            float CurrentMana;
+            float AttackCooldown;
+            float Armor;
+            float MagicResist;
+            float AttackSpeed;
+            float AttackDamage;
+            float AttackRange;
+            float CooldownMask;
+        };
+
+        FMicroResult Result;
+        Result.Name = TEXT("DecrementCooldowns");
+        Result.NumUnits = NumUnits;
+        Result.BaselineName = TEXT("ArrayOfStructs");
+        Result.OptimizedName = TEXT("UnitStatStore");
+
+        FUnitStatStore StatStore;
+        TArray<FUnitStats> UnitStats;
+        UnitStats.SetNumZeroed(NumUnits);
+
+        for (int32 Index = 0; Index < NumUnits; ++Index)
+        {
+            const int32 Handle = StatStore.Allocate();
+
+            // Long cooldowns so every active unit is decremented on every iteration; some units sit out
+            const float Cooldown = 1.0e4f + Index;
+            const float Mask = Index % 8 != 0 ? 1.0f : 0.0f;
+
+            StatStore.AttackCooldown[Handle] = UnitStats[Index].AttackCooldown = Cooldown;
+            StatStore.CooldownMask[Handle] = UnitStats[Index].CooldownMask = Mask;
+        }
+
+        uint64 StartCycles = FPlatformTime::Cycles64();
+        for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+        {
+            for (FUnitStats& Stats : UnitStats)
+            {
+                if (Stats.CooldownMask > 0.0f && Stats.AttackCooldown > 0.0f)
+                {
+                    Stats.AttackCooldown -= DeltaTime;
+                }
+            }
+        }
+        Result.BaselineNsPerOp = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1.0e6 / ((double)NumIterations * NumUnits);
+
+        StartCycles = FPlatformTime::Cycles64();
+        for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+        {
+            StatStore.DecrementCooldowns(DeltaTime);
+        }
+        Result.OptimizedNsPerOp = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1.0e6 / ((double)NumIterations * NumUnits);
+
+        for (int32 Index = 0; Index < NumUnits; ++Index)
+        {
+            Result.Mismatches += StatStore.AttackCooldown[Index] != UnitStats[Index].AttackCooldown ? 1 : 0;
+        }
+
+        return Result;
+    }
+
+    // ========================================================================
+    // JSON
+    // ========================================================================
+
+    TSharedRef<FJsonObject> ScenarioToJson(const FScenarioResult& Result)
+    {
+        TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+        Object->SetStringField(TEXT("Name"), Result.Name);
+        Object->SetNumberField(TEXT("UnitsPerTeam"), Result.UnitsPerTeam);
+        Object->SetNumberField(TEXT("Frames"), Result.Frames);
+        Object->SetNumberField(TEXT("FightSeconds"), Result.FightSeconds);
+        Object->SetBoolField(TEXT("TimedOut"), Result.bTimedOut);
+        Object->SetNumberField(TEXT("PlayerSurvivors"), Result.Survivors[0]);
+        Object->SetNumberField(TEXT("EnemySurvivors"), Result.Survivors[1]);
+        Object->SetNumberField(TEXT("SpawnMs"), Result.SpawnMs);
+        Object->SetNumberField(TEXT("FrameMsAverage"), Result.FrameMsAverage);
+        Object->SetNumberField(TEXT("FrameMsP50"), Result.FrameMsP50);
+        Object->SetNumberField(TEXT("FrameMsP95"), Result.FrameMsP95);
+        Object->SetNumberField(TEXT("FrameMsP99"), Result.FrameMsP99);
+        Object->SetNumberField(TEXT("FrameMsMax"), Result.FrameMsMax);
+        Object->SetNumberField(TEXT("AIMsPerFrame"), Result.AIMsPerFrame);
+        Object->SetNumberField(TEXT("ThinksPerFrame"), Result.ThinksPerFrame);
+        Object->SetNumberField(TEXT("AllocsPerFrame"), Result.AllocsPerFrame);
+
+        TArray<TSharedPtr<FJsonValue>> Regressions;
+        for (const FString& Regression : Result.Regressions)
+        {
+            Regressions.Add(MakeShared<FJsonValueString>(Regression));
+        }
+        Object->SetArrayField(TEXT("Regressions"), Regressions);
+
+        return Object;
+    }
+
+    TSharedRef<FJsonObject> MicroToJson(const FMicroResult& Result)
+    {
+        TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+        Object->SetStringField(TEXT("Name"), Result.Name);
+        Object->SetNumberField(TEXT("Units"), Result.NumUnits);
+        Object->SetStringField(TEXT("Baseline"), Result.BaselineName);
+        Object->SetNumberField(TEXT("BaselineNsPerOp"), Result.BaselineNsPerOp);
+        Object->SetStringField(TEXT("Optimized"), Result.OptimizedName);
+        Object->SetNumberField(TEXT("OptimizedNsPerOp"), Result.OptimizedNsPerOp);
+        Object->SetNumberField(TEXT("Speedup"), Result.OptimizedNsPerOp > 0.0 ? Result.BaselineNsPerOp / Result.OptimizedNsPerOp : 0.0);
+        Object->SetNumberField(TEXT("Mismatches"), Result.Mismatches);
+        return Object;
+    }
+
+    /** Scenario objects of a previous run, by name. */
+    bool LoadBaseline(const FString& Path, TMap<FString, TSharedPtr<FJsonObject>>& OutScenarios)
+    {
+        FString JsonText;
+        TSharedPtr<FJsonObject> Root;
+        const TArray<TSharedPtr<FJsonValue>>* Scenarios = nullptr;
+
+        if (!FFileHelper::LoadFileToString(JsonText, *Path)
+            || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(JsonText), Root) || !Root.IsValid()
+            || !Root->TryGetArrayField(TEXT("Scenarios"), Scenarios))
+        {
+            return false;
+        }
+
+        for (const TSharedPtr<FJsonValue>& Value : *Scenarios)
+        {
+            const TSharedPtr<FJsonObject>* Scenario = nullptr;
+            FString Name;
+            if (Value->TryGetObject(Scenario) && (*Scenario)->TryGetStringField(TEXT("Name"), Name))
+            {
+                OutScenarios.Add(Name, *Scenario);
+            }
+        }
+
+        return true;
+    }
+
+    void CheckRegression(FScenarioResult& Result, const FJsonObject& Baseline, const TCHAR* Field, double Current, double Slack, double Tolerance)
+    {
+        // Negative values were not measured, e.g. allocations in a threaded run
+        double Previous = 0.0;
+        if (!Baseline.TryGetNumberField(Field, Previous) || Previous < 0.0 || Current < 0.0)
+        {
+            return;
+        }
+
+        const double Limit = Previous * (1.0 + Tolerance) + Slack;
+        if (Current > Limit)
+        {
+            Result.Regressions.Add(FString::Printf(TEXT("%s %.3f over limit %.3f (baseline %.3f)"), Field, Current, Limit, Previous));
+        }
+    }
+}
+
+UCombatBenchmarkCommandlet::UCombatBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsEditor = false;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UCombatBenchmarkCommandlet::Main(const FString& Params)
+{
+    using namespace CombatBenchmarkPrivate;
+
+    FBenchmarkSettings Settings;
+    Settings.UnitClass = AUnitBase::StaticClass();
+
+    FString SizesText;
+    if (FParse::Value(*Params, TEXT("Sizes="), SizesText, false))
+    {
+        TArray<FString> SizeStrings;
+        SizesText.ParseIntoArray(SizeStrings, TEXT(","));
+
+        Settings.UnitsPerTeam.Reset();
+        for (const FString& Size : SizeStrings)
+        {
+            Settings.UnitsPerTeam.Add(FMath::Max(1, FCString::Atoi(*Size)));
+        }
+    }
+
+    FString UnitClassPath;
+    if (FParse::Value(*Params, TEXT("UnitClass="), UnitClassPath))
+    {
+        Settings.UnitClass = LoadClass<AUnitBase>(nullptr, *UnitClassPath);
+        if (!Settings.UnitClass)
+        {
+            UE_LOG(LogTFTCombat, Error, TEXT("%s is not an AUnitBase class"), *UnitClassPath);
+            return 1;
+        }
+    }
+
+    FParse::Value(*Params, TEXT("DeltaTime="), Settings.DeltaTime);
+    FParse::Value(*Params, TEXT("MaxSeconds="), Settings.MaxFightSeconds);
+    FParse::Value(*Params, TEXT("Spacing="), Settings.Spacing);
+    Settings.DeltaTime = FMath::Max(Settings.DeltaTime, 0.001f);
+
+    float Tolerance = 0.15f;
+    FParse::Value(*Params, TEXT("Tolerance="), Tolerance);
+
+    FString BaselinePath;
+    TMap<FString, TSharedPtr<FJsonObject>> Baseline;
+    if (FParse::Value(*Params, TEXT("Baseline="), BaselinePath) && !LoadBaseline(BaselinePath, Baseline))
+    {
+        UE_LOG(LogTFTCombat, Error, TEXT("Could not read baseline %s"), *BaselinePath);
+        return 1;
+    }
+
+    FString JsonPath = FPaths::ProjectSavedDir() / TEXT("Benchmarks/CombatBenchmark.json");
+    FParse::Value(*Params, TEXT("Json="), JsonPath);
+
+    // One floor size for every scenario, big enough for the largest board
+    int32 MaxUnitsPerTeam = 1;
+    for (const int32 UnitsPerTeam : Settings.UnitsPerTeam)
+    {
+        MaxUnitsPerTeam = FMath::Max(MaxUnitsPerTeam, UnitsPerTeam);
+    }
+    const int32 MaxColumns = GetNumColumns(MaxUnitsPerTeam);
+    const int32 MaxRows = FMath::DivideAndRoundUp(MaxUnitsPerTeam, MaxColumns);
+    const float FloorSize = 2.0f * Settings.Spacing * (FMath::Max(MaxRows + 2, MaxColumns) + 4);
+
+    // ========================================================================
+    // SCENARIOS
+    // ========================================================================
+
+    TArray<FScenarioResult> Results;
+    bool bFailed = false;
+
+    for (const int32 UnitsPerTeam : Settings.UnitsPerTeam)
+    {
+        // Per-unit combat logging would otherwise end up in the frame times
+        const ELogVerbosity::Type LogVerbosity = LogTFTCombat.GetVerbosity();
+        LogTFTCombat.SetVerbosity(ELogVerbosity::Warning);
+
+        FScenarioResult& Result = Results.AddDefaulted_GetRef();
+        const bool bRan = RunScenario(Settings, UnitsPerTeam, FloorSize, Result);
+
+        LogTFTCombat.SetVerbosity(LogVerbosity);
+
+        if (!bRan)
+        {
+            bFailed = true;
+            Results.Pop();
+            continue;
+        }
+
+        if (const TSharedPtr<FJsonObject>* Previous = Baseline.Find(Result.Name))
+        {
+            CheckRegression(Result, **Previous, TEXT("FrameMsP95"), Result.FrameMsP95, FrameMsSlack, Tolerance);
+            CheckRegression(Result, **Previous, TEXT("AIMsPerFrame"), Result.AIMsPerFrame, FrameMsSlack, Tolerance);
+            CheckRegression(Result, **Previous, TEXT("AllocsPerFrame"), Result.AllocsPerFrame, AllocsSlack, Tolerance);
+        }
+
+        UE_LOG(LogTFTCombat, Display, TEXT("%-6s %5d frames, fight %6.2f s%s, survivors %d/%d, spawn %.1f ms"),
+            *Result.Name, Result.Frames, Result.FightSeconds, Result.bTimedOut ? TEXT(" (timed out)") : TEXT(""),
+            Result.Survivors[0], Result.Survivors[1], Result.SpawnMs);
+
+        const FString AllocsText = Result.AllocsPerFrame >= 0.0
+            ? FString::Printf(TEXT("%.1f allocs/frame"), Result.AllocsPerFrame)
+            : FString(TEXT("allocs not counted without -nothreading"));
+
+        UE_LOG(LogTFTCombat, Display, TEXT("       frame ms avg %.3f p50 %.3f p95 %.3f p99 %.3f max %.3f | AI %.3f ms/frame, %.1f thinks/frame | %s"),
+            Result.FrameMsAverage, Result.FrameMsP50, Result.FrameMsP95, Result.FrameMsP99, Result.FrameMsMax,
+            Result.AIMsPerFrame, Result.ThinksPerFrame, *AllocsText);
+
+        for (const FString& Regression : Result.Regressions)
+        {
+            UE_LOG(LogTFTCombat, Error, TEXT("%s regression: %s"), *Result.Name, *Regression);
+        }
+    }
+
+    // ========================================================================
+    // MICRO BENCHMARKS
+    // ========================================================================
+
+    TArray<FMicroResult> MicroResults;
+    if (!FParse::Param(*Params, TEXT("NoMicro")))
+    {
+        for (const int32 NumUnits : { 16, 128, 1024 })
+        {
+            MicroResults.Add(RunNearestEnemyBenchmark(NumUnits));
+        }
+        MicroResults.Add(RunStatStoreBenchmark(1000));
+    }
+
+    for (const FMicroResult& Micro : MicroResults)
+    {
+        UE_LOG(LogTFTCombat, Display, TEXT("%s x%d: %s %.1f ns, %s %.1f ns (%.2fx)"),
+            *Micro.Name, Micro.NumUnits, *Micro.BaselineName, Micro.BaselineNsPerOp, *Micro.OptimizedName, Micro.OptimizedNsPerOp,
+            Micro.OptimizedNsPerOp > 0.0 ? Micro.BaselineNsPerOp / Micro.OptimizedNsPerOp : 0.0);
+
+        if (Micro.Mismatches > 0)
+        {
+            UE_LOG(LogTFTCombat, Error, TEXT("%s x%d: %d results differ between %s and %s"),
+                *Micro.Name, Micro.NumUnits, Micro.Mismatches, *Micro.BaselineName, *Micro.OptimizedName);
+            bFailed = true;
+        }
+    }
+
+    // ========================================================================
+    // REPORT
+    // ========================================================================
+
+    TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+    Root->SetStringField(TEXT("UnitClass"), Settings.UnitClass->GetPathName());
+    Root->SetNumberField(TEXT("DeltaTime"), Settings.DeltaTime);
+    Root->SetNumberField(TEXT("Tolerance"), Tolerance);
+
+    TArray<TSharedPtr<FJsonValue>> ScenarioValues;
+    int32 NumRegressions = 0;
+    for (const FScenarioResult& Result : Results)
+    {
+        ScenarioValues.Add(MakeShared<FJsonValueObject>(ScenarioToJson(Result)));
+        NumRegressions += Result.Regressions.Num();
+    }
+    Root->SetArrayField(TEXT("Scenarios"), ScenarioValues);
+
+    TArray<TSharedPtr<FJsonValue>> MicroValues;
+    for (const FMicroResult& Micro : MicroResults)
+    {
+        MicroValues.Add(MakeShared<FJsonValueObject>(MicroToJson(Micro)));
+    }
+    Root->SetArrayField(TEXT("Micro"), MicroValues);
+
+    FString JsonText;
+    FJsonSerializer::Serialize(Root, TJsonWriterFactory<>::Create(&JsonText));
+
+    if (!FFileHelper::SaveStringToFile(JsonText, *JsonPath))
+    {
+        UE_LOG(LogTFTCombat, Error, TEXT("Could not write %s"), *JsonPath);
+        return 1;
+    }
+
+    UE_LOG(LogTFTCombat, Display, TEXT("Results written to %s, %d regressions"), *JsonPath, NumRegressions);
+    return bFailed || NumRegressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,40 @@
+// CombatBenchmarkCommandlet.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "CombatBenchmarkCommandlet.generated.h"
+
+// ============================================================================
+// COMBAT BENCHMARK COMMANDLET
+// ============================================================================
+
+/**
+ * Fights boards of 2x8, 2x32, 2x128 and 2x512 AUnitBase actors to completion in an empty
+ * game world and reports frame time percentiles, AI scheduler ms per frame, allocations
+ * per frame and fight length as JSON. Needs no GPU, so it runs on CI with -nullrhi.
+ *
+ * UnrealEditor-Cmd TFTUnrealDemo -run=CombatBenchmark -nullrhi [-Json=<file.json>]
+ *     [-Baseline=<file.json>] [-Tolerance=0.15] [-Sizes=8,32,128,512] [-UnitClass=<class path>]
+ *     [-DeltaTime=0.0333] [-MaxSeconds=120] [-Spacing=150] [-NoMicro]
+ *
+ * The world is a flat floor with no navmesh; units walk straight at their targets. Unless
+ * -NoMicro is passed, nearest-enemy queries (spatial hash vs linear scan) and the stat store
+ * cooldown kernel (SoA vs AoS) are timed as well. With -Baseline, a previous run's JSON,
+ * any scenario whose p95 frame time, AI time or allocations grew by more than the tolerance
+ * is reported as a regression and the commandlet returns non-zero.
+ *
+ * Allocations are counted by putting a counter in front of GMalloc, which is only safe with
+ * no other threads running, so they are measured only when the engine is started with
+ * -nothreading. Otherwise AllocsPerFrame is -1 and left out of the regression check.
+ */
+UCLASS()
+class UCombatBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UCombatBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
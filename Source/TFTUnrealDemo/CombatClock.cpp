@@ -0,0 +1,107 @@
+// CombatClock.cpp
+
+#include "CombatClock.h"
+#include "CombatSnapshot.h"
+
+uint32& FCombatClock::GetGeneration(int32 Unit, ECombatClockEvent Type)
+{
+    const int32 Slot = Unit * NumEventTypes + (int32)Type;
+    if (Slot >= Generations.Num())
+    {
+        const int32 NumSlots = (Unit + 1) * NumEventTypes;
+        Generations.SetNumZeroed(NumSlots);
+        Pending.SetNum(NumSlots, false);
+    }
+
+    return Generations[Slot];
+}
+
+uint32 FCombatClock::GetGeneration(int32 Unit, ECombatClockEvent Type) const
+{
+    const int32 Slot = Unit * NumEventTypes + (int32)Type;
+    return Generations.IsValidIndex(Slot) ? Generations[Slot] : 0;
+}
+
+void FCombatClock::Schedule(int32 Unit, ECombatClockEvent Type, double Delay)
+{
+    check(Unit >= 0);
+
+    FEvent Event;
+    Event.Time = Now + FMath::Max(Delay, 0.0);
+    Event.Sequence = NextSequence++;
+    Event.Generation = ++GetGeneration(Unit, Type);
+    Event.Unit = Unit;
+    Event.Type = Type;
+
+    Pending[Unit * NumEventTypes + (int32)Type] = true;
+    Heap.HeapPush(Event, FEventOrder());
+}
+
+void FCombatClock::Cancel(int32 Unit, ECombatClockEvent Type)
+{
+    // The heap entry stays until it reaches the top and is dropped there
+    if (IsPending(Unit, Type))
+    {
+        Pending[Unit * NumEventTypes + (int32)Type] = false;
+    }
+}
+
+void FCombatClock::CancelAll(int32 Unit)
+{
+    for (int32 TypeIndex = 0; TypeIndex < NumEventTypes; ++TypeIndex)
+    {
+        Cancel(Unit, (ECombatClockEvent)TypeIndex);
+    }
+}
+
+bool FCombatClock::IsPending(int32 Unit, ECombatClockEvent Type) const
+{
+    const int32 Slot = Unit * NumEventTypes + (int32)Type;
+    return Unit >= 0 && Pending.IsValidIndex(Slot) && Pending[Slot];
+}
+
+void FCombatClock::Serialize(FArchive& Ar)
+{
+    Ar << Now;
+    Ar << NextSequence;
+
+    // Field by field: FEvent has padding that would make identical clocks serialize differently
+    int32 NumEvents = Heap.Num();
+    Ar << NumEvents;
+
+    if (Ar.IsLoading())
+    {
+        if (NumEvents < 0 || NumEvents > Ar.TotalSize() - Ar.Tell())
+        {
+            Ar.SetError();
+            return;
+        }
+        Heap.SetNum(NumEvents);
+    }
+
+    for (FEvent& Event : Heap)
+    {
+        Ar << Event.Time;
+        Ar << Event.Sequence;
+        Ar << Event.Generation;
+        Ar << Event.Unit;
+        Ar << Event.Type;
+    }
+
+    CombatSnapshot::SerializeRawArray(Ar, Generations);
+    Ar << Pending;
+
+    if (Ar.IsLoading() && Pending.Num() != Generations.Num())
+    {
+        Ar.SetError();
+    }
+}
+
+void FCombatClock::Reset()
+{
+    Heap.Reset();
+    Generations.Reset();
+    Pending.Reset();
+    Now = 0.0;
+    NextSequence = 0;
+}
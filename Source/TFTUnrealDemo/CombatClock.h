@@ -0,0 +1,133 @@
+// CombatClock.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+// ============================================================================
+// CLOCK EVENTS
+// ============================================================================
+
+enum class ECombatClockEvent : uint8
+{
+    CastEnd,
+    HideAfterDeath,
+    ReleaseAfterDeath,
+
+    Count
+};
+
+// ============================================================================
+// COMBAT CLOCK
+// ============================================================================
+
+/**
+ * Min-heap of timed per-unit events. Each unit has at most one live event per type:
+ * scheduling again bumps a per-unit generation counter so the old entry goes stale,
+ * and cancelling clears a pending bit. Both are O(1); stale entries are dropped when
+ * they reach the top of the heap.
+ * Events due at the same time fire in scheduling order, so a run is deterministic.
+ */
+class TFTUNREALDEMO_API FCombatClock
+{
+public:
+    /** Schedules Type for Unit Delay seconds from now, replacing any pending event of that type. */
+    void Schedule(int32 Unit, ECombatClockEvent Type, double Delay);
+
+    void Cancel(int32 Unit, ECombatClockEvent Type);
+    void CancelAll(int32 Unit);
+    bool IsPending(int32 Unit, ECombatClockEvent Type) const;
+
+    /**
+     * Moves time forward and calls HandlerFunc(Unit, Type) for every event that came due,
+     * in time order. The handler may schedule or cancel events.
+     */
+    template <typename HandlerFuncType>
+    void Advance(double DeltaTime, HandlerFuncType&& HandlerFunc);
+
+    double GetTime() const { return Now; }
+
+    /** Heap entries, including cancelled ones not yet dropped. */
+    int32 NumQueued() const { return Heap.Num(); }
+
+    /** Calls VisitorFunc(Unit, Type, RemainingTime) for every live event, in no particular order. */
+    template <typename VisitorFuncType>
+    void ForEachPending(VisitorFuncType&& VisitorFunc) const;
+
+    /** Saves or restores the whole clock, stale entries included, so a restored run fires in the same order. */
+    void Serialize(FArchive& Ar);
+
+    void Reset();
+
+private:
+    struct FEvent
+    {
+        double Time = 0.0;
+        uint32 Sequence = 0;
+        uint32 Generation = 0;
+        int32 Unit = INDEX_NONE;
+        ECombatClockEvent Type = ECombatClockEvent::CastEnd;
+    };
+
+    struct FEventOrder
+    {
+        bool operator()(const FEvent& A, const FEvent& B) const
+        {
+            return A.Time < B.Time || (A.Time == B.Time && A.Sequence < B.Sequence);
+        }
+    };
+
+    static constexpr int32 NumEventTypes = (int32)ECombatClockEvent::Count;
+
+    uint32& GetGeneration(int32 Unit, ECombatClockEvent Type);
+    uint32 GetGeneration(int32 Unit, ECombatClockEvent Type) const;
+
+    TArray<FEvent> Heap;
+
+    /** Current generation per unit and event type; an event is live while its generation matches. */
+    TArray<uint32> Generations;
+
+    /** Which (unit, type) pairs have a live event. */
+    TBitArray<> Pending;
+
+    double Now = 0.0;
+    uint32 NextSequence = 0;
+};
+
+// ============================================================================
+// TEMPLATE IMPLEMENTATION
+// ============================================================================
+
+template <typename HandlerFuncType>
+void FCombatClock::Advance(double DeltaTime, HandlerFuncType&& HandlerFunc)
+{
+    Now += DeltaTime;
+
+    // Pop before dispatching; the handler is free to change the heap
+    while (Heap.Num() > 0 && Heap.HeapTop().Time <= Now)
+    {
+        FEvent Event;
+        Heap.HeapPop(Event, FEventOrder(), EAllowShrinking::No);
+
+        const int32 Slot = Event.Unit * NumEventTypes + (int32)Event.Type;
+        if (Generations[Slot] != Event.Generation || !Pending[Slot])
+        {
+            continue;
+        }
+
+        Pending[Slot] = false;
+        HandlerFunc(Event.Unit, Event.Type);
+    }
+}
+
+template <typename VisitorFuncType>
+void FCombatClock::ForEachPending(VisitorFuncType&& VisitorFunc) const
+{
+    for (const FEvent& Event : Heap)
+    {
+        const int32 Slot = Event.Unit * NumEventTypes + (int32)Event.Type;
+        if (Generations[Slot] == Event.Generation && Pending[Slot])
+        {
+            VisitorFunc(Event.Unit, Event.Type, Event.Time - Now);
+        }
+    }
+}
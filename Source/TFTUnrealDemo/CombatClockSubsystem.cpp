@@ -0,0 +1,54 @@
+// CombatClockSubsystem.cpp
+
+#include "CombatClockSubsystem.h"
+#include "CombatStats.h"
+#include "UnitRegistrySubsystem.h"
+#include "UnitBase.h"
+#include "Engine/World.h"
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+void UCombatClockSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    UnitRegistry = Collection.InitializeDependency<UUnitRegistrySubsystem>();
+}
+
+void UCombatClockSubsystem::Deinitialize()
+{
+    Clock.Reset();
+    UnitRegistry = nullptr;
+
+    Super::Deinitialize();
+}
+
+TStatId UCombatClockSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatClockSubsystem, STATGROUP_Tickables);
+}
+
+bool UCombatClockSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+// ============================================================================
+// TICK
+// ============================================================================
+
+void UCombatClockSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+    TFT_COMBAT_FRAME_SCOPE(CombatClock);
+
+    Clock.Advance(DeltaTime, [this](int32 Handle, ECombatClockEvent Type)
+        {
+            if (AUnitBase* Unit = UnitRegistry ? UnitRegistry->GetUnit(Handle) : nullptr)
+            {
+                Unit->HandleCombatClockEvent(Type);
+            }
+        });
+}
@@ -0,0 +1,49 @@
+// CombatClockSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatClock.h"
+#include "CombatClockSubsystem.generated.h"
+
+// Forward declarations
+class UUnitRegistrySubsystem;
+
+// ============================================================================
+// COMBAT CLOCK SUBSYSTEM
+// ============================================================================
+
+/**
+ * Drives the live game's FCombatClock with the world tick and hands due events to
+ * AUnitBase::HandleCombatClockEvent. Units are addressed by registry handle, so an
+ * event can never reach a unit that has left play.
+ */
+UCLASS()
+class TFTUNREALDEMO_API UCombatClockSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    void Schedule(int32 Handle, ECombatClockEvent Type, double Delay) { Clock.Schedule(Handle, Type, Delay); }
+    void Cancel(int32 Handle, ECombatClockEvent Type) { Clock.Cancel(Handle, Type); }
+    void CancelAll(int32 Handle) { Clock.CancelAll(Handle); }
+
+    const FCombatClock& GetClock() const { return Clock; }
+
+    UFUNCTION(BlueprintPure, Category = "Combat")
+    int32 GetNumQueuedEvents() const { return Clock.NumQueued(); }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    UPROPERTY()
+    UUnitRegistrySubsystem* UnitRegistry;
+
+    FCombatClock Clock;
+};
@@ -0,0 +1,83 @@
+// CombatDamageSubsystem.cpp
+
+#include "CombatDamageSubsystem.h"
+#include "CombatStats.h"
+#include "UnitBase.h"
+#include "UnitRegistrySubsystem.h"
+#include "Engine/World.h"
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+void UCombatDamageSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    UnitRegistry = Collection.InitializeDependency<UUnitRegistrySubsystem>();
+}
+
+void UCombatDamageSubsystem::Deinitialize()
+{
+    DamageQueue.Reset();
+    UnitRegistry = nullptr;
+
+    Super::Deinitialize();
+}
+
+void UCombatDamageSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+    TFT_COMBAT_FRAME_SCOPE(DamageResolve);
+
+    ResolveDamage();
+}
+
+TStatId UCombatDamageSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatDamageSubsystem, STATGROUP_Tickables);
+}
+
+bool UCombatDamageSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+// ============================================================================
+// DAMAGE
+// ============================================================================
+
+bool UCombatDamageSubsystem::QueueDamage(const AUnitBase* Source, const AUnitBase* Target, float Amount, EDamageType DamageType)
+{
+    if (!Target || Target->GetUnitHandle() == INDEX_NONE)
+    {
+        return false;
+    }
+
+    const int32 SourceHandle = Source ? Source->GetUnitHandle() : INDEX_NONE;
+    DamageQueue.Push(SourceHandle, Target->GetUnitHandle(), Amount, DamageType);
+    return true;
+}
+
+void UCombatDamageSubsystem::ResolveDamage()
+{
+    if (!UnitRegistry || DamageQueue.IsEmpty())
+    {
+        HitsResolvedLastFrame = 0;
+        return;
+    }
+
+    HitsResolvedLastFrame = DamageQueue.Resolve(UnitRegistry->GetStatStore(),
+        [this](const FQueuedDamage& Hit)
+        {
+            // The target may have died to an earlier hit this frame
+            AUnitBase* Target = UnitRegistry->GetUnit(Hit.Target);
+            if (!Target || !Target->bIsAlive)
+            {
+                return;
+            }
+
+            const FDamageInfo DamageInfo(Hit.Amount, Hit.Type, UnitRegistry->GetUnit(Hit.Source));
+            Target->ApplyReducedDamage(DamageInfo, Hit.FinalDamage);
+        });
+}
@@ -0,0 +1,56 @@
+// CombatDamageSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DamageQueue.h"
+#include "CombatDamageSubsystem.generated.h"
+
+// Forward declarations
+class AUnitBase;
+class UUnitRegistrySubsystem;
+
+// ============================================================================
+// COMBAT DAMAGE SUBSYSTEM
+// ============================================================================
+
+/**
+ * Per-frame damage pipeline. Attacks and abilities queue hits during the frame and
+ * they are all resolved once, after every unit has ticked.
+ */
+UCLASS()
+class TFTUNREALDEMO_API UCombatDamageSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    /** Queues a hit for the end-of-frame resolve. Returns false if either unit is not registered. */
+    bool QueueDamage(const AUnitBase* Source, const AUnitBase* Target, float Amount, EDamageType DamageType);
+
+    /** Applies every queued hit now. Called automatically once per frame. */
+    void ResolveDamage();
+
+    /** Drops every queued hit unapplied, e.g. when a snapshot restore rewinds the fight. */
+    void DiscardPendingHits() { DamageQueue.Reset(); }
+
+    UFUNCTION(BlueprintPure, Category = "Combat")
+    int32 GetNumPendingHits() const { return DamageQueue.Num(); }
+
+    UFUNCTION(BlueprintPure, Category = "Combat")
+    int32 GetNumHitsResolvedLastFrame() const { return HitsResolvedLastFrame; }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    UPROPERTY()
+    UUnitRegistrySubsystem* UnitRegistry;
+
+    FDamageQueue DamageQueue;
+    int32 HitsResolvedLastFrame = 0;
+};
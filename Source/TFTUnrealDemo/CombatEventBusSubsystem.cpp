@@ -0,0 +1,131 @@
+// CombatEventBusSubsystem.cpp
+
+#include "CombatEventBusSubsystem.h"
+#include "CombatStats.h"
+#include "UnitBase.h"
+#include "Engine/World.h"
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+void UCombatEventBusSubsystem::Deinitialize()
+{
+    for (int32 TypeIndex = 0; TypeIndex < NumEventTypes; ++TypeIndex)
+    {
+        Subscribers[TypeIndex].Clear();
+        Queues[TypeIndex].Empty();
+        DispatchQueues[TypeIndex].Empty();
+    }
+
+    bSummaryBound = false;
+    NumEventsLastFrame = 0;
+
+    Super::Deinitialize();
+}
+
+TStatId UCombatEventBusSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatEventBusSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatEventBusSubsystem::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+    Super::AddReferencedObjects(InThis, Collector);
+
+    // Events can wait a frame for dispatch, across a garbage collection
+    UCombatEventBusSubsystem* This = CastChecked<UCombatEventBusSubsystem>(InThis);
+    for (int32 TypeIndex = 0; TypeIndex < NumEventTypes; ++TypeIndex)
+    {
+        for (FCombatEvent& Event : This->Queues[TypeIndex])
+        {
+            Collector.AddReferencedObject(Event.Source, This);
+            Collector.AddReferencedObject(Event.Target, This);
+        }
+    }
+}
+
+bool UCombatEventBusSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+// ============================================================================
+// DISPATCH
+// ============================================================================
+
+void UCombatEventBusSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    Dispatch();
+}
+
+void UCombatEventBusSubsystem::Dispatch()
+{
+    TFT_COMBAT_FRAME_SCOPE(EventDispatch);
+
+    // Swap first: subscribers may raise events, which belong to the next batch
+    NumEventsLastFrame = 0;
+    for (int32 TypeIndex = 0; TypeIndex < NumEventTypes; ++TypeIndex)
+    {
+        DispatchQueues[TypeIndex].Reset();
+        Swap(Queues[TypeIndex], DispatchQueues[TypeIndex]);
+        NumEventsLastFrame += DispatchQueues[TypeIndex].Num();
+    }
+
+    if (NumEventsLastFrame > 0)
+    {
+        for (int32 TypeIndex = 0; TypeIndex < NumEventTypes; ++TypeIndex)
+        {
+            if (DispatchQueues[TypeIndex].Num() > 0)
+            {
+                Subscribers[TypeIndex].Broadcast(DispatchQueues[TypeIndex]);
+            }
+        }
+
+        if (bSummaryBound && OnCombatFrameSummary.IsBound())
+        {
+            FCombatFrameSummary Summary;
+            BuildSummary(Summary);
+            OnCombatFrameSummary.Broadcast(Summary);
+        }
+    }
+
+    // Checked once a frame so Push() stays a single flag test
+    bSummaryBound = OnCombatFrameSummary.IsBound();
+}
+
+void UCombatEventBusSubsystem::BuildSummary(FCombatFrameSummary& OutSummary) const
+{
+    OutSummary.NumAttacks = DispatchQueues[(int32)ECombatEventType::Attack].Num();
+
+    const TArray<FCombatEvent>& Hits = DispatchQueues[(int32)ECombatEventType::Damage];
+    OutSummary.NumHits = Hits.Num();
+    for (const FCombatEvent& Event : Hits)
+    {
+        OutSummary.TotalDamage += Event.Amount;
+    }
+
+    for (const FCombatEvent& Event : DispatchQueues[(int32)ECombatEventType::CastStarted])
+    {
+        OutSummary.CastingUnits.Add(Event.Source);
+    }
+
+    for (const FCombatEvent& Event : DispatchQueues[(int32)ECombatEventType::Death])
+    {
+        OutSummary.DeadUnits.Add(Event.Source);
+    }
+
+    // A unit that changed state twice is listed once
+    TSet<AUnitBase*> StateChanged;
+    for (const FCombatEvent& Event : DispatchQueues[(int32)ECombatEventType::StateChanged])
+    {
+        bool bAlreadyListed = false;
+        StateChanged.Add(Event.Source, &bAlreadyListed);
+        if (!bAlreadyListed)
+        {
+            OutSummary.StateChangedUnits.Add(Event.Source);
+        }
+    }
+}
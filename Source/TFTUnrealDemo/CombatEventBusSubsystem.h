@@ -0,0 +1,140 @@
+// CombatEventBusSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatEventLog.h"
+#include "CombatEventBusSubsystem.generated.h"
+
+// Forward declarations
+class AUnitBase;
+
+// ============================================================================
+// EVENTS
+// ============================================================================
+
+/** One gameplay event on the bus. Queued units are referenced for GC; one destroyed before dispatch reads as null. */
+struct FCombatEvent
+{
+    AUnitBase* Source = nullptr;
+    AUnitBase* Target = nullptr;
+    float Amount = 0.0f;
+    ECombatEventType Type = ECombatEventType::Attack;
+
+    /** EDamageType for damage events, EUnitState for state changes. */
+    uint8 Detail = 0;
+};
+
+/** Every event of one type raised since the last dispatch, in the order they happened. */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnCombatEventBatch, TConstArrayView<FCombatEvent>);
+
+/** Coalesced view of one frame's combat for Blueprint listeners. */
+USTRUCT(BlueprintType)
+struct FCombatFrameSummary
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Combat Events")
+    int32 NumAttacks = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Combat Events")
+    int32 NumHits = 0;
+
+    /** Post-mitigation damage dealt this frame. */
+    UPROPERTY(BlueprintReadOnly, Category = "Combat Events")
+    float TotalDamage = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Combat Events")
+    TArray<AUnitBase*> CastingUnits;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Combat Events")
+    TArray<AUnitBase*> DeadUnits;
+
+    /** Units whose state changed; see their GetState() for the new one. */
+    UPROPERTY(BlueprintReadOnly, Category = "Combat Events")
+    TArray<AUnitBase*> StateChangedUnits;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnCombatFrameSummary, const FCombatFrameSummary&, Summary);
+
+// ============================================================================
+// COMBAT EVENT BUS SUBSYSTEM
+// ============================================================================
+
+/**
+ * Native event bus for combat. Units push typed events into per-type queues during the
+ * frame; once per frame every queue is handed to its C++ subscribers as a single batch,
+ * so a thousand attacks cost one delegate call per subscriber rather than a thousand
+ * reflected broadcasts. Blueprint can bind OnCombatFrameSummary for a coalesced view of
+ * the frame, built only while something is bound.
+ *
+ * Events raised by subscribers, or by subsystems that tick after the bus, go out with the
+ * next frame's batch. AUnitBase's dynamic delegates still fire for designers.
+ */
+UCLASS()
+class TFTUNREALDEMO_API UCombatEventBusSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static constexpr int32 NumEventTypes = (int32)ECombatEventType::Reset + 1;
+
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+
+    // ========================================================================
+    // PUBLISHING
+    // ========================================================================
+
+    FORCEINLINE void Push(ECombatEventType Type, AUnitBase* Source, AUnitBase* Target, float Amount = 0.0f, uint8 Detail = 0)
+    {
+        // Nobody listening: nothing to queue
+        if (!bSummaryBound && !Subscribers[(int32)Type].IsBound())
+        {
+            return;
+        }
+
+        FCombatEvent& Event = Queues[(int32)Type].AddDefaulted_GetRef();
+        Event.Source = Source;
+        Event.Target = Target;
+        Event.Amount = Amount;
+        Event.Type = Type;
+        Event.Detail = Detail;
+    }
+
+    /** Hands every queued event to its subscribers now. Called automatically once per frame. */
+    void Dispatch();
+
+    // ========================================================================
+    // SUBSCRIBING
+    // ========================================================================
+
+    /** Batches of Type, once per frame that had any. */
+    FOnCombatEventBatch& OnEvents(ECombatEventType Type) { return Subscribers[(int32)Type]; }
+
+    UPROPERTY(BlueprintAssignable, Category = "Combat Events")
+    FOnCombatFrameSummary OnCombatFrameSummary;
+
+    UFUNCTION(BlueprintPure, Category = "Combat Events")
+    int32 GetNumEventsLastFrame() const { return NumEventsLastFrame; }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    void BuildSummary(FCombatFrameSummary& OutSummary) const;
+
+    FOnCombatEventBatch Subscribers[NumEventTypes];
+
+    /** Filled during the frame; swapped with DispatchQueues so dispatching can raise new events. */
+    TArray<FCombatEvent> Queues[NumEventTypes];
+    TArray<FCombatEvent> DispatchQueues[NumEventTypes];
+
+    /** OnCombatFrameSummary had a listener at the last dispatch. */
+    bool bSummaryBound = false;
+
+    int32 NumEventsLastFrame = 0;
+};
@@ -0,0 +1,204 @@
+// CombatEventLog.cpp
+
+#include "CombatEventLog.h"
+#include "TFTUnrealDemo.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+// ============================================================================
+// RING BUFFER
+// ============================================================================
+
+FCombatEventLog::FCombatEventLog(int32 InCapacity)
+    : WriteIndex(0)
+{
+    check(FMath::IsPowerOfTwo(InCapacity));
+
+    Buffer.SetNumZeroed(InCapacity);
+    Mask = (uint64)InCapacity - 1;
+}
+
+FCombatEventLog& FCombatEventLog::Get()
+{
+    static FCombatEventLog Instance;
+    return Instance;
+}
+
+void FCombatEventLog::Clear()
+{
+    WriteIndex.store(0, std::memory_order_relaxed);
+}
+
+void FCombatEventLog::CopyEvents(TArray<FCombatEventRecord>& OutEvents) const
+{
+    const uint64 End = WriteIndex.load(std::memory_order_acquire);
+    const uint64 Begin = End > (uint64)Buffer.Num() ? End - Buffer.Num() : 0;
+
+    OutEvents.Reset((int32)(End - Begin));
+    for (uint64 Index = Begin; Index < End; ++Index)
+    {
+        OutEvents.Add(Buffer[Index & Mask]);
+    }
+}
+
+// ============================================================================
+// OFFLINE DECODING
+// ============================================================================
+
+bool FCombatEventLog::SaveToFile(const FString& Filename) const
+{
+    TArray<FCombatEventRecord> Events;
+    CopyEvents(Events);
+
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes);
+
+    uint32 Magic = FileMagic;
+    uint32 Version = FileVersion;
+    int32 NumEvents = Events.Num();
+    Writer << Magic << Version << NumEvents;
+    Writer.Serialize(Events.GetData(), Events.Num() * sizeof(FCombatEventRecord));
+
+    return FFileHelper::SaveArrayToFile(Bytes, *Filename);
+}
+
+bool FCombatEventLog::LoadFromFile(const FString& Filename, TArray<FCombatEventRecord>& OutEvents)
+{
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *Filename))
+    {
+        return false;
+    }
+
+    FMemoryReader Reader(Bytes);
+
+    uint32 Magic = 0;
+    uint32 Version = 0;
+    int32 NumEvents = 0;
+    Reader << Magic << Version << NumEvents;
+
+    if (Magic != FileMagic || Version != FileVersion || NumEvents < 0
+        || Reader.TotalSize() - Reader.Tell() < (int64)NumEvents * (int64)sizeof(FCombatEventRecord))
+    {
+        UE_LOG(LogTFTCombat, Error, TEXT("%s is not a combat event file"), *Filename);
+        return false;
+    }
+
+    OutEvents.SetNumUninitialized(NumEvents);
+    Reader.Serialize(OutEvents.GetData(), NumEvents * sizeof(FCombatEventRecord));
+    return true;
+}
+
+FString FCombatEventLog::DecodeEvent(const FCombatEventRecord& Event, TConstArrayView<FString> UnitNames)
+{
+    auto UnitLabel = [&UnitNames](int32 Unit) -> FString
+    {
+        if (Unit == INDEX_NONE)
+        {
+            return TEXT("-");
+        }
+        return UnitNames.IsValidIndex(Unit) ? UnitNames[Unit] : FString::Printf(TEXT("#%d"), Unit);
+    };
+
+    static const TCHAR* DamageTypeNames[] = { TEXT("Physical"), TEXT("Magical"), TEXT("True") };
+    static const TCHAR* StateNames[] = { TEXT("Bench"), TEXT("BoardIdle"), TEXT("Combat") };
+
+    const FString Source = UnitLabel(Event.Source);
+    const FString Target = UnitLabel(Event.Target);
+    const TCHAR* DamageType = Event.Detail < UE_ARRAY_COUNT(DamageTypeNames) ? DamageTypeNames[Event.Detail] : TEXT("?");
+    const TCHAR* State = Event.Detail < UE_ARRAY_COUNT(StateNames) ? StateNames[Event.Detail] : TEXT("?");
+
+    FString Text;
+    switch (Event.Type)
+    {
+    case ECombatEventType::TargetAcquired:
+        Text = FString::Printf(TEXT("%s found new target: %s"), *Source, *Target);
+        break;
+    case ECombatEventType::TargetNotFound:
+        Text = FString::Printf(TEXT("%s could not find a target"), *Source);
+        break;
+    case ECombatEventType::Attack:
+        Text = FString::Printf(TEXT("%s attacked %s for %.1f damage"), *Source, *Target, Event.Amount);
+        break;
+    case ECombatEventType::Damage:
+        Text = FString::Printf(TEXT("%s took %.1f %s damage from %s"), *Target, Event.Amount, DamageType, *Source);
+        break;
+    case ECombatEventType::DamageIgnored:
+        Text = FString::Printf(TEXT("%s is benched and ignored damage"), *Target);
+        break;
+    case ECombatEventType::ManaGained:
+        Text = FString::Printf(TEXT("%s gained %.1f mana"), *Source, Event.Amount);
+        break;
+    case ECombatEventType::CastStarted:
+        Text = FString::Printf(TEXT("%s casting ability"), *Source);
+        break;
+    case ECombatEventType::CastFinished:
+        Text = FString::Printf(TEXT("%s finished casting ability"), *Source);
+        break;
+    case ECombatEventType::StateChanged:
+        Text = FString::Printf(TEXT("%s entered state %s"), *Source, State);
+        break;
+    case ECombatEventType::Death:
+        Text = FString::Printf(TEXT("%s died"), *Source);
+        break;
+    case ECombatEventType::Reset:
+        Text = FString::Printf(TEXT("%s reset for new round"), *Source);
+        break;
+    default:
+        Text = FString::Printf(TEXT("unknown event %d"), (int32)Event.Type);
+        break;
+    }
+
+    return FString::Printf(TEXT("[%8u] %s"), Event.Tick, *Text);
+}
+
+bool FCombatEventLog::DecodeFileToText(const FString& BinaryFilename, const FString& TextFilename)
+{
+    TArray<FCombatEventRecord> Events;
+    if (!LoadFromFile(BinaryFilename, Events))
+    {
+        return false;
+    }
+
+    TArray<FString> Lines;
+    Lines.Reserve(Events.Num());
+    for (const FCombatEventRecord& Event : Events)
+    {
+        Lines.Add(DecodeEvent(Event));
+    }
+
+    return FFileHelper::SaveStringArrayToFile(Lines, *TextFilename);
+}
+
+// ============================================================================
+// CONSOLE COMMANDS
+// ============================================================================
+
+#if TFT_WITH_COMBAT_EVENTS
+
+static FAutoConsoleCommand GDumpCombatEventsCommand(
+    TEXT("TFT.CombatEvents.Dump"),
+    TEXT("Writes the combat event ring to Saved/Logs/CombatEvents.bin (or the given path) and decodes it next to it as .txt"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        const FString BinaryFilename = Args.Num() > 0 ? Args[0] : FPaths::ProjectLogDir() / TEXT("CombatEvents.bin");
+        const FString TextFilename = FPaths::ChangeExtension(BinaryFilename, TEXT("txt"));
+
+        if (FCombatEventLog::Get().SaveToFile(BinaryFilename) && FCombatEventLog::DecodeFileToText(BinaryFilename, TextFilename))
+        {
+            UE_LOG(LogTFTCombat, Display, TEXT("Dumped combat events (%llu recorded) to %s"), FCombatEventLog::Get().GetNumRecorded(), *TextFilename);
+        }
+    }));
+
+static FAutoConsoleCommand GClearCombatEventsCommand(
+    TEXT("TFT.CombatEvents.Clear"),
+    TEXT("Empties the combat event ring"),
+    FConsoleCommandDelegate::CreateLambda([]()
+    {
+        FCombatEventLog::Get().Clear();
+    }));
+
+#endif
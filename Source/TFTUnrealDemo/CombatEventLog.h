@@ -0,0 +1,126 @@
+// CombatEventLog.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatTypes.h"
+#include "CombatStats.h"
+#include <atomic>
+
+// Combat event recording is stripped from Shipping builds unless overridden in Build.cs
+#ifndef TFT_WITH_COMBAT_EVENTS
+#define TFT_WITH_COMBAT_EVENTS !UE_BUILD_SHIPPING
+#endif
+
+// ============================================================================
+// EVENT RECORDS
+// ============================================================================
+
+enum class ECombatEventType : uint8
+{
+    TargetAcquired,
+    TargetNotFound,
+    Attack,
+    Damage,
+    DamageIgnored,
+    ManaGained,
+    CastStarted,
+    CastFinished,
+    StateChanged,
+    Death,
+    Reset
+};
+
+/** Fixed-size binary record. Names and text are only produced when decoding. Units are registry handles. */
+struct FCombatEventRecord
+{
+    uint32 Tick = 0;
+    int32 Source = INDEX_NONE;
+    int32 Target = INDEX_NONE;
+    float Amount = 0.0f;
+    ECombatEventType Type = ECombatEventType::Attack;
+
+    /** EDamageType for damage events, EUnitState for state changes. */
+    uint8 Detail = 0;
+    uint16 Reserved = 0;
+};
+
+static_assert(sizeof(FCombatEventRecord) == 20, "Combat event records are written to disk as raw 20-byte blocks");
+
+// ============================================================================
+// EVENT LOG
+// ============================================================================
+
+/**
+ * Lock-free ring buffer of combat events. Any thread can record; each record claims a
+ * slot with a single atomic increment and the oldest events are overwritten once the
+ * ring wraps. Reading (Copy/Save) is only meaningful while no producer is running,
+ * e.g. between frames on the game thread.
+ */
+class TFTUNREALDEMO_API FCombatEventLog
+{
+public:
+    static constexpr uint32 FileMagic = 0x54464345; // 'TFCE'
+    static constexpr uint32 FileVersion = 2;
+    static constexpr int32 DefaultCapacity = 1 << 16;
+
+    explicit FCombatEventLog(int32 InCapacity = DefaultCapacity);
+
+    /** Process-wide log used by live AUnitBase actors. */
+    static FCombatEventLog& Get();
+
+    FORCEINLINE void Record(ECombatEventType Type, uint32 Tick, int32 Source, int32 Target, float Amount = 0.0f, uint8 Detail = 0)
+    {
+        const uint64 Index = WriteIndex.fetch_add(1, std::memory_order_relaxed);
+
+        FCombatEventRecord& Event = Buffer[Index & Mask];
+        Event.Tick = Tick;
+        Event.Source = Source;
+        Event.Target = Target;
+        Event.Amount = Amount;
+        Event.Type = Type;
+        Event.Detail = Detail;
+    }
+
+    void Clear();
+
+    /** Total events ever recorded, including overwritten ones. */
+    uint64 GetNumRecorded() const { return WriteIndex.load(std::memory_order_relaxed); }
+
+    /** Copies the retained events, oldest first. */
+    void CopyEvents(TArray<FCombatEventRecord>& OutEvents) const;
+
+    // ========================================================================
+    // OFFLINE DECODING
+    // ========================================================================
+
+    /** Writes the retained events as a versioned binary blob. */
+    bool SaveToFile(const FString& Filename) const;
+
+    static bool LoadFromFile(const FString& Filename, TArray<FCombatEventRecord>& OutEvents);
+
+    /** One human-readable line per event. UnitNames is optional and indexed by unit id. */
+    static FString DecodeEvent(const FCombatEventRecord& Event, TConstArrayView<FString> UnitNames = {});
+
+    static bool DecodeFileToText(const FString& BinaryFilename, const FString& TextFilename);
+
+private:
+    TArray<FCombatEventRecord> Buffer;
+    uint64 Mask;
+    std::atomic<uint64> WriteIndex;
+};
+
+// ============================================================================
+// RECORDING MACRO
+// ============================================================================
+
+// Live events also go to the TFTCombat Insights channel while it is enabled
+#if TFT_WITH_COMBAT_EVENTS
+#define TFT_RECORD_COMBAT_EVENT(Type, Tick, Source, Target, ...) \
+    do \
+    { \
+        FCombatEventLog::Get().Record(ECombatEventType::Type, (uint32)(Tick), Source, Target, ##__VA_ARGS__); \
+        TFT_TRACE_COMBAT_EVENT(Type, Tick, Source, Target, ##__VA_ARGS__); \
+    } while (0)
+#else
+#define TFT_RECORD_COMBAT_EVENT(...) do { } while (0)
+#endif
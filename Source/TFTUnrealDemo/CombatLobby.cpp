@@ -0,0 +1,119 @@
+// CombatLobby.cpp
+
+#include "CombatLobby.h"
+#include "Async/ParallelFor.h"
+
+FCombatLobby::FCombatLobby(float InFixedDeltaTime)
+    : FixedDeltaTime(InFixedDeltaTime)
+{
+    Boards.Reserve(DefaultNumBoards);
+}
+
+// ============================================================================
+// SETUP
+// ============================================================================
+
+void FCombatLobby::StartBoard(int32 BoardId, TConstArrayView<FCombatUnitDesc> Units, int32 MaxSteps)
+{
+    CancelBoard(BoardId);
+
+    FBoard& Board = Boards.AddDefaulted_GetRef();
+    Board.BoardId = BoardId;
+    Board.MaxSteps = FMath::Max(MaxSteps, 1);
+    Board.Simulation = MakeUnique<FCombatSimulation>(FixedDeltaTime);
+
+    for (const FCombatUnitDesc& Desc : Units)
+    {
+        Board.Simulation->AddUnit(Desc);
+    }
+
+    // Keep boards in id order so results come out the same way every run
+    Boards.StableSort([](const FBoard& A, const FBoard& B) { return A.BoardId < B.BoardId; });
+}
+
+void FCombatLobby::CancelBoard(int32 BoardId)
+{
+    Boards.RemoveAll([BoardId](const FBoard& Board) { return Board.BoardId == BoardId; });
+}
+
+void FCombatLobby::Reset()
+{
+    Boards.Reset();
+}
+
+const FCombatLobby::FBoard* FCombatLobby::FindBoard(int32 BoardId) const
+{
+    return Boards.FindByPredicate([BoardId](const FBoard& Board) { return Board.BoardId == BoardId; });
+}
+
+const FCombatSimulation* FCombatLobby::GetBoardSimulation(int32 BoardId) const
+{
+    const FBoard* Board = FindBoard(BoardId);
+    return Board ? Board->Simulation.Get() : nullptr;
+}
+
+// ============================================================================
+// SIMULATION
+// ============================================================================
+
+bool FCombatLobby::IsBoardDone(const FBoard& Board)
+{
+    return Board.Simulation->IsFinished() || Board.Simulation->GetTickCount() >= Board.MaxSteps;
+}
+
+void FCombatLobby::Step(int32 NumSteps)
+{
+    if (Boards.Num() == 0 || NumSteps <= 0)
+    {
+        return;
+    }
+
+    // Every board only touches its own simulation, so boards need no locking
+    ParallelFor(Boards.Num(), [this, NumSteps](int32 BoardIndex)
+        {
+            FBoard& Board = Boards[BoardIndex];
+            for (int32 StepIndex = 0; StepIndex < NumSteps && !IsBoardDone(Board); ++StepIndex)
+            {
+                Board.Simulation->Step();
+            }
+        },
+        bSingleThreaded ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+}
+
+void FCombatLobby::CollectFinished(TArray<FCombatBoardResult>& OutResults)
+{
+    for (int32 BoardIndex = 0; BoardIndex < Boards.Num(); )
+    {
+        const FBoard& Board = Boards[BoardIndex];
+        if (!IsBoardDone(Board))
+        {
+            ++BoardIndex;
+            continue;
+        }
+
+        const FCombatSimulation& Simulation = *Board.Simulation;
+
+        FCombatBoardResult& Result = OutResults.AddDefaulted_GetRef();
+        Result.BoardId = Board.BoardId;
+        Result.bTimedOut = !Simulation.IsFinished();
+        Result.WinningTeam = Result.bTimedOut ? INDEX_NONE : Simulation.GetWinningTeam();
+        Result.Steps = Simulation.GetTickCount();
+        Result.Seconds = Simulation.GetElapsedTime();
+
+        Result.FinalHealth.SetNumUninitialized(Simulation.NumUnits());
+        Result.FinalMana.SetNumUninitialized(Simulation.NumUnits());
+
+        for (int32 UnitIndex = 0; UnitIndex < Simulation.NumUnits(); ++UnitIndex)
+        {
+            if (Simulation.GetUnit(UnitIndex).bIsAlive)
+            {
+                Result.Survivors.Add(UnitIndex);
+            }
+
+            Result.FinalHealth[UnitIndex] = Simulation.GetCurrentHealth(UnitIndex);
+            Result.FinalMana[UnitIndex] = Simulation.GetCurrentMana(UnitIndex);
+        }
+
+        Boards.RemoveAt(BoardIndex, EAllowShrinking::No);
+    }
+}
@@ -0,0 +1,84 @@
+// CombatLobby.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatSimulation.h"
+
+// ============================================================================
+// BOARD RESULTS
+// ============================================================================
+
+struct FCombatBoardResult
+{
+    int32 BoardId = INDEX_NONE;
+
+    /** Surviving team index, or INDEX_NONE for a draw or a timeout. */
+    int32 WinningTeam = INDEX_NONE;
+
+    int32 Steps = 0;
+    float Seconds = 0.0f;
+    bool bTimedOut = false;
+
+    /** Unit indices, in the order the board's units were added, still alive at the end. */
+    TArray<int32> Survivors;
+
+    /** Final health and mana of every unit, in the order the board's units were added. */
+    TArray<float> FinalHealth;
+    TArray<float> FinalMana;
+};
+
+// ============================================================================
+// COMBAT LOBBY
+// ============================================================================
+
+/**
+ * Runs the fights of every board in a lobby side by side. Each board owns its own
+ * FCombatSimulation, so boards share no state and can be stepped on worker threads;
+ * results are handed out on the calling thread in board order.
+ */
+class TFTUNREALDEMO_API FCombatLobby
+{
+public:
+    static constexpr int32 DefaultNumBoards = 8;
+
+    explicit FCombatLobby(float InFixedDeltaTime = FCombatSimulation::DefaultFixedDeltaTime);
+
+    /**
+     * Starts a fight on BoardId with Units, replacing any fight already running there.
+     * The fight is cut off as a timeout after MaxSteps fixed steps.
+     */
+    void StartBoard(int32 BoardId, TConstArrayView<FCombatUnitDesc> Units, int32 MaxSteps);
+
+    void CancelBoard(int32 BoardId);
+    void Reset();
+
+    /** Advances every running board by NumSteps fixed steps, one board per parallel task. */
+    void Step(int32 NumSteps = 1);
+
+    /** Moves every board whose fight ended since the last call into OutResults and frees it. */
+    void CollectFinished(TArray<FCombatBoardResult>& OutResults);
+
+    bool IsBoardRunning(int32 BoardId) const { return FindBoard(BoardId) != nullptr; }
+    const FCombatSimulation* GetBoardSimulation(int32 BoardId) const;
+    int32 NumRunning() const { return Boards.Num(); }
+
+    /** Steps every board on the calling thread. Results are identical either way. */
+    void SetSingleThreaded(bool bInSingleThreaded) { bSingleThreaded = bInSingleThreaded; }
+
+    float GetFixedDeltaTime() const { return FixedDeltaTime; }
+
+private:
+    struct FBoard
+    {
+        int32 BoardId = INDEX_NONE;
+        int32 MaxSteps = 0;
+        TUniquePtr<FCombatSimulation> Simulation;
+    };
+
+    const FBoard* FindBoard(int32 BoardId) const;
+    static bool IsBoardDone(const FBoard& Board);
+
+    TArray<FBoard> Boards;
+    float FixedDeltaTime;
+    bool bSingleThreaded = false;
+};
@@ -0,0 +1,209 @@
+// CombatLobbySubsystem.cpp
+
+#include "CombatLobbySubsystem.h"
+#include "CombatStats.h"
+#include "UnitRegistrySubsystem.h"
+#include "UnitBase.h"
+#include "TFTUnrealDemo.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+// ============================================================================
+// CONSOLE VARIABLES
+// ============================================================================
+
+static bool GLobbySingleThread = false;
+static FAutoConsoleVariableRef CVarLobbySingleThread(
+    TEXT("TFT.Lobby.SingleThread"),
+    GLobbySingleThread,
+    TEXT("Step every lobby board on the game thread instead of in parallel. Outcomes are identical."));
+
+static float GLobbyMaxFightSeconds = 60.0f;
+static FAutoConsoleVariableRef CVarLobbyMaxFightSeconds(
+    TEXT("TFT.Lobby.MaxFightSeconds"),
+    GLobbyMaxFightSeconds,
+    TEXT("Simulated seconds after which a lobby board fight ends as a draw."));
+
+static int32 GLobbyMaxStepsPerFrame = 8;
+static FAutoConsoleVariableRef CVarLobbyMaxStepsPerFrame(
+    TEXT("TFT.Lobby.MaxStepsPerFrame"),
+    GLobbyMaxStepsPerFrame,
+    TEXT("Most fixed steps lobby boards catch up in one frame; a long hitch slows the fights down instead."));
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+void UCombatLobbySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    UnitRegistry = Collection.InitializeDependency<UUnitRegistrySubsystem>();
+}
+
+void UCombatLobbySubsystem::Deinitialize()
+{
+    Lobby.Reset();
+    BoardUnits.Reset();
+    FinishedBoards.Reset();
+    StepAccumulator = 0.0f;
+    UnitRegistry = nullptr;
+
+    Super::Deinitialize();
+}
+
+TStatId UCombatLobbySubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatLobbySubsystem, STATGROUP_Tickables);
+}
+
+bool UCombatLobbySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+// ============================================================================
+// FIGHTS
+// ============================================================================
+
+bool UCombatLobbySubsystem::StartBoardFightFromUnits(int32 BoardId)
+{
+    if (!UnitRegistry)
+    {
+        return false;
+    }
+
+    BoardId = UUnitRegistrySubsystem::ClampBoardId(BoardId);
+
+    FCombatBoardUnits Actors;
+    TArray<FCombatUnitDesc> Descs;
+
+    for (int32 Handle = 0; Handle < UnitRegistry->GetNumHandles(); ++Handle)
+    {
+        AUnitBase* Unit = UnitRegistry->GetUnit(Handle);
+        if (!Unit || Unit->IsInPool() || !Unit->bIsAlive || UUnitRegistrySubsystem::ClampBoardId(Unit->BoardId) != BoardId)
+        {
+            continue;
+        }
+
+        const EUnitState State = Unit->GetState();
+        if (State != EUnitState::BoardIdle && State != EUnitState::Combat)
+        {
+            continue;
+        }
+
+        // The simulation would resolve this unit's fight differently from the actors
+        if (!Unit->CanFightHeadless())
+        {
+            UE_LOG(LogTFTCombat, Verbose, TEXT("Board %d keeps fighting with actors: %s needs abilities, projectiles or status effects"), BoardId, *Unit->UnitName);
+            return false;
+        }
+
+        FCombatUnitDesc& Desc = Descs.AddDefaulted_GetRef();
+        Unit->GetCombatUnitDesc(Desc);
+        Desc.InitialState = EUnitState::Combat;
+
+        Actors.Units.Add(Unit);
+    }
+
+    if (Descs.Num() == 0)
+    {
+        return false;
+    }
+
+    StartBoardFight(BoardId, Descs);
+
+    // The simulation plays the round out; the actors wait on the board for the result
+    for (AUnitBase* Unit : Actors.Units)
+    {
+        Unit->SetState(EUnitState::BoardIdle);
+    }
+
+    BoardUnits.Add(BoardId, MoveTemp(Actors));
+    return true;
+}
+
+void UCombatLobbySubsystem::StartBoardFight(int32 BoardId, TConstArrayView<FCombatUnitDesc> Units)
+{
+    BoardUnits.Remove(BoardId);
+
+    const int32 MaxSteps = FMath::CeilToInt(GLobbyMaxFightSeconds / Lobby.GetFixedDeltaTime());
+    Lobby.StartBoard(BoardId, Units, MaxSteps);
+}
+
+void UCombatLobbySubsystem::CancelBoardFight(int32 BoardId)
+{
+    Lobby.CancelBoard(BoardId);
+    BoardUnits.Remove(BoardId);
+}
+
+// ============================================================================
+// TICK
+// ============================================================================
+
+void UCombatLobbySubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (Lobby.NumRunning() == 0)
+    {
+        StepAccumulator = 0.0f;
+        return;
+    }
+
+    TFT_COMBAT_FRAME_SCOPE(CombatLobby);
+
+    const float FixedDeltaTime = Lobby.GetFixedDeltaTime();
+    StepAccumulator += DeltaTime;
+
+    const int32 NumSteps = FMath::Min(FMath::FloorToInt(StepAccumulator / FixedDeltaTime), FMath::Max(GLobbyMaxStepsPerFrame, 1));
+    StepAccumulator = FMath::Min(StepAccumulator - NumSteps * FixedDeltaTime, FixedDeltaTime);
+
+    Lobby.SetSingleThreaded(GLobbySingleThread);
+    Lobby.Step(NumSteps);
+
+    ReportFinishedBoards();
+}
+
+void UCombatLobbySubsystem::ReportFinishedBoards()
+{
+    FinishedBoards.Reset();
+    Lobby.CollectFinished(FinishedBoards);
+
+    for (const FCombatBoardResult& Result : FinishedBoards)
+    {
+        FCombatBoardSummary Summary;
+        Summary.BoardId = Result.BoardId;
+        Summary.bDraw = Result.WinningTeam == INDEX_NONE;
+        Summary.WinningTeam = Summary.bDraw ? ETeam::Player : (ETeam)Result.WinningTeam;
+        Summary.bTimedOut = Result.bTimedOut;
+        Summary.Seconds = Result.Seconds;
+        Summary.NumSurvivors = Result.Survivors.Num();
+
+        // Play the simulated outcome onto the actors that sat the round out
+        FCombatBoardUnits Actors;
+        if (BoardUnits.RemoveAndCopyValue(Result.BoardId, Actors))
+        {
+            for (int32 UnitIndex = 0; UnitIndex < Actors.Units.Num(); ++UnitIndex)
+            {
+                AUnitBase* Unit = Actors.Units[UnitIndex];
+                if (!IsValid(Unit) || Unit->IsInPool() || !Result.FinalHealth.IsValidIndex(UnitIndex))
+                {
+                    continue;
+                }
+
+                const bool bSurvived = Result.Survivors.Contains(UnitIndex);
+                Unit->ApplyHeadlessOutcome(bSurvived, Result.FinalHealth[UnitIndex], Result.FinalMana[UnitIndex]);
+                if (bSurvived)
+                {
+                    Summary.SurvivingUnits.Add(Unit);
+                }
+            }
+        }
+
+        UE_LOG(LogTFTCombat, Verbose, TEXT("Board %d finished after %.1fs: %s, %d survivors"),
+            Summary.BoardId, Summary.Seconds, Summary.bDraw ? TEXT("draw") : *UEnum::GetValueAsString(Summary.WinningTeam), Summary.NumSurvivors);
+
+        OnBoardFightFinished.Broadcast(Summary);
+    }
+}
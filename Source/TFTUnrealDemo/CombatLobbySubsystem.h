@@ -0,0 +1,132 @@
+// CombatLobbySubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatTypes.h"
+#include "CombatLobby.h"
+#include "CombatLobbySubsystem.generated.h"
+
+// Forward declarations
+class AUnitBase;
+class UUnitRegistrySubsystem;
+
+// ============================================================================
+// STRUCTS
+// ============================================================================
+
+/** Outcome of one board's fight, handed to Blueprint once the fight ends. */
+USTRUCT(BlueprintType)
+struct FCombatBoardSummary
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Lobby")
+    int32 BoardId = 0;
+
+    /** Only meaningful when bDraw is false. */
+    UPROPERTY(BlueprintReadOnly, Category = "Lobby")
+    ETeam WinningTeam = ETeam::Player;
+
+    /** No team left standing, or the fight ran past TFT.Lobby.MaxFightSeconds. */
+    UPROPERTY(BlueprintReadOnly, Category = "Lobby")
+    bool bDraw = true;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Lobby")
+    bool bTimedOut = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Lobby")
+    float Seconds = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Lobby")
+    int32 NumSurvivors = 0;
+
+    /** Actors whose simulated units survived, already updated with their final health and mana. Empty for fights started from plain descs. */
+    UPROPERTY(BlueprintReadOnly, Category = "Lobby")
+    TArray<AUnitBase*> SurvivingUnits;
+};
+
+/** Actors standing in for a board's simulated units, in the order they were added. */
+USTRUCT()
+struct FCombatBoardUnits
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TArray<AUnitBase*> Units;
+};
+
+// ============================================================================
+// COMBAT LOBBY SUBSYSTEM
+// ============================================================================
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnBoardFightFinished, const FCombatBoardSummary&, Summary);
+
+/**
+ * Resolves the fights of every board in a lobby (FCombatLobby::DefaultNumBoards by
+ * default) headlessly, in parallel, at FCombatSimulation's fixed step. A fight started
+ * from a board's units snapshots them into descs and parks the actors in BoardIdle, so
+ * only the simulation plays the round out; the result is applied back to the actors.
+ * Finished boards are reported on the game thread in board order through OnBoardFightFinished.
+ *
+ * Meant for the boards nobody is watching; the local player's board can keep fighting
+ * with actors as before. Boards are told apart by AUnitBase::BoardId.
+ */
+UCLASS()
+class TFTUNREALDEMO_API UCombatLobbySubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // ========================================================================
+    // FIGHTS
+    // ========================================================================
+
+    /**
+     * Fights every unit on BoardId that is on the board or in combat, headlessly. When the
+     * fight ends the outcome is written back: survivors take their final health and mana and
+     * idle on the board, the others die. Returns false if the board has nothing to fight with,
+     * or a unit needs mechanics the simulation lacks (see AUnitBase::CanFightHeadless).
+     */
+    UFUNCTION(BlueprintCallable, Category = "Lobby")
+    bool StartBoardFightFromUnits(int32 BoardId);
+
+    /** Fights Units on BoardId with no actors attached, e.g. a ghost board built from another player's composition. */
+    void StartBoardFight(int32 BoardId, TConstArrayView<FCombatUnitDesc> Units);
+
+    UFUNCTION(BlueprintCallable, Category = "Lobby")
+    void CancelBoardFight(int32 BoardId);
+
+    UFUNCTION(BlueprintPure, Category = "Lobby")
+    bool IsBoardFighting(int32 BoardId) const { return Lobby.IsBoardRunning(BoardId); }
+
+    UFUNCTION(BlueprintPure, Category = "Lobby")
+    int32 GetNumRunningBoards() const { return Lobby.NumRunning(); }
+
+    UPROPERTY(BlueprintAssignable, Category = "Lobby")
+    FOnBoardFightFinished OnBoardFightFinished;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    void ReportFinishedBoards();
+
+    UPROPERTY()
+    UUnitRegistrySubsystem* UnitRegistry;
+
+    /** Actors behind each running board's simulated units. */
+    UPROPERTY()
+    TMap<int32, FCombatBoardUnits> BoardUnits;
+
+    FCombatLobby Lobby;
+    TArray<FCombatBoardResult> FinishedBoards;
+
+    /** Game time not yet covered by a fixed simulation step. */
+    float StepAccumulator = 0.0f;
+};
@@ -0,0 +1,170 @@
+// CombatNetState.cpp
+
+#include "CombatNetState.h"
+#include "UnitBase.h"
+#include "ProjectileSubsystem.h"
+#include "Net/UnrealNetwork.h"
+
+// ============================================================================
+// UNIT STATE ITEM
+// ============================================================================
+
+bool FUnitCombatStateItem::Capture(const AUnitBase& InUnit)
+{
+    const uint16 NewMaxHealth = (uint16)FMath::Clamp(FMath::RoundToInt(InUnit.MaxHealth), 0, (int32)MAX_uint16);
+    const uint16 NewMaxMana = (uint16)FMath::Clamp(FMath::RoundToInt(InUnit.MaxMana), 0, (int32)MAX_uint16);
+
+    // Rounded up, so a living unit never shows an empty health bar
+    const float HealthFraction = InUnit.MaxHealth > 0.0f ? FMath::Clamp(InUnit.CurrentHealth / InUnit.MaxHealth, 0.0f, 1.0f) : 0.0f;
+    const float ManaFraction = InUnit.MaxMana > 0.0f ? FMath::Clamp(InUnit.CurrentMana / InUnit.MaxMana, 0.0f, 1.0f) : 0.0f;
+    const uint8 NewHealth = (uint8)FMath::CeilToInt(HealthFraction * 255.0f);
+    const uint8 NewMana = (uint8)FMath::RoundToInt(ManaFraction * 255.0f);
+
+    const uint8 NewFlags = (InUnit.bIsAlive ? Alive : 0) | (InUnit.bIsCastingAbility ? CastingAbility : 0);
+
+    const bool bChanged = Target != InUnit.CurrentTarget
+        || MaxHealth != NewMaxHealth
+        || MaxMana != NewMaxMana
+        || Health != NewHealth
+        || Mana != NewMana
+        || Team != InUnit.Team
+        || State != InUnit.GetState()
+        || Flags != NewFlags;
+
+    Target = InUnit.CurrentTarget;
+    MaxHealth = NewMaxHealth;
+    MaxMana = NewMaxMana;
+    Health = NewHealth;
+    Mana = NewMana;
+    Team = InUnit.Team;
+    State = InUnit.GetState();
+    Flags = NewFlags;
+
+    return bChanged;
+}
+
+void FUnitCombatStateItem::PostReplicatedAdd(const FUnitCombatStateArray& InArraySerializer)
+{
+    // Units whose actor has not arrived yet get a change callback once it does
+    if (Unit)
+    {
+        Unit->ApplyReplicatedCombatState(*this);
+    }
+}
+
+void FUnitCombatStateItem::PostReplicatedChange(const FUnitCombatStateArray& InArraySerializer)
+{
+    if (Unit)
+    {
+        Unit->ApplyReplicatedCombatState(*this);
+    }
+}
+
+// ============================================================================
+// UNIT STATE ARRAY
+// ============================================================================
+
+bool FUnitCombatStateArray::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+{
+    const int64 StartBits = DeltaParms.Writer ? DeltaParms.Writer->GetNumBits() : 0;
+
+    const bool bResult = FFastArraySerializer::FastArrayDeltaSerialize<FUnitCombatStateItem, FUnitCombatStateArray>(Items, DeltaParms, *this);
+
+    if (DeltaParms.Writer)
+    {
+        BitsWritten += DeltaParms.Writer->GetNumBits() - StartBits;
+    }
+
+    return bResult;
+}
+
+// ============================================================================
+// BOARD COMBAT STATE
+// ============================================================================
+
+ABoardCombatState::ABoardCombatState()
+{
+    PrimaryActorTick.bCanEverTick = false;
+
+    bReplicates = true;
+    bAlwaysRelevant = true;
+    SetNetUpdateFrequency(10.0f);
+
+    BoardId = 0;
+}
+
+void ABoardCombatState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    DOREPLIFETIME_CONDITION(ABoardCombatState, BoardId, COND_InitialOnly);
+    DOREPLIFETIME(ABoardCombatState, UnitStates);
+}
+
+void ABoardCombatState::UpdateUnit(AUnitBase* Unit)
+{
+    if (const int32* ItemIndex = ItemIndices.Find(Unit))
+    {
+        FUnitCombatStateItem& Item = UnitStates.Items[*ItemIndex];
+        if (Item.Capture(*Unit))
+        {
+            UnitStates.MarkItemDirty(Item);
+        }
+        return;
+    }
+
+    ItemIndices.Add(Unit, UnitStates.Items.Num());
+
+    FUnitCombatStateItem& Item = UnitStates.Items.AddDefaulted_GetRef();
+    Item.Unit = Unit;
+    Item.Capture(*Unit);
+    UnitStates.MarkItemDirty(Item);
+}
+
+void ABoardCombatState::RemoveUnit(AUnitBase* Unit)
+{
+    int32 ItemIndex = INDEX_NONE;
+    if (!ItemIndices.RemoveAndCopyValue(Unit, ItemIndex))
+    {
+        return;
+    }
+
+    UnitStates.Items.RemoveAtSwap(ItemIndex, EAllowShrinking::No);
+    if (UnitStates.Items.IsValidIndex(ItemIndex))
+    {
+        ItemIndices.Add(UnitStates.Items[ItemIndex].Unit, ItemIndex);
+    }
+
+    UnitStates.MarkArrayDirty();
+}
+
+void ABoardCombatState::MulticastUnitDied_Implementation(AUnitBase* Unit)
+{
+    // The server's unit already died for real
+    if (Unit && !Unit->HasAuthority())
+    {
+        Unit->PlayReplicatedDeath();
+    }
+}
+
+void ABoardCombatState::MulticastAbilityCast_Implementation(AUnitBase* Unit)
+{
+    if (Unit && !Unit->HasAuthority())
+    {
+        Unit->PlayReplicatedCast();
+    }
+}
+
+void ABoardCombatState::MulticastProjectileLaunched_Implementation(FVector_NetQuantize Origin, AUnitBase* Target, float Speed, bool bHoming)
+{
+    // A listen server already flies the real projectile
+    if (GetNetMode() != NM_Client)
+    {
+        return;
+    }
+
+    if (UProjectileSubsystem* Projectiles = GetWorld()->GetSubsystem<UProjectileSubsystem>())
+    {
+        Projectiles->LaunchCosmeticProjectile(Origin, Target, Speed, bHoming);
+    }
+}
@@ -0,0 +1,158 @@
+// CombatNetState.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Info.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "CombatTypes.h"
+#include "CombatNetState.generated.h"
+
+// Forward declarations
+class AUnitBase;
+struct FUnitCombatStateArray;
+
+// ============================================================================
+// UNIT STATE ITEM
+// ============================================================================
+
+/**
+ * Combat state of one unit as clients see it. Health and mana are sent as a byte
+ * fraction of their maximum; the maximums only change with star level, so delta
+ * serialization leaves them out of nearly every update.
+ */
+USTRUCT()
+struct FUnitCombatStateItem : public FFastArraySerializerItem
+{
+    GENERATED_BODY()
+
+    enum EFlags : uint8
+    {
+        Alive = 1 << 0,
+        CastingAbility = 1 << 1,
+    };
+
+    UPROPERTY()
+    AUnitBase* Unit = nullptr;
+
+    UPROPERTY()
+    AUnitBase* Target = nullptr;
+
+    UPROPERTY()
+    uint16 MaxHealth = 0;
+
+    UPROPERTY()
+    uint16 MaxMana = 0;
+
+    UPROPERTY()
+    uint8 Health = 0;
+
+    UPROPERTY()
+    uint8 Mana = 0;
+
+    UPROPERTY()
+    ETeam Team = ETeam::Player;
+
+    UPROPERTY()
+    EUnitState State = EUnitState::Bench;
+
+    UPROPERTY()
+    uint8 Flags = 0;
+
+    /** Quantizes the unit's current state into this item. Returns true if anything a client sees changed. */
+    bool Capture(const AUnitBase& InUnit);
+
+    float GetHealth() const { return Health * (float)MaxHealth / 255.0f; }
+    float GetMana() const { return Mana * (float)MaxMana / 255.0f; }
+    bool IsAlive() const { return (Flags & Alive) != 0; }
+    bool IsCastingAbility() const { return (Flags & CastingAbility) != 0; }
+
+    void PostReplicatedAdd(const FUnitCombatStateArray& InArraySerializer);
+    void PostReplicatedChange(const FUnitCombatStateArray& InArraySerializer);
+};
+
+// ============================================================================
+// UNIT STATE ARRAY
+// ============================================================================
+
+/** Only items marked dirty since the last send go out, each as a delta against what the client has. */
+USTRUCT()
+struct FUnitCombatStateArray : public FFastArraySerializer
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TArray<FUnitCombatStateItem> Items;
+
+    /** Bits this array has written to all connections so far, for bandwidth reports. */
+    int64 BitsWritten = 0;
+
+    FUnitCombatStateArray()
+    {
+        SetDeltaSerializationEnabled(true);
+    }
+
+    bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms);
+};
+
+template<>
+struct TStructOpsTypeTraits<FUnitCombatStateArray> : public TStructOpsTypeTraitsBase2<FUnitCombatStateArray>
+{
+    enum
+    {
+        WithNetDeltaSerializer = true,
+    };
+};
+
+// ============================================================================
+// BOARD COMBAT STATE
+// ============================================================================
+
+/**
+ * Replicated combat state of every unit on one board, spawned on the server by
+ * UCombatReplicationSubsystem. Clients render the fight from it (health, mana, state,
+ * target) without running Think; deaths and casts arrive as multicast events so their
+ * montages start on time even between state updates.
+ */
+UCLASS(NotPlaceable)
+class TFTUNREALDEMO_API ABoardCombatState : public AInfo
+{
+    GENERATED_BODY()
+
+public:
+    ABoardCombatState();
+
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+    // ========================================================================
+    // SERVER
+    // ========================================================================
+
+    /** Adds the unit or refreshes its item; only items whose quantized state changed are marked dirty. */
+    void UpdateUnit(AUnitBase* Unit);
+
+    void RemoveUnit(AUnitBase* Unit);
+
+    int32 NumUnits() const { return UnitStates.Items.Num(); }
+    int64 GetBitsWritten() const { return UnitStates.BitsWritten; }
+
+    UFUNCTION(NetMulticast, Reliable)
+    void MulticastUnitDied(AUnitBase* Unit);
+
+    /** Cosmetic only, so a dropped cast event just skips the montage. */
+    UFUNCTION(NetMulticast, Unreliable)
+    void MulticastAbilityCast(AUnitBase* Unit);
+
+    /** Cosmetic only: clients fly a damage-free copy of the server's projectile. */
+    UFUNCTION(NetMulticast, Unreliable)
+    void MulticastProjectileLaunched(FVector_NetQuantize Origin, AUnitBase* Target, float Speed, bool bHoming);
+
+    UPROPERTY(Replicated)
+    int32 BoardId;
+
+private:
+    UPROPERTY(Replicated)
+    FUnitCombatStateArray UnitStates;
+
+    /** Server side: item index of every unit on the board. */
+    TMap<AUnitBase*, int32> ItemIndices;
+};
@@ -0,0 +1,197 @@
+// CombatReplay.cpp
+
+#include "CombatReplay.h"
+
+// ============================================================================
+// WRITER
+// ============================================================================
+
+FCombatReplayWriter::FCombatReplayWriter(FArchive& InArchive, const FCombatReplayHeader& InHeader)
+    : Ar(InArchive)
+    , Header(InHeader)
+    , StartOffset(InArchive.Tell())
+{
+    check(Ar.IsSaving());
+    Ar << Header;
+}
+
+void FCombatReplayWriter::BeginRecord(ECombatReplayRecord Type, int32 Tick)
+{
+    check(!bEnded && Tick >= LastTick);
+
+    uint32 TickDelta = (uint32)(Tick - LastTick);
+    LastTick = Tick;
+
+    Ar << Type;
+    Ar.SerializeIntPacked(TickDelta);
+}
+
+void FCombatReplayWriter::RecordAddUnit(int32 Tick, const FCombatUnitDesc& Desc)
+{
+    BeginRecord(ECombatReplayRecord::AddUnit, Tick);
+
+    FCombatUnitDesc Copy = Desc;
+    Ar << Copy;
+    ++NumUnits;
+}
+
+void FCombatReplayWriter::RecordSetState(int32 Tick, int32 UnitIndex, EUnitState State)
+{
+    check(UnitIndex >= 0 && UnitIndex < NumUnits);
+
+    BeginRecord(ECombatReplayRecord::SetState, Tick);
+
+    uint32 PackedIndex = (uint32)UnitIndex;
+    Ar.SerializeIntPacked(PackedIndex);
+    Ar << State;
+}
+
+void FCombatReplayWriter::RecordChecksum(int32 Tick, uint32 Checksum)
+{
+    BeginRecord(ECombatReplayRecord::Checksum, Tick);
+    Ar << Checksum;
+}
+
+void FCombatReplayWriter::RecordEnd(int32 Tick)
+{
+    BeginRecord(ECombatReplayRecord::End, Tick);
+    bEnded = true;
+}
+
+// ============================================================================
+// PLAYER
+// ============================================================================
+
+bool FCombatReplayPlayer::ReadHeader(FString& OutError)
+{
+    Ar << Header;
+
+    if (Ar.IsError() || Header.Magic != FCombatReplayHeader::ExpectedMagic)
+    {
+        OutError = TEXT("Not a combat replay");
+        return false;
+    }
+
+    if (Header.Version != FCombatReplayHeader::ExpectedVersion)
+    {
+        OutError = FString::Printf(TEXT("Replay version %u, expected %u"), Header.Version, FCombatReplayHeader::ExpectedVersion);
+        return false;
+    }
+
+    if (!(Header.FixedDeltaTime > 0.0f))
+    {
+        OutError = TEXT("Replay has no fixed step");
+        return false;
+    }
+
+    return true;
+}
+
+bool FCombatReplayPlayer::Play(FCombatSimulation& Simulation, FCombatReplayResult& OutResult, FString& OutError)
+{
+    if (Simulation.GetFixedDeltaTime() != Header.FixedDeltaTime)
+    {
+        OutError = FString::Printf(TEXT("Replay steps at %f s, simulation at %f s"), Header.FixedDeltaTime, Simulation.GetFixedDeltaTime());
+        return false;
+    }
+
+    Simulation.Reset();
+    OutResult = FCombatReplayResult();
+
+    int32 Tick = 0;
+    const int64 MaxTicks = (int64)FMath::Min(FMath::CeilToDouble(MaxReplaySeconds / Header.FixedDeltaTime), (double)MAX_int32);
+
+    // A log cut short (e.g. by a crash while recording) plays up to its last whole record
+    while (!Ar.AtEnd() && !Ar.IsError() && !OutResult.bReachedEnd)
+    {
+        ECombatReplayRecord Type;
+        uint32 TickDelta = 0;
+        Ar << Type;
+        Ar.SerializeIntPacked(TickDelta);
+
+        if (Ar.IsError())
+        {
+            break;
+        }
+
+        if ((int64)Tick + TickDelta > MaxTicks)
+        {
+            OutError = FString::Printf(TEXT("Tick %d: record %u ticks later is past the %lld tick limit"), Tick, TickDelta, MaxTicks);
+            return false;
+        }
+
+        Tick += (int32)TickDelta;
+        while (Simulation.GetTickCount() < Tick)
+        {
+            Simulation.Step();
+        }
+
+        switch (Type)
+        {
+        case ECombatReplayRecord::AddUnit:
+        {
+            FCombatUnitDesc Desc;
+            Ar << Desc;
+            if (!Ar.IsError())
+            {
+                Simulation.AddUnit(Desc);
+                ++OutResult.NumUnits;
+            }
+            break;
+        }
+
+        case ECombatReplayRecord::SetState:
+        {
+            uint32 UnitIndex = 0;
+            EUnitState State;
+            Ar.SerializeIntPacked(UnitIndex);
+            Ar << State;
+
+            if (Ar.IsError())
+            {
+                break;
+            }
+
+            if ((int32)UnitIndex >= Simulation.NumUnits())
+            {
+                OutError = FString::Printf(TEXT("Tick %d: state change for unknown unit %u"), Tick, UnitIndex);
+                return false;
+            }
+
+            Simulation.SetState((int32)UnitIndex, State);
+            ++OutResult.NumStateChanges;
+            break;
+        }
+
+        case ECombatReplayRecord::Checksum:
+        {
+            uint32 Checksum = 0;
+            Ar << Checksum;
+
+            if (Ar.IsError())
+            {
+                break;
+            }
+
+            ++OutResult.NumChecksums;
+            if (OutResult.FirstMismatchTick == INDEX_NONE && Checksum != Simulation.ComputeStateChecksum())
+            {
+                OutResult.FirstMismatchTick = Tick;
+            }
+            break;
+        }
+
+        case ECombatReplayRecord::End:
+            OutResult.bReachedEnd = true;
+            break;
+
+        default:
+            OutError = FString::Printf(TEXT("Tick %d: unknown record type %d"), Tick, (int32)Type);
+            return false;
+        }
+    }
+
+    OutResult.TicksPlayed = Simulation.GetTickCount();
+    OutResult.WinningTeam = Simulation.GetWinningTeam();
+    return true;
+}
@@ -0,0 +1,126 @@
+// CombatReplay.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatSimulation.h"
+
+// ============================================================================
+// REPLAY FORMAT
+// ============================================================================
+
+/**
+ * A replay is a header followed by an append-only stream of records, each a type byte,
+ * the packed tick delta since the previous record and a payload. Only inputs are logged:
+ * the units that join and state changes made from outside combat (bench, board, round
+ * start). Everything else is recomputed by FCombatSimulation, which is deterministic, so a
+ * whole round costs a few hundred bytes plus optional state checksums.
+ */
+enum class ECombatReplayRecord : uint8
+{
+    AddUnit,
+    SetState,
+    Checksum,
+    End,
+};
+
+struct FCombatReplayHeader
+{
+    static constexpr uint32 ExpectedMagic = 0x54465452; // 'TFTR'
+    static constexpr uint32 ExpectedVersion = 1;
+
+    uint32 Magic = ExpectedMagic;
+    uint32 Version = ExpectedVersion;
+    float FixedDeltaTime = FCombatSimulation::DefaultFixedDeltaTime;
+
+    /** Seed the round was generated from, for tools that reproduce their own randomness. */
+    uint32 Seed = 0;
+
+    /** Ticks between state checksums; 0 for none. */
+    int32 ChecksumInterval = 0;
+
+    friend FArchive& operator<<(FArchive& Ar, FCombatReplayHeader& Header)
+    {
+        return Ar << Header.Magic << Header.Version << Header.FixedDeltaTime << Header.Seed << Header.ChecksumInterval;
+    }
+};
+
+// ============================================================================
+// REPLAY WRITER
+// ============================================================================
+
+/** Streams replay records into an archive as they happen. Ticks must not go backwards. */
+class TFTUNREALDEMO_API FCombatReplayWriter
+{
+public:
+    /** Writes the header. The archive is not owned and must outlive the writer. */
+    FCombatReplayWriter(FArchive& InArchive, const FCombatReplayHeader& InHeader);
+
+    /** Units are numbered in the order they are added. */
+    void RecordAddUnit(int32 Tick, const FCombatUnitDesc& Desc);
+    void RecordSetState(int32 Tick, int32 UnitIndex, EUnitState State);
+    void RecordChecksum(int32 Tick, uint32 Checksum);
+
+    /** The player stops at Tick. Nothing may be recorded afterwards. */
+    void RecordEnd(int32 Tick);
+
+    bool WantsChecksum(int32 Tick) const { return Header.ChecksumInterval > 0 && Tick % Header.ChecksumInterval == 0; }
+
+    const FCombatReplayHeader& GetHeader() const { return Header; }
+    int32 GetNumUnits() const { return NumUnits; }
+    int64 GetBytesWritten() const { return Ar.Tell() - StartOffset; }
+
+private:
+    void BeginRecord(ECombatReplayRecord Type, int32 Tick);
+
+    FArchive& Ar;
+    FCombatReplayHeader Header;
+    int64 StartOffset;
+    int32 LastTick = 0;
+    int32 NumUnits = 0;
+    bool bEnded = false;
+};
+
+// ============================================================================
+// REPLAY PLAYER
+// ============================================================================
+
+struct FCombatReplayResult
+{
+    int32 TicksPlayed = 0;
+    int32 NumUnits = 0;
+    int32 NumStateChanges = 0;
+    int32 NumChecksums = 0;
+
+    /** First tick whose state differs from the recording, or INDEX_NONE. */
+    int32 FirstMismatchTick = INDEX_NONE;
+
+    /** False when the log stops without an End record, e.g. a recording cut short by a crash. */
+    bool bReachedEnd = false;
+
+    int32 WinningTeam = INDEX_NONE;
+};
+
+/** Feeds a replay log back into an FCombatSimulation as fast as the simulation steps. */
+class TFTUNREALDEMO_API FCombatReplayPlayer
+{
+public:
+    /** No round runs this long; a log claiming to is corrupt, and stepping to it would hang the player. */
+    static constexpr float MaxReplaySeconds = 3600.0f;
+
+    /** The archive is not owned and must outlive the player. */
+    explicit FCombatReplayPlayer(FArchive& InArchive) : Ar(InArchive) {}
+
+    bool ReadHeader(FString& OutError);
+    const FCombatReplayHeader& GetHeader() const { return Header; }
+
+    /**
+     * Resets Simulation, which must step at the header's FixedDeltaTime, and plays the
+     * rest of the log into it. Checksum records are compared against the replayed state.
+     * Fails without stepping if a record lies more than MaxReplaySeconds into the round.
+     */
+    bool Play(FCombatSimulation& Simulation, FCombatReplayResult& OutResult, FString& OutError);
+
+private:
+    FArchive& Ar;
+    FCombatReplayHeader Header;
+};
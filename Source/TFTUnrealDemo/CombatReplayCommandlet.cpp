@@ -0,0 +1,105 @@
+// CombatReplayCommandlet.cpp
+
+#include "CombatReplayCommandlet.h"
+#include "CombatReplay.h"
+#include "CombatEventLog.h"
+#include "TFTUnrealDemo.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Serialization/MemoryReader.h"
+#include "HAL/PlatformTime.h"
+
+UCombatReplayCommandlet::UCombatReplayCommandlet()
+{
+    IsClient = false;
+    IsEditor = false;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UCombatReplayCommandlet::Main(const FString& Params)
+{
+    FString ReplayPath;
+    if (!FParse::Value(*Params, TEXT("Replay="), ReplayPath))
+    {
+        UE_LOG(LogTFTCombat, Error, TEXT("Usage: -run=CombatReplay -Replay=<file.tftreplay> [-Repeat=N] [-Events=<file.bin>]"));
+        return 1;
+    }
+
+    TArray<uint8> ReplayData;
+    if (!FFileHelper::LoadFileToArray(ReplayData, *ReplayPath))
+    {
+        UE_LOG(LogTFTCombat, Error, TEXT("Could not read replay %s"), *ReplayPath);
+        return 1;
+    }
+
+    int32 NumRepeats = 1;
+    FParse::Value(*Params, TEXT("Repeat="), NumRepeats);
+    NumRepeats = FMath::Max(1, NumRepeats);
+
+    FString EventsPath;
+    const bool bWriteEvents = FParse::Value(*Params, TEXT("Events="), EventsPath);
+
+    FCombatEventLog EventLog;
+    FCombatReplayResult Result;
+    FCombatReplayHeader Header;
+    FString Error;
+    double PlaySeconds = 0.0;
+
+    for (int32 Repeat = 0; Repeat < NumRepeats; ++Repeat)
+    {
+        FMemoryReader Reader(ReplayData);
+        FCombatReplayPlayer Player(Reader);
+
+        if (!Player.ReadHeader(Error))
+        {
+            UE_LOG(LogTFTCombat, Error, TEXT("%s: %s"), *ReplayPath, *Error);
+            return 1;
+        }
+        Header = Player.GetHeader();
+
+        FCombatSimulation Simulation(Header.FixedDeltaTime);
+
+        // Only the last run is traced so repeats measure the bare simulation
+        if (bWriteEvents && Repeat == NumRepeats - 1)
+        {
+            Simulation.SetEventLog(&EventLog);
+        }
+
+        const double StartTime = FPlatformTime::Seconds();
+        if (!Player.Play(Simulation, Result, Error))
+        {
+            UE_LOG(LogTFTCombat, Error, TEXT("%s: %s"), *ReplayPath, *Error);
+            return 1;
+        }
+        PlaySeconds += FPlatformTime::Seconds() - StartTime;
+    }
+
+    // ========================================================================
+    // REPORT
+    // ========================================================================
+
+    const double TicksPerSecond = PlaySeconds > 0.0 ? (double)Result.TicksPlayed * NumRepeats / PlaySeconds : 0.0;
+
+    UE_LOG(LogTFTCombat, Display, TEXT("%s: %d bytes, seed %u, %d units, %d state changes"),
+        *ReplayPath, ReplayData.Num(), Header.Seed, Result.NumUnits, Result.NumStateChanges);
+
+    UE_LOG(LogTFTCombat, Display, TEXT("Played %d ticks (%.2f s of combat) %d times at %.0f ticks/s, winning team %d%s"),
+        Result.TicksPlayed, Result.TicksPlayed * Header.FixedDeltaTime, NumRepeats, TicksPerSecond, Result.WinningTeam,
+        Result.bReachedEnd ? TEXT("") : TEXT(" (log ends early)"));
+
+    if (bWriteEvents && !EventLog.SaveToFile(EventsPath))
+    {
+        UE_LOG(LogTFTCombat, Error, TEXT("Could not write %s"), *EventsPath);
+        return 1;
+    }
+
+    if (Result.FirstMismatchTick != INDEX_NONE)
+    {
+        UE_LOG(LogTFTCombat, Error, TEXT("State diverges from the recording at tick %d"), Result.FirstMismatchTick);
+        return 1;
+    }
+
+    UE_LOG(LogTFTCombat, Display, TEXT("%d of %d state checksums match"), Result.NumChecksums, Result.NumChecksums);
+    return 0;
+}
@@ -0,0 +1,30 @@
+// CombatReplayCommandlet.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "CombatReplayCommandlet.generated.h"
+
+// ============================================================================
+// COMBAT REPLAY COMMANDLET
+// ============================================================================
+
+/**
+ * Plays a combat replay headless through FCombatSimulation as fast as it steps and
+ * reports the outcome, the replay speed and whether the recorded state checksums match.
+ *
+ * UnrealEditor-Cmd TFTUnrealDemo -run=CombatReplay -Replay=<file.tftreplay> [-Repeat=1] [-Events=<file.bin>]
+ *
+ * -Repeat plays the log several times for a steadier ticks/s figure. -Events writes the
+ * replayed fight's FCombatEventLog. Returns non-zero when a checksum does not match.
+ */
+UCLASS()
+class UCombatReplayCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UCombatReplayCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
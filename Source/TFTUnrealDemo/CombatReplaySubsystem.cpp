@@ -0,0 +1,184 @@
+// CombatReplaySubsystem.cpp
+
+#include "CombatReplaySubsystem.h"
+#include "UnitRegistrySubsystem.h"
+#include "UnitBase.h"
+#include "TFTUnrealDemo.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+
+// ============================================================================
+// CONSOLE VARIABLES
+// ============================================================================
+
+static int32 GReplayFlushInterval = 60;
+static FAutoConsoleVariableRef CVarReplayFlushInterval(
+    TEXT("TFT.Replay.FlushInterval"),
+    GReplayFlushInterval,
+    TEXT("Ticks between flushes of a replay being recorded, so a crash loses at most this much. 0 flushes only when recording stops."));
+
+static FAutoConsoleCommandWithWorldAndArgs CmdReplayStart(
+    TEXT("TFT.Replay.Start"),
+    TEXT("Starts recording a combat replay to Saved/Replays/<name>."),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            if (UCombatReplaySubsystem* Replays = World ? World->GetSubsystem<UCombatReplaySubsystem>() : nullptr)
+            {
+                Replays->StartRecording(Args.Num() > 0 ? Args[0] : FString());
+            }
+        }));
+
+static FAutoConsoleCommandWithWorldAndArgs CmdReplayStop(
+    TEXT("TFT.Replay.Stop"),
+    TEXT("Stops the combat replay being recorded."),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            if (UCombatReplaySubsystem* Replays = World ? World->GetSubsystem<UCombatReplaySubsystem>() : nullptr)
+            {
+                Replays->StopRecording();
+            }
+        }));
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+void UCombatReplaySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    UnitRegistry = Collection.InitializeDependency<UUnitRegistrySubsystem>();
+}
+
+void UCombatReplaySubsystem::Deinitialize()
+{
+    StopRecording();
+    UnitRegistry = nullptr;
+
+    Super::Deinitialize();
+}
+
+TStatId UCombatReplaySubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatReplaySubsystem, STATGROUP_Tickables);
+}
+
+bool UCombatReplaySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+// ============================================================================
+// TICK
+// ============================================================================
+
+void UCombatReplaySubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (!Writer)
+    {
+        return;
+    }
+
+    ++Tick;
+
+    if (GReplayFlushInterval > 0 && Tick % GReplayFlushInterval == 0)
+    {
+        File->Flush();
+    }
+}
+
+// ============================================================================
+// RECORDING
+// ============================================================================
+
+bool UCombatReplaySubsystem::StartRecording(const FString& FileName)
+{
+    StopRecording();
+
+    FString Name = FileName.IsEmpty() ? FString::Printf(TEXT("Combat_%s"), *FDateTime::Now().ToString()) : FileName;
+    if (FPaths::GetExtension(Name).IsEmpty())
+    {
+        Name += TEXT(".tftreplay");
+    }
+
+    FilePath = FPaths::ProjectSavedDir() / TEXT("Replays") / Name;
+    File.Reset(IFileManager::Get().CreateFileWriter(*FilePath));
+
+    if (!File)
+    {
+        UE_LOG(LogTFTCombat, Error, TEXT("Could not create replay %s"), *FilePath);
+        return false;
+    }
+
+    // Live state is not the simulation's state, so there is nothing to checksum against
+    FCombatReplayHeader Header;
+    Header.ChecksumInterval = 0;
+    Writer = MakeUnique<FCombatReplayWriter>(*File, Header);
+    Tick = 0;
+
+    // Initial board, in handle order
+    const int32 NumHandles = UnitRegistry ? UnitRegistry->GetNumHandles() : 0;
+    for (int32 Handle = 0; Handle < NumHandles; ++Handle)
+    {
+        AUnitBase* Unit = UnitRegistry->GetUnit(Handle);
+        if (Unit && !Unit->IsInPool())
+        {
+            AddUnit(Unit, Unit->GetState());
+        }
+    }
+
+    UE_LOG(LogTFTCombat, Log, TEXT("⏺️ Recording combat replay to %s (%d units)"), *FilePath, UnitIndices.Num());
+    return true;
+}
+
+void UCombatReplaySubsystem::StopRecording()
+{
+    if (!Writer)
+    {
+        return;
+    }
+
+    Writer->RecordEnd(Tick);
+    const int64 BytesWritten = Writer->GetBytesWritten();
+
+    Writer.Reset();
+    File.Reset();
+    UnitIndices.Reset();
+
+    UE_LOG(LogTFTCombat, Log, TEXT("⏹️ Combat replay %s: %d ticks, %lld bytes"), *FilePath, Tick, BytesWritten);
+}
+
+int32 UCombatReplaySubsystem::AddUnit(AUnitBase* Unit, EUnitState InitialState)
+{
+    FCombatUnitDesc Desc;
+    Unit->GetCombatUnitDesc(Desc);
+    Desc.InitialState = InitialState;
+
+    const int32 UnitIndex = Writer->GetNumUnits();
+    Writer->RecordAddUnit(Tick, Desc);
+    UnitIndices.Add(Unit, UnitIndex);
+    return UnitIndex;
+}
+
+void UCombatReplaySubsystem::RecordStateChange(AUnitBase* Unit, EUnitState OldState, EUnitState NewState)
+{
+    if (!Writer || !Unit)
+    {
+        return;
+    }
+
+    const int32* FoundIndex = UnitIndices.Find(Unit);
+    const int32 UnitIndex = FoundIndex ? *FoundIndex : AddUnit(Unit, OldState);
+
+    Writer->RecordSetState(Tick, UnitIndex, NewState);
+}
+
+void UCombatReplaySubsystem::RemoveUnit(AUnitBase* Unit)
+{
+    UnitIndices.Remove(Unit);
+}
@@ -0,0 +1,74 @@
+// CombatReplaySubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatReplay.h"
+#include "CombatReplaySubsystem.generated.h"
+
+// Forward declarations
+class AUnitBase;
+class UUnitRegistrySubsystem;
+
+// ============================================================================
+// COMBAT REPLAY SUBSYSTEM
+// ============================================================================
+
+/**
+ * Records live rounds as combat replay logs under Saved/Replays. Recording starts with
+ * every unit in play; after that the log only grows when a unit changes state from
+ * outside combat (board manager, round reset, pool) or a new unit appears. One world
+ * tick is one replay tick.
+ * Replays re-run through FCombatSimulation (-run=CombatReplay), which follows the same
+ * FCombatRules as AUnitBase but at a fixed step, so they reproduce targeting and state
+ * bugs rather than the exact frame timing of the live round.
+ */
+UCLASS()
+class TFTUNREALDEMO_API UCombatReplaySubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // ========================================================================
+    // RECORDING
+    // ========================================================================
+
+    /** Starts a new log in Saved/Replays, ending any recording in progress. An empty name picks a timestamped one. */
+    UFUNCTION(BlueprintCallable, Category = "Replay")
+    bool StartRecording(const FString& FileName);
+
+    UFUNCTION(BlueprintCallable, Category = "Replay")
+    void StopRecording();
+
+    UFUNCTION(BlueprintPure, Category = "Replay")
+    bool IsRecording() const { return Writer.IsValid(); }
+
+    /** Called by AUnitBase::SetState. Units not yet in the log are added first, in their old state. */
+    void RecordStateChange(AUnitBase* Unit, EUnitState OldState, EUnitState NewState);
+
+    /** The unit left play; if it comes back it is logged as a new unit. */
+    void RemoveUnit(AUnitBase* Unit);
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    int32 AddUnit(AUnitBase* Unit, EUnitState InitialState);
+
+    UPROPERTY()
+    UUnitRegistrySubsystem* UnitRegistry;
+
+    TUniquePtr<FArchive> File;
+    TUniquePtr<FCombatReplayWriter> Writer;
+    FString FilePath;
+
+    /** Replay unit index of every unit in the log. */
+    TMap<AUnitBase*, int32> UnitIndices;
+
+    int32 Tick = 0;
+};
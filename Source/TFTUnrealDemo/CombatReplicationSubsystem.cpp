@@ -0,0 +1,235 @@
+// CombatReplicationSubsystem.cpp
+
+#include "CombatReplicationSubsystem.h"
+#include "CombatNetState.h"
+#include "UnitRegistrySubsystem.h"
+#include "UnitBase.h"
+#include "TFTUnrealDemo.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+// ============================================================================
+// CONSOLE VARIABLES
+// ============================================================================
+
+static float GNetUnitUpdateRate = 10.0f;
+static FAutoConsoleVariableRef CVarNetUnitUpdateRate(
+    TEXT("TFT.Net.UpdateRate"),
+    GNetUnitUpdateRate,
+    TEXT("Times per second unit combat state is captured and sent to clients."));
+
+static bool GNetLogBandwidth = false;
+static FAutoConsoleVariableRef CVarNetLogBandwidth(
+    TEXT("TFT.Net.LogBandwidth"),
+    GNetLogBandwidth,
+    TEXT("Log the board state bytes/sec of every board once a second."));
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+void UCombatReplicationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    UnitRegistry = Collection.InitializeDependency<UUnitRegistrySubsystem>();
+}
+
+void UCombatReplicationSubsystem::Deinitialize()
+{
+    BoardStates.Reset();
+    UnitBoards.Reset();
+    BoardStats.Reset();
+    LastBitsWritten.Reset();
+    UnitRegistry = nullptr;
+
+    Super::Deinitialize();
+}
+
+TStatId UCombatReplicationSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatReplicationSubsystem, STATGROUP_Tickables);
+}
+
+bool UCombatReplicationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UCombatReplicationSubsystem::IsServer() const
+{
+    const ENetMode NetMode = GetWorld()->GetNetMode();
+    return NetMode == NM_DedicatedServer || NetMode == NM_ListenServer;
+}
+
+// ============================================================================
+// TICK
+// ============================================================================
+
+void UCombatReplicationSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (!UnitRegistry || !IsServer())
+    {
+        return;
+    }
+
+    TimeSinceUpdate += DeltaTime;
+    if (TimeSinceUpdate >= 1.0f / FMath::Max(GNetUnitUpdateRate, 1.0f))
+    {
+        TimeSinceUpdate = 0.0f;
+        UpdateBoardStates();
+    }
+
+    TimeSinceReport += DeltaTime;
+    if (TimeSinceReport >= 1.0f)
+    {
+        UpdateBandwidthStats(TimeSinceReport);
+        TimeSinceReport = 0.0f;
+    }
+}
+
+void UCombatReplicationSubsystem::UpdateBoardStates()
+{
+    for (int32 Handle = 0; Handle < UnitRegistry->GetNumHandles(); ++Handle)
+    {
+        AUnitBase* Unit = UnitRegistry->GetUnit(Handle);
+        if (!Unit)
+        {
+            continue;
+        }
+
+        if (Unit->IsInPool())
+        {
+            RemoveUnit(Unit);
+            continue;
+        }
+
+        // Units moved to another board leave their old board's state first
+        const int32 BoardId = UUnitRegistrySubsystem::ClampBoardId(Unit->BoardId);
+        if (const int32* OldBoardId = UnitBoards.Find(Unit))
+        {
+            if (*OldBoardId != BoardId)
+            {
+                RemoveUnit(Unit);
+            }
+        }
+
+        if (ABoardCombatState* BoardState = GetBoardState(BoardId))
+        {
+            BoardState->UpdateUnit(Unit);
+            UnitBoards.Add(Unit, BoardId);
+        }
+    }
+}
+
+ABoardCombatState* UCombatReplicationSubsystem::GetBoardState(int32 BoardId)
+{
+    if (BoardStates.IsValidIndex(BoardId) && BoardStates[BoardId])
+    {
+        return BoardStates[BoardId];
+    }
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.ObjectFlags |= RF_Transient;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+    ABoardCombatState* BoardState = GetWorld()->SpawnActor<ABoardCombatState>(SpawnParams);
+    if (!BoardState)
+    {
+        return nullptr;
+    }
+
+    BoardState->BoardId = BoardId;
+    BoardState->SetNetUpdateFrequency(FMath::Max(GNetUnitUpdateRate, 1.0f));
+
+    if (BoardStates.Num() <= BoardId)
+    {
+        BoardStates.SetNumZeroed(BoardId + 1);
+    }
+    BoardStates[BoardId] = BoardState;
+
+    return BoardState;
+}
+
+ABoardCombatState* UCombatReplicationSubsystem::FindBoardState(const AUnitBase* Unit) const
+{
+    const int32* BoardId = UnitBoards.Find(Unit);
+    return BoardId ? BoardStates[*BoardId] : nullptr;
+}
+
+// ============================================================================
+// EVENTS
+// ============================================================================
+
+void UCombatReplicationSubsystem::NotifyUnitDied(AUnitBase* Unit)
+{
+    if (ABoardCombatState* BoardState = FindBoardState(Unit))
+    {
+        BoardState->MulticastUnitDied(Unit);
+    }
+}
+
+void UCombatReplicationSubsystem::NotifyAbilityCast(AUnitBase* Unit)
+{
+    if (ABoardCombatState* BoardState = FindBoardState(Unit))
+    {
+        BoardState->MulticastAbilityCast(Unit);
+    }
+}
+
+void UCombatReplicationSubsystem::NotifyProjectileLaunched(AUnitBase* Source, AUnitBase* Target, float Speed, bool bHoming)
+{
+    if (ABoardCombatState* BoardState = FindBoardState(Source))
+    {
+        BoardState->MulticastProjectileLaunched(Source->GetActorLocation(), Target, Speed, bHoming);
+    }
+}
+
+void UCombatReplicationSubsystem::RemoveUnit(AUnitBase* Unit)
+{
+    int32 BoardId = INDEX_NONE;
+    if (!UnitBoards.RemoveAndCopyValue(Unit, BoardId))
+    {
+        return;
+    }
+
+    if (ABoardCombatState* BoardState = BoardStates[BoardId])
+    {
+        BoardState->RemoveUnit(Unit);
+    }
+}
+
+// ============================================================================
+// STATS
+// ============================================================================
+
+void UCombatReplicationSubsystem::UpdateBandwidthStats(float ElapsedSeconds)
+{
+    BoardStats.Reset();
+    LastBitsWritten.SetNumZeroed(BoardStates.Num());
+
+    for (int32 BoardId = 0; BoardId < BoardStates.Num(); ++BoardId)
+    {
+        const ABoardCombatState* BoardState = BoardStates[BoardId];
+        if (!BoardState)
+        {
+            continue;
+        }
+
+        const int64 BitsWritten = BoardState->GetBitsWritten();
+
+        FBoardNetStats& Stats = BoardStats.AddDefaulted_GetRef();
+        Stats.BoardId = BoardId;
+        Stats.NumUnits = BoardState->NumUnits();
+        Stats.BytesPerSecond = (BitsWritten - LastBitsWritten[BoardId]) / 8.0f / ElapsedSeconds;
+
+        LastBitsWritten[BoardId] = BitsWritten;
+
+        if (GNetLogBandwidth)
+        {
+            UE_LOG(LogTFTCombat, Log, TEXT("📡 Board %d: %d units, %.0f bytes/sec"), Stats.BoardId, Stats.NumUnits, Stats.BytesPerSecond);
+        }
+    }
+}
@@ -0,0 +1,110 @@
+// CombatReplicationSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatReplicationSubsystem.generated.h"
+
+// Forward declarations
+class AUnitBase;
+class ABoardCombatState;
+class UUnitRegistrySubsystem;
+
+// ============================================================================
+// STRUCTS
+// ============================================================================
+
+/** Replication cost of one board over the last report interval. */
+USTRUCT(BlueprintType)
+struct FBoardNetStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Replication")
+    int32 BoardId = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Replication")
+    int32 NumUnits = 0;
+
+    /** Board state bytes sent per second, summed over every client connection. RPCs are not included. */
+    UPROPERTY(BlueprintReadOnly, Category = "Replication")
+    float BytesPerSecond = 0.0f;
+};
+
+// ============================================================================
+// COMBAT REPLICATION SUBSYSTEM
+// ============================================================================
+
+/**
+ * Server side of unit combat replication. Every TFT.Net.UpdateRate-th of a second the
+ * combat state of each unit in play is quantized into its board's ABoardCombatState,
+ * which clients render the fight from. Deaths and casts are forwarded as they happen.
+ * Movement still replicates through ACharacter. Does nothing in standalone games and
+ * on clients.
+ *
+ * Local test on one machine, a dedicated server plus headless clients:
+ *   TFTUnrealDemoServer <Map> -log -port=7777
+ *   TFTUnrealDemo 127.0.0.1:7777 -nullrhi -nosound -log      (once per client)
+ * With TFT.Net.LogBandwidth 1 the server logs bytes/sec per board every second; the
+ * totals including RPCs and packet overhead come from Network Insights (-NetTrace=1 -trace=net).
+ */
+UCLASS()
+class TFTUNREALDEMO_API UCombatReplicationSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // ========================================================================
+    // EVENTS
+    // ========================================================================
+
+    /** Called by AUnitBase::Die on the server. */
+    void NotifyUnitDied(AUnitBase* Unit);
+
+    /** Called by AUnitBase::CastAbility on the server. */
+    void NotifyAbilityCast(AUnitBase* Unit);
+
+    /** Called by UProjectileSubsystem on the server, so clients can draw the flight. */
+    void NotifyProjectileLaunched(AUnitBase* Source, AUnitBase* Target, float Speed, bool bHoming);
+
+    /** The unit left play; its item is dropped from the board state. */
+    void RemoveUnit(AUnitBase* Unit);
+
+    // ========================================================================
+    // STATS
+    // ========================================================================
+
+    UFUNCTION(BlueprintPure, Category = "Replication")
+    TArray<FBoardNetStats> GetBoardNetStats() const { return BoardStats; }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    bool IsServer() const;
+    ABoardCombatState* GetBoardState(int32 BoardId);
+    ABoardCombatState* FindBoardState(const AUnitBase* Unit) const;
+    void UpdateBoardStates();
+    void UpdateBandwidthStats(float ElapsedSeconds);
+
+    UPROPERTY()
+    UUnitRegistrySubsystem* UnitRegistry;
+
+    /** Indexed by board id; spawned the first time a unit shows up on the board. */
+    UPROPERTY()
+    TArray<ABoardCombatState*> BoardStates;
+
+    /** Board each replicated unit's item lives on. */
+    TMap<AUnitBase*, int32> UnitBoards;
+
+    TArray<FBoardNetStats> BoardStats;
+    TArray<int64> LastBitsWritten;
+
+    float TimeSinceUpdate = 0.0f;
+    float TimeSinceReport = 0.0f;
+};
@@ -0,0 +1,44 @@
+// CombatRules.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatTypes.h"
+
+// ============================================================================
+// COMBAT RULES
+// ============================================================================
+
+/**
+ * Combat constants and formulas shared by AUnitBase and the headless FCombatSimulation.
+ * Anything that changes fight outcomes belongs here so both paths stay identical.
+ */
+struct FCombatRules
+{
+    static constexpr float ManaPerAttack = 10.0f;
+    static constexpr float ManaPerHitTaken = 1.0f;
+
+    static constexpr float AbilityCastDuration = 1.5f;
+    static constexpr float PlayerHideDelay = 1.5f;
+    static constexpr float EnemyDestroyDelay = 2.0f;
+
+    static FORCEINLINE float CalculateDamageReduction(float IncomingDamage, EDamageType DamageType, float Armor, float MagicResist)
+    {
+        switch (DamageType)
+        {
+        case EDamageType::Physical:
+            return IncomingDamage * (100.0f / (100.0f + Armor));
+
+        case EDamageType::Magical:
+            return IncomingDamage * (100.0f / (100.0f + MagicResist));
+
+        case EDamageType::TrueDamage:
+        default:
+            return IncomingDamage;
+        }
+    }
+
+    static FORCEINLINE float GetAttackInterval(float AttackSpeed)
+    {
+        return 1.0f / AttackSpeed;
+    }
+};
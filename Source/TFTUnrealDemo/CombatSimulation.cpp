@@ -0,0 +1,753 @@
+// CombatSimulation.cpp
+
+#include "CombatSimulation.h"
+#include "CombatRules.h"
+#include "CombatSnapshot.h"
+#include "CombatReplay.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+
+// ============================================================================
+// CONSTRUCTOR
+// ============================================================================
+
+FCombatSimulation::FCombatSimulation(float InFixedDeltaTime)
+    : FixedDeltaTime(InFixedDeltaTime)
+    , TickCount(0)
+{
+    check(FixedDeltaTime > 0.0f);
+}
+
+// ============================================================================
+// SETUP
+// ============================================================================
+
+int32 FCombatSimulation::AddUnit(const FCombatUnitDesc& Desc)
+{
+    if (ReplayWriter)
+    {
+        ReplayWriter->RecordAddUnit(TickCount, Desc);
+    }
+
+    const int32 UnitIndex = Units.AddDefaulted();
+    verify(Stats.Allocate() == UnitIndex);
+
+    FCombatUnit& Unit = Units[UnitIndex];
+    Unit.Desc = Desc;
+    Unit.Position = Desc.Position;
+
+    if (FHexBoard::IsValidCell(Desc.Cell))
+    {
+        checkf(!(OccupiedCells & FHexBoard::GetCellBit(Desc.Cell)), TEXT("Board cell %d already holds a unit"), Desc.Cell);
+
+        Unit.Cell = Desc.Cell;
+        Unit.Position = FHexBoard::GetCellCenter(Desc.Cell);
+        OccupiedCells |= FHexBoard::GetCellBit(Desc.Cell);
+    }
+
+    Stats.CurrentHealth[UnitIndex] = Desc.MaxHealth;
+    Stats.Armor[UnitIndex] = Desc.Armor;
+    Stats.MagicResist[UnitIndex] = Desc.MagicResist;
+    Stats.AttackSpeed[UnitIndex] = Desc.AttackSpeed;
+    Stats.AttackDamage[UnitIndex] = Desc.AttackDamage;
+    Stats.AttackRange[UnitIndex] = Desc.AttackRange;
+
+    const FIntPoint Cell = SpatialHash.GetCell(ToHashLocation(Unit.Position));
+    UnitCells.Add(Cell);
+    SpatialHash.Add(UnitIndex, (int32)Desc.Team, Cell);
+
+    ApplyState(UnitIndex, Desc.InitialState);
+    return UnitIndex;
+}
+
+void FCombatSimulation::Reset()
+{
+    Units.Reset();
+    Stats.Reset();
+    UnitCells.Reset();
+    SpatialHash.Reset();
+    DamageQueue.Reset();
+    Clock.Reset();
+    OccupiedCells = 0;
+    TickCount = 0;
+}
+
+// ============================================================================
+// SIMULATION
+// ============================================================================
+
+void FCombatSimulation::Step()
+{
+    // Batched cooldowns and range checks. Positions only change in the movement
+    // pass and a unit only retargets inside its own Think, so the range results
+    // stay valid for the whole think pass.
+    Stats.DecrementCooldowns(FixedDeltaTime);
+    ComputeTargetRanges();
+
+    // Actor tick: think for every unit in index order
+    for (int32 UnitIndex = 0; UnitIndex < Units.Num(); ++UnitIndex)
+    {
+        TickUnit(UnitIndex, TargetInRange[UnitIndex] > 0.0f);
+    }
+
+    // Every hit of the step lands together
+    ResolveDamage();
+
+    // Movement component tick
+    for (int32 UnitIndex = 0; UnitIndex < Units.Num(); ++UnitIndex)
+    {
+        IntegrateMovement(UnitIndex);
+    }
+
+    // Combat clock tick
+    AdvanceClock();
+
+    ++TickCount;
+
+    if (ReplayWriter && ReplayWriter->WantsChecksum(TickCount))
+    {
+        ReplayWriter->RecordChecksum(TickCount, ComputeStateChecksum());
+    }
+}
+
+int32 FCombatSimulation::RunToCompletion(int32 MaxSteps)
+{
+    int32 StepsRun = 0;
+
+    while (StepsRun < MaxSteps && !IsFinished())
+    {
+        Step();
+        ++StepsRun;
+    }
+
+    return StepsRun;
+}
+
+bool FCombatSimulation::IsFinished() const
+{
+    uint8 TeamsInCombat = 0;
+
+    for (const FCombatUnit& Unit : Units)
+    {
+        if (Unit.bIsAlive && Unit.State == EUnitState::Combat)
+        {
+            TeamsInCombat |= 1 << (uint8)Unit.Desc.Team;
+        }
+    }
+
+    return FMath::CountBits(TeamsInCombat) < 2;
+}
+
+int32 FCombatSimulation::GetWinningTeam() const
+{
+    int32 WinningTeam = INDEX_NONE;
+
+    for (const FCombatUnit& Unit : Units)
+    {
+        if (!Unit.bIsAlive || Unit.State != EUnitState::Combat)
+        {
+            continue;
+        }
+
+        if (WinningTeam != INDEX_NONE && WinningTeam != (int32)Unit.Desc.Team)
+        {
+            return INDEX_NONE;
+        }
+
+        WinningTeam = (int32)Unit.Desc.Team;
+    }
+
+    return WinningTeam;
+}
+
+void FCombatSimulation::TickUnit(int32 UnitIndex, bool bTargetInRange)
+{
+    const FCombatUnit& Unit = Units[UnitIndex];
+
+    // Only think during combat
+    if (!Unit.bIsAlive || Unit.State != EUnitState::Combat || Unit.bIsCastingAbility)
+    {
+        return;
+    }
+
+    ThinkInternal(UnitIndex, bTargetInRange);
+}
+
+void FCombatSimulation::ComputeTargetRanges()
+{
+    const int32 NumPadded = Stats.NumPadded();
+    TargetDistanceSq.SetNumUninitialized(NumPadded, EAllowShrinking::No);
+    TargetInRange.SetNumUninitialized(NumPadded, EAllowShrinking::No);
+
+    for (int32 UnitIndex = 0; UnitIndex < NumPadded; ++UnitIndex)
+    {
+        const int32 Target = UnitIndex < Units.Num() ? Units[UnitIndex].Target : INDEX_NONE;
+        if (!Units.IsValidIndex(Target))
+        {
+            TargetDistanceSq[UnitIndex] = TNumericLimits<float>::Max();
+        }
+        else if (Units[UnitIndex].Cell != INDEX_NONE && Units[Target].Cell != INDEX_NONE)
+        {
+            // Board pairs already have their answer in the hex tables
+            TargetDistanceSq[UnitIndex] = FHexBoard::IsInRange(Units[UnitIndex].Cell, Units[Target].Cell, Units[UnitIndex].Desc.AttackRangeHexes)
+                ? 0.0f : TNumericLimits<float>::Max();
+        }
+        else
+        {
+            TargetDistanceSq[UnitIndex] = FVector2f::DistSquared(Units[UnitIndex].Position, Units[Target].Position);
+        }
+    }
+
+    Stats.ComputeInRange(TargetDistanceSq.GetData(), TargetInRange.GetData());
+}
+
+void FCombatSimulation::ResolveDamage()
+{
+    DamageQueue.Resolve(Stats, [this](const FQueuedDamage& Hit)
+        {
+            // The target may have died to an earlier hit this step
+            if (Units[Hit.Target].bIsAlive)
+            {
+                RecordEvent(ECombatEventType::Damage, Hit.Source, Hit.Target, Hit.FinalDamage, (uint8)Hit.Type);
+                if (Units.IsValidIndex(Hit.Source))
+                {
+                    Units[Hit.Source].DamageDealt += Hit.FinalDamage;
+                }
+                ApplyReducedDamage(Hit.Target, Hit.FinalDamage);
+            }
+        });
+}
+
+void FCombatSimulation::UpdateCooldownMask(int32 UnitIndex)
+{
+    const FCombatUnit& Unit = Units[UnitIndex];
+    const bool bTicking = Unit.bIsAlive && Unit.State == EUnitState::Combat && !Unit.bIsCastingAbility;
+    Stats.CooldownMask[UnitIndex] = bTicking ? 1.0f : 0.0f;
+}
+
+void FCombatSimulation::AdvanceClock()
+{
+    Clock.Advance(FixedDeltaTime, [this](int32 UnitIndex, ECombatClockEvent Type)
+        {
+            HandleClockEvent(UnitIndex, Type);
+        });
+}
+
+void FCombatSimulation::HandleClockEvent(int32 UnitIndex, ECombatClockEvent Type)
+{
+    // Hiding and releasing dead units only matter for actors
+    if (Type != ECombatClockEvent::CastEnd)
+    {
+        return;
+    }
+
+    Units[UnitIndex].bIsCastingAbility = false;
+    UpdateCooldownMask(UnitIndex);
+    RecordEvent(ECombatEventType::CastFinished, UnitIndex, INDEX_NONE);
+}
+
+// ============================================================================
+// AI
+// ============================================================================
+
+void FCombatSimulation::Think(int32 UnitIndex)
+{
+    ThinkInternal(UnitIndex, IsTargetInRange(UnitIndex));
+}
+
+bool FCombatSimulation::IsTargetInRange(int32 UnitIndex) const
+{
+    const FCombatUnit& Unit = Units[UnitIndex];
+    if (!Units.IsValidIndex(Unit.Target))
+    {
+        return false;
+    }
+
+    const FCombatUnit& Target = Units[Unit.Target];
+    if (Unit.Cell != INDEX_NONE && Target.Cell != INDEX_NONE)
+    {
+        return FHexBoard::IsInRange(Unit.Cell, Target.Cell, Unit.Desc.AttackRangeHexes);
+    }
+
+    return FVector2f::DistSquared(Unit.Position, Target.Position) <= FMath::Square(Stats.AttackRange[UnitIndex]);
+}
+
+void FCombatSimulation::ThinkInternal(int32 UnitIndex, bool bTargetInRange)
+{
+    const FCombatUnit& Unit = Units[UnitIndex];
+
+    if (Stats.CurrentHealth[UnitIndex] <= 0.0f)
+    {
+        return;
+    }
+
+    const FCombatUnit* Target = Units.IsValidIndex(Unit.Target) ? &Units[Unit.Target] : nullptr;
+    if (!Target || !Target->bIsAlive || Target->State == EUnitState::Bench)
+    {
+        FindNewTarget(UnitIndex);
+        return;
+    }
+
+    if (!bTargetInRange)
+    {
+        MoveToTarget(UnitIndex);
+        return;
+    }
+
+    StopMovement(UnitIndex);
+
+    if (Stats.CurrentMana[UnitIndex] >= Unit.Desc.MaxMana)
+    {
+        CastAbility(UnitIndex);
+    }
+
+    if (Stats.AttackCooldown[UnitIndex] <= 0.0f && Unit.bCanAttack)
+    {
+        AttemptAutoAttack(UnitIndex);
+    }
+}
+
+void FCombatSimulation::FindNewTarget(int32 UnitIndex)
+{
+    FCombatUnit& Unit = Units[UnitIndex];
+    Unit.Target = GetNearestEnemy(UnitIndex);
+
+    if (Unit.Target != INDEX_NONE)
+    {
+        RecordEvent(ECombatEventType::TargetAcquired, UnitIndex, Unit.Target);
+        Stats.AttackCooldown[UnitIndex] = 0.0f;
+    }
+    else
+    {
+        RecordEvent(ECombatEventType::TargetNotFound, UnitIndex, INDEX_NONE);
+    }
+}
+
+int32 FCombatSimulation::GetNearestEnemy(int32 UnitIndex) const
+{
+    const FCombatUnit& Unit = Units[UnitIndex];
+    const FVector2f Origin = Unit.Position;
+
+    return SpatialHash.FindNearest(ToHashLocation(Origin), (int32)Unit.Desc.Team,
+        [this, UnitIndex, &Origin](int32 Candidate, double& OutDistanceSq)
+        {
+            const FCombatUnit& Other = Units[Candidate];
+
+            if (Candidate == UnitIndex) return false;
+            if (!Other.bIsAlive) return false;
+            if (Other.State != EUnitState::Combat) return false;
+
+            OutDistanceSq = FVector2f::DistSquared(Origin, Other.Position);
+            return true;
+        });
+}
+
+// ============================================================================
+// COMBAT
+// ============================================================================
+
+void FCombatSimulation::AttemptAutoAttack(int32 UnitIndex)
+{
+    const FCombatUnit& Unit = Units[UnitIndex];
+
+    if (!Units.IsValidIndex(Unit.Target) || !Units[Unit.Target].bIsAlive)
+    {
+        return;
+    }
+
+    if (Units[Unit.Target].State == EUnitState::Bench)
+    {
+        return;
+    }
+
+    RecordEvent(ECombatEventType::Attack, UnitIndex, Unit.Target, Stats.AttackDamage[UnitIndex]);
+    DealDamage(UnitIndex, Unit.Target, Stats.AttackDamage[UnitIndex], EDamageType::Physical);
+    GainMana(UnitIndex, FCombatRules::ManaPerAttack);
+    Stats.AttackCooldown[UnitIndex] = FCombatRules::GetAttackInterval(Stats.AttackSpeed[UnitIndex]);
+}
+
+void FCombatSimulation::DealDamage(int32 SourceIndex, int32 TargetIndex, float Damage, EDamageType DamageType)
+{
+    if (!Units.IsValidIndex(TargetIndex) || !Units[TargetIndex].bIsAlive)
+    {
+        return;
+    }
+
+    DamageQueue.Push(SourceIndex, TargetIndex, Damage, DamageType);
+}
+
+void FCombatSimulation::TakeDamage(int32 UnitIndex, float Amount, EDamageType DamageType)
+{
+    ApplyReducedDamage(UnitIndex, FCombatRules::CalculateDamageReduction(Amount, DamageType,
+        Stats.Armor[UnitIndex], Stats.MagicResist[UnitIndex]));
+}
+
+void FCombatSimulation::ApplyReducedDamage(int32 UnitIndex, float FinalDamage)
+{
+    if (Units[UnitIndex].State == EUnitState::Bench)
+    {
+        return;
+    }
+
+    Stats.CurrentHealth[UnitIndex] -= FinalDamage;
+
+    if (FinalDamage > 0.0f)
+    {
+        GainMana(UnitIndex, FCombatRules::ManaPerHitTaken);
+    }
+
+    if (Stats.CurrentHealth[UnitIndex] <= 0.0f)
+    {
+        Die(UnitIndex);
+    }
+}
+
+void FCombatSimulation::GainMana(int32 UnitIndex, float Amount)
+{
+    Stats.CurrentMana[UnitIndex] += Amount;
+
+    if (Stats.CurrentMana[UnitIndex] >= Units[UnitIndex].Desc.MaxMana)
+    {
+        CastAbility(UnitIndex);
+        Stats.CurrentMana[UnitIndex] = 0.0f;
+    }
+}
+
+void FCombatSimulation::CastAbility(int32 UnitIndex)
+{
+    FCombatUnit& Unit = Units[UnitIndex];
+
+    if (Unit.bIsCastingAbility)
+    {
+        return;
+    }
+
+    Unit.bIsCastingAbility = true;
+    Clock.Schedule(UnitIndex, ECombatClockEvent::CastEnd, FCombatRules::AbilityCastDuration);
+    UpdateCooldownMask(UnitIndex);
+    RecordEvent(ECombatEventType::CastStarted, UnitIndex, Unit.Target);
+}
+
+void FCombatSimulation::Die(int32 UnitIndex)
+{
+    FCombatUnit& Unit = Units[UnitIndex];
+
+    if (!Unit.bIsAlive)
+    {
+        return;
+    }
+
+    Unit.bIsAlive = false;
+    UpdateCooldownMask(UnitIndex);
+    RecordEvent(ECombatEventType::Death, UnitIndex, INDEX_NONE);
+    SpatialHash.Remove(UnitIndex, (int32)Unit.Desc.Team, UnitCells[UnitIndex]);
+    StopMovement(UnitIndex);
+
+    if (Unit.Cell != INDEX_NONE)
+    {
+        OccupiedCells &= ~FHexBoard::GetCellBit(Unit.Cell);
+    }
+
+    if (Unit.NextCell != INDEX_NONE)
+    {
+        OccupiedCells &= ~FHexBoard::GetCellBit(Unit.NextCell);
+    }
+    Unit.Target = INDEX_NONE;
+}
+
+// ============================================================================
+// MOVEMENT
+// ============================================================================
+
+void FCombatSimulation::MoveToTarget(int32 UnitIndex)
+{
+    FCombatUnit& Unit = Units[UnitIndex];
+
+    if (!Unit.bCanMove || Unit.Target == INDEX_NONE)
+    {
+        return;
+    }
+
+    Unit.bIsMoving = true;
+}
+
+void FCombatSimulation::StopMovement(int32 UnitIndex)
+{
+    Units[UnitIndex].bIsMoving = false;
+}
+
+void FCombatSimulation::IntegrateMovement(int32 UnitIndex)
+{
+    FCombatUnit& Unit = Units[UnitIndex];
+
+    if (Unit.Cell != INDEX_NONE)
+    {
+        IntegrateHexMovement(UnitIndex);
+        return;
+    }
+
+    if (!Unit.bIsMoving || !Unit.bIsAlive || !Units.IsValidIndex(Unit.Target))
+    {
+        return;
+    }
+
+    const FVector2f ToTarget = Units[Unit.Target].Position - Unit.Position;
+    const float Distance = ToTarget.Size();
+    const float Travel = FMath::Min(Unit.Desc.MovementSpeed * FixedDeltaTime, Distance - Unit.Desc.StoppingDistance);
+
+    if (Travel <= 0.0f)
+    {
+        return;
+    }
+
+    Unit.Position += ToTarget * (Travel / Distance);
+    SyncHashCell(UnitIndex);
+}
+
+void FCombatSimulation::IntegrateHexMovement(int32 UnitIndex)
+{
+    FCombatUnit& Unit = Units[UnitIndex];
+
+    if (!Unit.bIsAlive)
+    {
+        return;
+    }
+
+    // A step in progress always finishes, so units never stop between cells
+    if (Unit.NextCell == INDEX_NONE)
+    {
+        if (!Unit.bIsMoving || !Units.IsValidIndex(Unit.Target) || Units[Unit.Target].Cell == INDEX_NONE)
+        {
+            return;
+        }
+
+        Unit.NextCell = FHexBoard::GetStepTowards(Unit.Cell, Units[Unit.Target].Cell, OccupiedCells);
+        if (Unit.NextCell == INDEX_NONE)
+        {
+            return;
+        }
+
+        OccupiedCells |= FHexBoard::GetCellBit(Unit.NextCell);
+    }
+
+    const FVector2f NextCellCenter = FHexBoard::GetCellCenter(Unit.NextCell);
+    const FVector2f ToNextCell = NextCellCenter - Unit.Position;
+    const float Distance = ToNextCell.Size();
+    const float Travel = Unit.Desc.MovementSpeed * FixedDeltaTime;
+
+    if (Travel >= Distance)
+    {
+        OccupiedCells &= ~FHexBoard::GetCellBit(Unit.Cell);
+        Unit.Position = NextCellCenter;
+        Unit.Cell = Unit.NextCell;
+        Unit.NextCell = INDEX_NONE;
+    }
+    else
+    {
+        Unit.Position += ToNextCell * (Travel / Distance);
+    }
+
+    SyncHashCell(UnitIndex);
+}
+
+void FCombatSimulation::SyncHashCell(int32 UnitIndex)
+{
+    const FIntPoint NewCell = SpatialHash.GetCell(ToHashLocation(Units[UnitIndex].Position));
+    SpatialHash.Move(UnitIndex, (int32)Units[UnitIndex].Desc.Team, UnitCells[UnitIndex], NewCell);
+    UnitCells[UnitIndex] = NewCell;
+}
+
+// ============================================================================
+// STATE MANAGEMENT
+// ============================================================================
+
+void FCombatSimulation::SetState(int32 UnitIndex, EUnitState NewState)
+{
+    // Only calls from outside are replay inputs; AddUnit's own state change replays with the unit
+    if (ReplayWriter && Units[UnitIndex].State != NewState)
+    {
+        ReplayWriter->RecordSetState(TickCount, UnitIndex, NewState);
+    }
+
+    ApplyState(UnitIndex, NewState);
+}
+
+void FCombatSimulation::ApplyState(int32 UnitIndex, EUnitState NewState)
+{
+    FCombatUnit& Unit = Units[UnitIndex];
+
+    if (Unit.State == NewState)
+    {
+        return;
+    }
+
+    Unit.State = NewState;
+    UpdateCooldownMask(UnitIndex);
+
+    switch (NewState)
+    {
+    case EUnitState::Bench:
+        Unit.Target = INDEX_NONE;
+        Unit.bCanMove = false;
+        Unit.bCanAttack = false;
+        StopMovement(UnitIndex);
+        break;
+
+    case EUnitState::BoardIdle:
+        Unit.bCanMove = true;
+        Unit.bCanAttack = true;
+        Stats.AttackCooldown[UnitIndex] = 0.0f;
+        break;
+
+    case EUnitState::Combat:
+        Unit.Target = GetNearestEnemy(UnitIndex);
+        Stats.AttackCooldown[UnitIndex] = 0.0f;
+        Unit.bCanMove = true;
+        Unit.bCanAttack = true;
+        break;
+    }
+}
+
+// ============================================================================
+// SNAPSHOTS
+// ============================================================================
+
+FArchive& operator<<(FArchive& Ar, FCombatUnitDesc& Desc)
+{
+    Ar << Desc.Team << Desc.InitialState << Desc.Position << Desc.Cell;
+    Ar << Desc.MaxHealth << Desc.AttackDamage << Desc.AttackSpeed << Desc.AttackRange << Desc.AttackRangeHexes;
+    Ar << Desc.Armor << Desc.MagicResist << Desc.MaxMana << Desc.MovementSpeed << Desc.StoppingDistance;
+    return Ar;
+}
+
+namespace CombatSimulationPrivate
+{
+    constexpr uint32 SnapshotMagic = 0x54465353; // 'TFSS'
+    constexpr uint32 SnapshotVersion = 1;
+
+    enum ESnapshotUnitFlags : uint8
+    {
+        Alive = 1 << 0,
+        CanMove = 1 << 1,
+        CanAttack = 1 << 2,
+        CastingAbility = 1 << 3,
+        Moving = 1 << 4,
+    };
+
+    // Field by field rather than a raw copy: struct padding would make equal states serialize differently
+    void SerializeUnit(FArchive& Ar, FCombatUnit& Unit)
+    {
+        Ar << Unit.Desc;
+        Ar << Unit.Position << Unit.State << Unit.Cell << Unit.NextCell << Unit.Target << Unit.DamageDealt;
+
+        uint8 Flags = (Unit.bIsAlive ? Alive : 0)
+            | (Unit.bCanMove ? CanMove : 0)
+            | (Unit.bCanAttack ? CanAttack : 0)
+            | (Unit.bIsCastingAbility ? CastingAbility : 0)
+            | (Unit.bIsMoving ? Moving : 0);
+        Ar << Flags;
+
+        Unit.bIsAlive = (Flags & Alive) != 0;
+        Unit.bCanMove = (Flags & CanMove) != 0;
+        Unit.bCanAttack = (Flags & CanAttack) != 0;
+        Unit.bIsCastingAbility = (Flags & CastingAbility) != 0;
+        Unit.bIsMoving = (Flags & Moving) != 0;
+    }
+}
+
+void FCombatSimulation::SaveSnapshot(TArray<uint8>& OutSnapshot) const
+{
+    OutSnapshot.Reset();
+    FMemoryWriter Writer(OutSnapshot);
+
+    // Saving leaves the state untouched; the shared serializer just is not const
+    const_cast<FCombatSimulation*>(this)->SerializeState(Writer);
+}
+
+uint32 FCombatSimulation::ComputeStateChecksum() const
+{
+    TArray<uint8> Snapshot;
+    SaveSnapshot(Snapshot);
+    return FCrc::MemCrc32(Snapshot.GetData(), Snapshot.Num());
+}
+
+bool FCombatSimulation::RestoreSnapshot(TConstArrayView<uint8> Snapshot)
+{
+    // Load into a scratch simulation first so a bad snapshot cannot leave this one half restored
+    FCombatSimulation Restored(FixedDeltaTime);
+
+    FMemoryReaderView Reader(MakeArrayView(Snapshot));
+    Restored.SerializeState(Reader);
+
+    if (Reader.IsError() || Reader.Tell() != Snapshot.Num())
+    {
+        return false;
+    }
+
+    Units = MoveTemp(Restored.Units);
+    Stats = MoveTemp(Restored.Stats);
+    UnitCells = MoveTemp(Restored.UnitCells);
+    Clock = MoveTemp(Restored.Clock);
+    OccupiedCells = Restored.OccupiedCells;
+    TickCount = Restored.TickCount;
+
+    // The hash holds exactly the living units. Queries break ties by index, so
+    // rebuilding it in index order answers the same as the hash that was saved.
+    SpatialHash.Reset();
+    for (int32 UnitIndex = 0; UnitIndex < Units.Num(); ++UnitIndex)
+    {
+        if (Units[UnitIndex].bIsAlive)
+        {
+            SpatialHash.Add(UnitIndex, (int32)Units[UnitIndex].Desc.Team, UnitCells[UnitIndex]);
+        }
+    }
+
+    // Damage is always resolved within the step that queued it
+    DamageQueue.Reset();
+    return true;
+}
+
+void FCombatSimulation::SerializeState(FArchive& Ar)
+{
+    using namespace CombatSimulationPrivate;
+
+    uint32 Magic = SnapshotMagic;
+    uint32 Version = SnapshotVersion;
+    Ar << Magic << Version;
+
+    if (Magic != SnapshotMagic || Version != SnapshotVersion)
+    {
+        Ar.SetError();
+        return;
+    }
+
+    Ar << TickCount;
+    Ar << OccupiedCells;
+
+    int32 NumSavedUnits = Units.Num();
+    Ar << NumSavedUnits;
+
+    if (Ar.IsLoading())
+    {
+        if (NumSavedUnits < 0 || NumSavedUnits > Ar.TotalSize() - Ar.Tell())
+        {
+            Ar.SetError();
+            return;
+        }
+        Units.SetNum(NumSavedUnits);
+    }
+
+    for (FCombatUnit& Unit : Units)
+    {
+        SerializeUnit(Ar, Unit);
+    }
+
+    CombatSnapshot::SerializeRawArray(Ar, UnitCells);
+    Stats.Serialize(Ar);
+    Clock.Serialize(Ar);
+
+    if (Ar.IsLoading() && (UnitCells.Num() != Units.Num() || Stats.NumPadded() < Units.Num()))
+    {
+        Ar.SetError();
+    }
+}
@@ -0,0 +1,231 @@
+// CombatSimulation.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatTypes.h"
+#include "HexBoard.h"
+#include "UnitSpatialHash.h"
+#include "UnitStatStore.h"
+#include "DamageQueue.h"
+#include "CombatClock.h"
+#include "CombatEventLog.h"
+
+// Forward declarations
+class FCombatReplayWriter;
+
+// ============================================================================
+// UNIT RECORDS
+// ============================================================================
+
+/** Authoring stats for a simulated unit. Defaults match AUnitBase. */
+struct FCombatUnitDesc
+{
+    ETeam Team = ETeam::Player;
+    EUnitState InitialState = EUnitState::Combat;
+    FVector2f Position = FVector2f::ZeroVector;
+
+    /** Starting FHexBoard cell. When set the unit walks hex to hex and Position is ignored. */
+    int32 Cell = INDEX_NONE;
+
+    float MaxHealth = 100.0f;
+    float AttackDamage = 10.0f;
+    float AttackSpeed = 1.0f;
+    float AttackRange = 150.0f;
+    int32 AttackRangeHexes = 1;
+    float Armor = 0.0f;
+    float MagicResist = 0.0f;
+    float MaxMana = 50.0f;
+    float MovementSpeed = 300.0f;
+    float StoppingDistance = 50.0f;
+};
+
+/** Field by field, shared by snapshots and replay logs. */
+TFTUNREALDEMO_API FArchive& operator<<(FArchive& Ar, FCombatUnitDesc& Desc);
+
+/**
+ * Cold runtime state of one simulated unit. Plain data, safe to memcpy.
+ * Health, mana, cooldown and the combat stats live in the simulation's FUnitStatStore.
+ */
+struct FCombatUnit
+{
+    FCombatUnitDesc Desc;
+
+    FVector2f Position = FVector2f::ZeroVector;
+    EUnitState State = EUnitState::Bench;
+
+    /** Board cell the unit stands in and the cell it is stepping into, for units on the board. */
+    int32 Cell = INDEX_NONE;
+    int32 NextCell = INDEX_NONE;
+
+    int32 Target = INDEX_NONE;
+
+    /** Post-mitigation damage this unit has landed, overkill included. */
+    float DamageDealt = 0.0f;
+
+    bool bIsAlive = true;
+    bool bCanMove = true;
+    bool bCanAttack = true;
+    bool bIsCastingAbility = false;
+    bool bIsMoving = false;
+};
+
+static_assert(std::is_trivially_copyable_v<FCombatUnit>, "FCombatUnit must stay plain data");
+
+// ============================================================================
+// COMBAT SIMULATION
+// ============================================================================
+
+/**
+ * Headless, fixed-step reimplementation of the AUnitBase combat loop.
+ * Owns no UObjects and needs no UWorld, so it can run from commandlets, automation
+ * tests or worker threads. Units are processed in index order, which makes a run
+ * fully deterministic for a given set of inputs.
+ *
+ * Units placed on an FHexBoard cell use hex-distance range checks and step from cell
+ * to cell. Units without a cell use a straight-line approximation of
+ * AIController::MoveToActor. All targeting, damage, mana and casting rules come from
+ * FCombatRules.
+ */
+class TFTUNREALDEMO_API FCombatSimulation
+{
+public:
+    static constexpr float DefaultFixedDeltaTime = 1.0f / 30.0f;
+
+    explicit FCombatSimulation(float InFixedDeltaTime = DefaultFixedDeltaTime);
+
+    // ========================================================================
+    // SETUP
+    // ========================================================================
+
+    /** Adds a unit and returns its index. Units in Combat pick a target immediately. */
+    int32 AddUnit(const FCombatUnitDesc& Desc);
+
+    void Reset();
+
+    /** Optional binary event sink for tracing headless fights. Not owned. */
+    void SetEventLog(FCombatEventLog* InEventLog) { EventLog = InEventLog; }
+
+    /** Optional replay log of every AddUnit and SetState call from outside the simulation. Not owned. */
+    void SetReplayWriter(FCombatReplayWriter* InReplayWriter) { ReplayWriter = InReplayWriter; }
+
+    // ========================================================================
+    // SNAPSHOTS
+    // ========================================================================
+
+    /**
+     * Writes every unit, the stat store, pending clock events and board occupancy.
+     * Units are referenced by index, so the bytes are position independent and two
+     * simulations in the same state produce the same snapshot.
+     */
+    void SaveSnapshot(TArray<uint8>& OutSnapshot) const;
+
+    /**
+     * Puts the simulation back into a saved state; stepping afterwards replays the
+     * original run exactly. The event log and fixed step are not part of the snapshot.
+     * Leaves the simulation untouched and returns false for a corrupt snapshot.
+     */
+    bool RestoreSnapshot(TConstArrayView<uint8> Snapshot);
+
+    /** CRC of the snapshot bytes; equal for equal states. */
+    uint32 ComputeStateChecksum() const;
+
+    // ========================================================================
+    // SIMULATION
+    // ========================================================================
+
+    /** Advances every unit by one fixed step. */
+    void Step();
+
+    /** Steps until one side is eliminated or MaxSteps is reached. Returns the number of steps run. */
+    int32 RunToCompletion(int32 MaxSteps);
+
+    /** True once fewer than two teams have living units in combat. */
+    bool IsFinished() const;
+
+    /** Surviving team index, or INDEX_NONE for a draw or an unfinished fight. */
+    int32 GetWinningTeam() const;
+
+    // ========================================================================
+    // UNIT RULES (mirror AUnitBase)
+    // ========================================================================
+
+    void SetState(int32 UnitIndex, EUnitState NewState);
+    void Think(int32 UnitIndex);
+    void FindNewTarget(int32 UnitIndex);
+    int32 GetNearestEnemy(int32 UnitIndex) const;
+    void AttemptAutoAttack(int32 UnitIndex);
+    void DealDamage(int32 SourceIndex, int32 TargetIndex, float Damage, EDamageType DamageType);
+    void TakeDamage(int32 UnitIndex, float Amount, EDamageType DamageType);
+    void ApplyReducedDamage(int32 UnitIndex, float FinalDamage);
+    void GainMana(int32 UnitIndex, float Amount);
+    void CastAbility(int32 UnitIndex);
+    void Die(int32 UnitIndex);
+
+    // ========================================================================
+    // ACCESSORS
+    // ========================================================================
+
+    const TArray<FCombatUnit>& GetUnits() const { return Units; }
+    const FCombatUnit& GetUnit(int32 UnitIndex) const { return Units[UnitIndex]; }
+    int32 NumUnits() const { return Units.Num(); }
+
+    /** Hot stats indexed by unit index. */
+    const FUnitStatStore& GetStats() const { return Stats; }
+    float GetCurrentHealth(int32 UnitIndex) const { return Stats.CurrentHealth[UnitIndex]; }
+    float GetCurrentMana(int32 UnitIndex) const { return Stats.CurrentMana[UnitIndex]; }
+
+    int32 GetTickCount() const { return TickCount; }
+    float GetFixedDeltaTime() const { return FixedDeltaTime; }
+    float GetElapsedTime() const { return TickCount * FixedDeltaTime; }
+
+private:
+    void ApplyState(int32 UnitIndex, EUnitState NewState);
+    void TickUnit(int32 UnitIndex, bool bTargetInRange);
+    void ThinkInternal(int32 UnitIndex, bool bTargetInRange);
+    void UpdateCooldownMask(int32 UnitIndex);
+    void ComputeTargetRanges();
+    void MoveToTarget(int32 UnitIndex);
+    void StopMovement(int32 UnitIndex);
+    void IntegrateMovement(int32 UnitIndex);
+    void IntegrateHexMovement(int32 UnitIndex);
+    bool IsTargetInRange(int32 UnitIndex) const;
+    void SyncHashCell(int32 UnitIndex);
+    void AdvanceClock();
+    void HandleClockEvent(int32 UnitIndex, ECombatClockEvent Type);
+    void ResolveDamage();
+    void SerializeState(FArchive& Ar);
+
+    FORCEINLINE void RecordEvent(ECombatEventType Type, int32 Source, int32 Target, float Amount = 0.0f, uint8 Detail = 0)
+    {
+#if TFT_WITH_COMBAT_EVENTS
+        if (EventLog)
+        {
+            EventLog->Record(Type, (uint32)TickCount, Source, Target, Amount, Detail);
+        }
+#endif
+    }
+
+    static FVector ToHashLocation(const FVector2f& Position) { return FVector(Position.X, Position.Y, 0.0f); }
+
+    TArray<FCombatUnit> Units;
+    FUnitStatStore Stats;
+    TArray<FIntPoint> UnitCells;
+
+    // Per-step scratch for the batched range check
+    FUnitStatStore::FStatArray TargetDistanceSq;
+    FUnitStatStore::FStatArray TargetInRange;
+    FUnitSpatialHash SpatialHash;
+    FDamageQueue DamageQueue;
+
+    /** Cast ends, on the same clock type the live game uses. */
+    FCombatClock Clock;
+
+    /** Cells held by board units, including cells they are stepping into. */
+    FHexBoard::FCellMask OccupiedCells = 0;
+
+    FCombatEventLog* EventLog = nullptr;
+    FCombatReplayWriter* ReplayWriter = nullptr;
+
+    float FixedDeltaTime;
+    int32 TickCount;
+};
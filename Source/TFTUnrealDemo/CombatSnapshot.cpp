@@ -0,0 +1,225 @@
+// CombatSnapshot.cpp
+
+#include "CombatSnapshot.h"
+
+namespace CombatSnapshotPrivate
+{
+    /** Zero bytes that end a literal run; shorter gaps are cheaper to keep inside the literal. */
+    constexpr int32 MinZeroRun = 4;
+
+    void WriteVarInt(TArray<uint8>& Out, uint32 Value)
+    {
+        while (Value >= 0x80)
+        {
+            Out.Add((uint8)(Value | 0x80));
+            Value >>= 7;
+        }
+        Out.Add((uint8)Value);
+    }
+
+    bool ReadVarInt(TConstArrayView<uint8> In, int32& Offset, uint32& OutValue)
+    {
+        OutValue = 0;
+        for (int32 Shift = 0; Shift < 32; Shift += 7)
+        {
+            if (Offset >= In.Num())
+            {
+                return false;
+            }
+
+            const uint8 Byte = In[Offset++];
+            OutValue |= (uint32)(Byte & 0x7F) << Shift;
+
+            if (!(Byte & 0x80))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+// ============================================================================
+// HISTORY
+// ============================================================================
+
+FCombatSnapshotHistory::FCombatSnapshotHistory(int32 InKeyframeInterval, int32 InMaxSnapshots)
+{
+    Configure(InKeyframeInterval, InMaxSnapshots);
+}
+
+void FCombatSnapshotHistory::Configure(int32 InKeyframeInterval, int32 InMaxSnapshots)
+{
+    KeyframeInterval = FMath::Max(1, InKeyframeInterval);
+
+    // A ring smaller than one group would evict the snapshot it just recorded
+    MaxSnapshots = FMath::Max(KeyframeInterval, InMaxSnapshots);
+}
+
+void FCombatSnapshotHistory::Record(uint32 Frame, TConstArrayView<uint8> Snapshot)
+{
+    // Locate the current keyframe, if the newest group still has room
+    int32 KeyframeIndex = INDEX_NONE;
+    if (Entries.Num() > 0)
+    {
+        const int32 NewestIndex = Entries.Num() - 1;
+        const int32 Candidate = NewestIndex - Entries[NewestIndex].KeyframeOffset;
+
+        if (NewestIndex - Candidate + 1 < KeyframeInterval && Entries[Candidate].Data.Num() == Snapshot.Num())
+        {
+            KeyframeIndex = Candidate;
+        }
+    }
+
+    FEntry& Entry = Entries.AddDefaulted_GetRef();
+    Entry.Frame = Frame;
+
+    if (KeyframeIndex == INDEX_NONE)
+    {
+        Entry.Data.Append(Snapshot.GetData(), Snapshot.Num());
+    }
+    else
+    {
+        Entry.KeyframeOffset = Entries.Num() - 1 - KeyframeIndex;
+        EncodeDelta(Entries[KeyframeIndex].Data, Snapshot, Entry.Data);
+    }
+
+    // Evict whole groups so no delta outlives its keyframe
+    while (Entries.Num() > MaxSnapshots)
+    {
+        int32 GroupSize = 1;
+        while (GroupSize < Entries.Num() && Entries[GroupSize].KeyframeOffset != 0)
+        {
+            ++GroupSize;
+        }
+        Entries.RemoveAt(0, GroupSize, EAllowShrinking::No);
+    }
+}
+
+bool FCombatSnapshotHistory::GetFromNewest(int32 NumBack, TArray<uint8>& OutSnapshot, uint32* OutFrame) const
+{
+    const int32 Index = Entries.Num() - 1 - NumBack;
+    if (!Entries.IsValidIndex(Index))
+    {
+        return false;
+    }
+
+    const FEntry& Entry = Entries[Index];
+    if (OutFrame)
+    {
+        *OutFrame = Entry.Frame;
+    }
+
+    if (Entry.KeyframeOffset == 0)
+    {
+        OutSnapshot = Entry.Data;
+        return true;
+    }
+
+    return DecodeDelta(Entries[Index - Entry.KeyframeOffset].Data, Entry.Data, OutSnapshot);
+}
+
+void FCombatSnapshotHistory::DropNewest(int32 NumNewest)
+{
+    Entries.SetNum(FMath::Max(0, Entries.Num() - FMath::Max(0, NumNewest)), EAllowShrinking::No);
+}
+
+int64 FCombatSnapshotHistory::GetStoredBytes() const
+{
+    int64 Bytes = 0;
+    for (const FEntry& Entry : Entries)
+    {
+        Bytes += Entry.Data.Num();
+    }
+    return Bytes;
+}
+
+// ============================================================================
+// DELTA CODEC
+// ============================================================================
+
+void FCombatSnapshotHistory::EncodeDelta(TConstArrayView<uint8> Base, TConstArrayView<uint8> Target, TArray<uint8>& OutDelta)
+{
+    using namespace CombatSnapshotPrivate;
+
+    check(Base.Num() == Target.Num());
+
+    // Pairs of (unchanged bytes to skip, changed bytes as XOR against the base)
+    OutDelta.Reset();
+    const int32 Num = Target.Num();
+    int32 Index = 0;
+
+    while (Index < Num)
+    {
+        const int32 RunStart = Index;
+        while (Index < Num && Base[Index] == Target[Index])
+        {
+            ++Index;
+        }
+
+        if (Index == Num)
+        {
+            break;
+        }
+
+        const int32 LiteralStart = Index;
+        int32 LiteralEnd = Index;
+        int32 ZeroCount = 0;
+
+        for (; Index < Num && ZeroCount < MinZeroRun; ++Index)
+        {
+            if (Base[Index] == Target[Index])
+            {
+                ++ZeroCount;
+            }
+            else
+            {
+                ZeroCount = 0;
+                LiteralEnd = Index + 1;
+            }
+        }
+
+        WriteVarInt(OutDelta, LiteralStart - RunStart);
+        WriteVarInt(OutDelta, LiteralEnd - LiteralStart);
+        for (int32 Byte = LiteralStart; Byte < LiteralEnd; ++Byte)
+        {
+            OutDelta.Add(Base[Byte] ^ Target[Byte]);
+        }
+
+        Index = LiteralEnd;
+    }
+}
+
+bool FCombatSnapshotHistory::DecodeDelta(TConstArrayView<uint8> Base, TConstArrayView<uint8> Delta, TArray<uint8>& OutTarget)
+{
+    using namespace CombatSnapshotPrivate;
+
+    OutTarget.Reset();
+    OutTarget.Append(Base.GetData(), Base.Num());
+
+    int32 ReadOffset = 0;
+    int32 WriteOffset = 0;
+
+    while (ReadOffset < Delta.Num())
+    {
+        uint32 Skip = 0;
+        uint32 LiteralCount = 0;
+        if (!ReadVarInt(Delta, ReadOffset, Skip) || !ReadVarInt(Delta, ReadOffset, LiteralCount))
+        {
+            return false;
+        }
+
+        WriteOffset += Skip;
+        if ((int64)WriteOffset + LiteralCount > OutTarget.Num() || (int64)ReadOffset + LiteralCount > Delta.Num())
+        {
+            return false;
+        }
+
+        for (uint32 Byte = 0; Byte < LiteralCount; ++Byte)
+        {
+            OutTarget[WriteOffset++] ^= Delta[ReadOffset++];
+        }
+    }
+
+    return true;
+}
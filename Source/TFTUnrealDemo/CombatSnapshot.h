@@ -0,0 +1,152 @@
+// CombatSnapshot.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/Archive.h"
+#include "CombatClock.h"
+
+// ============================================================================
+// SERIALIZATION HELPERS
+// ============================================================================
+
+namespace CombatSnapshot
+{
+    /** Writes or reads Num followed by the raw elements. Only for arrays of padding-free plain data. */
+    template <typename ArrayType>
+    void SerializeRawArray(FArchive& Ar, ArrayType& Array)
+    {
+        using ElementType = typename ArrayType::ElementType;
+        static_assert(std::is_trivially_copyable_v<ElementType>, "Raw array serialization needs plain data");
+
+        int32 Num = Array.Num();
+        Ar << Num;
+
+        if (Ar.IsLoading())
+        {
+            // Corrupt counts must not turn into huge allocations
+            if (Num < 0 || (int64)Num * sizeof(ElementType) > Ar.TotalSize() - Ar.Tell())
+            {
+                Ar.SetError();
+                return;
+            }
+            Array.SetNumUninitialized(Num);
+        }
+
+        Ar.Serialize(Array.GetData(), (int64)Num * sizeof(ElementType));
+    }
+}
+
+// ============================================================================
+// LIVE UNIT RECORDS
+// ============================================================================
+
+enum class EUnitSnapshotFlags : uint8
+{
+    None = 0,
+    Alive = 1 << 0,
+    CanMove = 1 << 1,
+    CanAttack = 1 << 2,
+    CastingAbility = 1 << 3,
+    Hidden = 1 << 4,
+};
+ENUM_CLASS_FLAGS(EUnitSnapshotFlags);
+
+/**
+ * Combat state of one live unit. Targets are registry handles, so a record never
+ * points at memory. No implicit padding: a live snapshot is a header followed by
+ * these records copied as bytes, and unchanged units delta to nothing.
+ */
+struct FUnitCombatSnapshot
+{
+    static constexpr int32 NumEventTypes = (int32)ECombatClockEvent::Count;
+
+    int32 Handle = INDEX_NONE;
+
+    /** UUnitRegistrySubsystem::GetGeneration of the handle, so a recycled handle is not restored as this unit. */
+    uint32 Generation = 0;
+
+    FVector3f Location = FVector3f::ZeroVector;
+    float Yaw = 0.0f;
+    float CurrentHealth = 0.0f;
+    float CurrentMana = 0.0f;
+    float AttackCooldown = 0.0f;
+    int32 TargetHandle = INDEX_NONE;
+    uint32 TargetGeneration = 0;
+
+    /** Seconds until each pending combat clock event fires, indexed by ECombatClockEvent; negative when none. */
+    float EventDelays[NumEventTypes] = { -1.0f, -1.0f, -1.0f };
+
+    uint8 State = 0;
+    EUnitSnapshotFlags Flags = EUnitSnapshotFlags::None;
+    uint8 Padding[2] = {};
+};
+
+static_assert(sizeof(FUnitCombatSnapshot) == 60, "FUnitCombatSnapshot must not gain implicit padding");
+
+struct FCombatSnapshotHeader
+{
+    static constexpr uint32 ExpectedMagic = 0x5446534C; // 'TFSL'
+    static constexpr uint32 ExpectedVersion = 2;
+
+    uint32 Magic = ExpectedMagic;
+    uint32 Version = ExpectedVersion;
+    uint32 Frame = 0;
+    int32 NumUnits = 0;
+};
+
+// ============================================================================
+// SNAPSHOT HISTORY
+// ============================================================================
+
+/**
+ * Ring of recent combat snapshots. Every KeyframeInterval-th snapshot is stored whole;
+ * the ones in between are stored as a delta against their keyframe (XOR, then zero runs
+ * collapsed), which is small because most combat state does not change between
+ * snapshots. The oldest keyframe and its deltas are dropped together once the ring is full.
+ */
+class TFTUNREALDEMO_API FCombatSnapshotHistory
+{
+public:
+    explicit FCombatSnapshotHistory(int32 InKeyframeInterval = 10, int32 InMaxSnapshots = 300);
+
+    /** Takes effect from the next keyframe. */
+    void Configure(int32 InKeyframeInterval, int32 InMaxSnapshots);
+
+    void Record(uint32 Frame, TConstArrayView<uint8> Snapshot);
+
+    /** Rebuilds the snapshot NumBack entries before the newest one (0 = newest). */
+    bool GetFromNewest(int32 NumBack, TArray<uint8>& OutSnapshot, uint32* OutFrame = nullptr) const;
+
+    /** Drops the NumNewest most recent snapshots, e.g. the timeline after a rewind. */
+    void DropNewest(int32 NumNewest);
+
+    void Reset() { Entries.Reset(); }
+    int32 Num() const { return Entries.Num(); }
+    int64 GetStoredBytes() const;
+
+    /** Size of the most recently recorded entry as stored. */
+    int32 GetLastStoredBytes() const { return Entries.Num() > 0 ? Entries.Last().Data.Num() : 0; }
+
+    // ========================================================================
+    // DELTA CODEC
+    // ========================================================================
+
+    /** Base and Target must be the same size. */
+    static void EncodeDelta(TConstArrayView<uint8> Base, TConstArrayView<uint8> Target, TArray<uint8>& OutDelta);
+    static bool DecodeDelta(TConstArrayView<uint8> Base, TConstArrayView<uint8> Delta, TArray<uint8>& OutTarget);
+
+private:
+    struct FEntry
+    {
+        uint32 Frame = 0;
+
+        /** Entries back to this entry's keyframe; 0 for keyframes. Relative so dropping old entries keeps it valid. */
+        int32 KeyframeOffset = 0;
+
+        TArray<uint8> Data;
+    };
+
+    TArray<FEntry> Entries;
+    int32 KeyframeInterval;
+    int32 MaxSnapshots;
+};
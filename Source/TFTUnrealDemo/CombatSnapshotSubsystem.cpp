@@ -0,0 +1,225 @@
+// CombatSnapshotSubsystem.cpp
+
+#include "CombatSnapshotSubsystem.h"
+#include "UnitRegistrySubsystem.h"
+#include "CombatClockSubsystem.h"
+#include "CombatDamageSubsystem.h"
+#include "UnitBase.h"
+#include "TFTUnrealDemo.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+// ============================================================================
+// CONSOLE VARIABLES
+// ============================================================================
+
+static int32 GSnapshotInterval = 10;
+static FAutoConsoleVariableRef CVarSnapshotInterval(
+    TEXT("TFT.Snapshot.Interval"),
+    GSnapshotInterval,
+    TEXT("Ticks between combat snapshots. 0 stops recording."));
+
+static int32 GSnapshotKeyframeInterval = 10;
+static FAutoConsoleVariableRef CVarSnapshotKeyframeInterval(
+    TEXT("TFT.Snapshot.KeyframeInterval"),
+    GSnapshotKeyframeInterval,
+    TEXT("Snapshots per keyframe; the ones in between are stored as deltas."));
+
+static int32 GSnapshotMaxSnapshots = 300;
+static FAutoConsoleVariableRef CVarSnapshotMaxSnapshots(
+    TEXT("TFT.Snapshot.MaxSnapshots"),
+    GSnapshotMaxSnapshots,
+    TEXT("Snapshots kept before the oldest are dropped."));
+
+static FAutoConsoleCommandWithWorldAndArgs CmdSnapshotRewind(
+    TEXT("TFT.Snapshot.Rewind"),
+    TEXT("Restores the combat snapshot N entries back (default 1) and drops the newer ones."),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            UCombatSnapshotSubsystem* Snapshots = World ? World->GetSubsystem<UCombatSnapshotSubsystem>() : nullptr;
+            if (!Snapshots)
+            {
+                return;
+            }
+
+            const int32 NumBack = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1;
+            if (!Snapshots->Rewind(NumBack))
+            {
+                UE_LOG(LogTFTCombat, Warning, TEXT("No combat snapshot %d back (%d recorded)"), NumBack, Snapshots->GetHistory().Num());
+            }
+        }));
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+void UCombatSnapshotSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    UnitRegistry = Collection.InitializeDependency<UUnitRegistrySubsystem>();
+    CombatClock = Collection.InitializeDependency<UCombatClockSubsystem>();
+    DamageSubsystem = Collection.InitializeDependency<UCombatDamageSubsystem>();
+}
+
+void UCombatSnapshotSubsystem::Deinitialize()
+{
+    History.Reset();
+    UnitRegistry = nullptr;
+    CombatClock = nullptr;
+    DamageSubsystem = nullptr;
+
+    Super::Deinitialize();
+}
+
+TStatId UCombatSnapshotSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatSnapshotSubsystem, STATGROUP_Tickables);
+}
+
+bool UCombatSnapshotSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+// ============================================================================
+// TICK
+// ============================================================================
+
+void UCombatSnapshotSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    ++Frame;
+
+    if (GSnapshotInterval <= 0 || Frame % GSnapshotInterval != 0 || !UnitRegistry || UnitRegistry->GetNumRegisteredUnits() == 0)
+    {
+        return;
+    }
+
+    History.Configure(GSnapshotKeyframeInterval, GSnapshotMaxSnapshots);
+
+    CaptureSnapshot(ScratchSnapshot);
+    History.Record(Frame, ScratchSnapshot);
+}
+
+// ============================================================================
+// SNAPSHOTS
+// ============================================================================
+
+void UCombatSnapshotSubsystem::CaptureSnapshot(TArray<uint8>& OutSnapshot)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    ScratchUnits.Reset();
+    ScratchRecordIndices.Init(INDEX_NONE, UnitRegistry ? UnitRegistry->GetNumHandles() : 0);
+
+    for (int32 Handle = 0; Handle < ScratchRecordIndices.Num(); ++Handle)
+    {
+        const AUnitBase* Unit = UnitRegistry->GetUnit(Handle);
+        if (!Unit || Unit->IsInPool())
+        {
+            continue;
+        }
+
+        ScratchRecordIndices[Handle] = ScratchUnits.Num();
+        Unit->CaptureCombatSnapshot(ScratchUnits.AddDefaulted_GetRef());
+    }
+
+    if (CombatClock)
+    {
+        CombatClock->GetClock().ForEachPending([this](int32 Handle, ECombatClockEvent Type, double RemainingTime)
+            {
+                if (ScratchRecordIndices.IsValidIndex(Handle) && ScratchRecordIndices[Handle] != INDEX_NONE)
+                {
+                    ScratchUnits[ScratchRecordIndices[Handle]].EventDelays[(int32)Type] = (float)FMath::Max(RemainingTime, 0.0);
+                }
+            });
+    }
+
+    FCombatSnapshotHeader Header;
+    Header.Frame = Frame;
+    Header.NumUnits = ScratchUnits.Num();
+
+    const int32 UnitBytes = ScratchUnits.Num() * sizeof(FUnitCombatSnapshot);
+    OutSnapshot.SetNumUninitialized(sizeof(Header) + UnitBytes);
+    FMemory::Memcpy(OutSnapshot.GetData(), &Header, sizeof(Header));
+    FMemory::Memcpy(OutSnapshot.GetData() + sizeof(Header), ScratchUnits.GetData(), UnitBytes);
+
+    LastSnapshotBytes = OutSnapshot.Num();
+    CaptureMicroseconds = (float)((FPlatformTime::Seconds() - StartTime) * 1000000.0);
+}
+
+bool UCombatSnapshotSubsystem::RestoreSnapshot(TConstArrayView<uint8> Snapshot)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    FCombatSnapshotHeader Header;
+    if (Snapshot.Num() < (int32)sizeof(Header))
+    {
+        return false;
+    }
+
+    FMemory::Memcpy(&Header, Snapshot.GetData(), sizeof(Header));
+
+    if (Header.Magic != FCombatSnapshotHeader::ExpectedMagic || Header.Version != FCombatSnapshotHeader::ExpectedVersion
+        || Header.NumUnits < 0 || Snapshot.Num() != (int64)sizeof(Header) + (int64)Header.NumUnits * sizeof(FUnitCombatSnapshot))
+    {
+        return false;
+    }
+
+    // Copied out because the snapshot bytes carry no alignment guarantee
+    ScratchUnits.SetNumUninitialized(Header.NumUnits);
+    FMemory::Memcpy(ScratchUnits.GetData(), Snapshot.GetData() + sizeof(Header), Header.NumUnits * sizeof(FUnitCombatSnapshot));
+
+    // Hits queued after the snapshot was taken belong to the discarded timeline
+    if (DamageSubsystem)
+    {
+        DamageSubsystem->DiscardPendingHits();
+    }
+
+    int32 NumSkipped = 0;
+    for (const FUnitCombatSnapshot& Record : ScratchUnits)
+    {
+        // A handle recycled since the capture belongs to a different unit now
+        AUnitBase* Unit = UnitRegistry ? UnitRegistry->GetUnit(Record.Handle) : nullptr;
+        if (!Unit || Unit->IsInPool() || UnitRegistry->GetGeneration(Record.Handle) != Record.Generation)
+        {
+            ++NumSkipped;
+            continue;
+        }
+
+        Unit->RestoreCombatSnapshot(Record);
+    }
+
+    Frame = Header.Frame;
+    RestoreMicroseconds = (float)((FPlatformTime::Seconds() - StartTime) * 1000000.0);
+
+    UE_LOG(LogTFTCombat, Log, TEXT("⏪ Restored combat snapshot from frame %u (%d units, %d no longer in play)"),
+        Header.Frame, Header.NumUnits - NumSkipped, NumSkipped);
+    return true;
+}
+
+bool UCombatSnapshotSubsystem::Rewind(int32 NumBack)
+{
+    if (NumBack < 0 || !History.GetFromNewest(NumBack, ScratchSnapshot) || !RestoreSnapshot(ScratchSnapshot))
+    {
+        return false;
+    }
+
+    // Recording resumes from the restored point
+    History.DropNewest(NumBack);
+    return true;
+}
+
+FCombatSnapshotStats UCombatSnapshotSubsystem::GetStats() const
+{
+    FCombatSnapshotStats Stats;
+    Stats.NumSnapshots = History.Num();
+    Stats.HistoryBytes = (int32)FMath::Min<int64>(History.GetStoredBytes(), MAX_int32);
+    Stats.LastSnapshotBytes = LastSnapshotBytes;
+    Stats.LastStoredBytes = History.GetLastStoredBytes();
+    Stats.CaptureMicroseconds = CaptureMicroseconds;
+    Stats.RestoreMicroseconds = RestoreMicroseconds;
+    return Stats;
+}
@@ -0,0 +1,113 @@
+// CombatSnapshotSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatSnapshot.h"
+#include "CombatSnapshotSubsystem.generated.h"
+
+// Forward declarations
+class UUnitRegistrySubsystem;
+class UCombatClockSubsystem;
+class UCombatDamageSubsystem;
+
+// ============================================================================
+// STRUCTS
+// ============================================================================
+
+/** Size and cost of the snapshot history. */
+USTRUCT(BlueprintType)
+struct FCombatSnapshotStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Snapshot")
+    int32 NumSnapshots = 0;
+
+    /** Keyframes plus deltas, as stored. */
+    UPROPERTY(BlueprintReadOnly, Category = "Snapshot")
+    int32 HistoryBytes = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Snapshot")
+    int32 LastSnapshotBytes = 0;
+
+    /** The last snapshot after delta compression. */
+    UPROPERTY(BlueprintReadOnly, Category = "Snapshot")
+    int32 LastStoredBytes = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Snapshot")
+    float CaptureMicroseconds = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Snapshot")
+    float RestoreMicroseconds = 0.0f;
+};
+
+// ============================================================================
+// COMBAT SNAPSHOT SUBSYSTEM
+// ============================================================================
+
+/**
+ * Captures the combat state of every unit in play (stats, state, target handle, pending
+ * cast end and death steps) every TFT.Snapshot.Interval ticks into a delta-compressed
+ * FCombatSnapshotHistory. Restoring writes the state back through the units, so a fight
+ * can be rewound for debugging or replayed without reloading the level.
+ * Units that went back to the pool after a snapshot was taken are not brought back.
+ */
+UCLASS()
+class TFTUNREALDEMO_API UCombatSnapshotSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // ========================================================================
+    // SNAPSHOTS
+    // ========================================================================
+
+    /** Writes an FCombatSnapshotHeader followed by one FUnitCombatSnapshot per unit in play, by handle. */
+    void CaptureSnapshot(TArray<uint8>& OutSnapshot);
+
+    /** Returns false for a malformed snapshot. Units no longer in play are skipped. */
+    bool RestoreSnapshot(TConstArrayView<uint8> Snapshot);
+
+    /** Restores the snapshot NumBack entries before the newest and discards the ones after it. */
+    UFUNCTION(BlueprintCallable, Category = "Snapshot")
+    bool Rewind(int32 NumBack);
+
+    UFUNCTION(BlueprintCallable, Category = "Snapshot")
+    void ClearHistory() { History.Reset(); }
+
+    const FCombatSnapshotHistory& GetHistory() const { return History; }
+
+    UFUNCTION(BlueprintPure, Category = "Snapshot")
+    FCombatSnapshotStats GetStats() const;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    UPROPERTY()
+    UUnitRegistrySubsystem* UnitRegistry;
+
+    UPROPERTY()
+    UCombatClockSubsystem* CombatClock;
+
+    UPROPERTY()
+    UCombatDamageSubsystem* DamageSubsystem;
+
+    FCombatSnapshotHistory History;
+
+    // Reused between captures
+    TArray<FUnitCombatSnapshot> ScratchUnits;
+    TArray<int32> ScratchRecordIndices;
+    TArray<uint8> ScratchSnapshot;
+
+    uint32 Frame = 0;
+    int32 LastSnapshotBytes = 0;
+    float CaptureMicroseconds = 0.0f;
+    float RestoreMicroseconds = 0.0f;
+};
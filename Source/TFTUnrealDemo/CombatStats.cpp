@@ -0,0 +1,70 @@
+// CombatStats.cpp
+
+#include "CombatStats.h"
+#include "CombatEventLog.h"
+#include "HAL/PlatformTime.h"
+
+// ============================================================================
+// STATS
+// ============================================================================
+
+DEFINE_STAT(STAT_TFTThink);
+DEFINE_STAT(STAT_TFTFindNewTarget);
+DEFINE_STAT(STAT_TFTGetNearestEnemy);
+DEFINE_STAT(STAT_TFTRetargetAttackers);
+DEFINE_STAT(STAT_TFTMoveToTarget);
+DEFINE_STAT(STAT_TFTFaceTarget);
+DEFINE_STAT(STAT_TFTAttemptAutoAttack);
+DEFINE_STAT(STAT_TFTDealDamage);
+DEFINE_STAT(STAT_TFTTakeDamage);
+DEFINE_STAT(STAT_TFTApplyReducedDamage);
+DEFINE_STAT(STAT_TFTGainMana);
+DEFINE_STAT(STAT_TFTCastAbility);
+DEFINE_STAT(STAT_TFTDie);
+DEFINE_STAT(STAT_TFTSetState);
+
+DEFINE_STAT(STAT_TFTAIScheduler);
+DEFINE_STAT(STAT_TFTMovementBatch);
+DEFINE_STAT(STAT_TFTDamageResolve);
+DEFINE_STAT(STAT_TFTCombatClock);
+DEFINE_STAT(STAT_TFTRegistryUpdate);
+DEFINE_STAT(STAT_TFTCombatLobby);
+DEFINE_STAT(STAT_TFTEventDispatch);
+DEFINE_STAT(STAT_TFTStatusEffects);
+DEFINE_STAT(STAT_TFTProjectiles);
+DEFINE_STAT(STAT_TFTAbilityResolve);
+
+DEFINE_STAT(STAT_TFTTargetsSearched);
+DEFINE_STAT(STAT_TFTUnitsScanned);
+DEFINE_STAT(STAT_TFTMoveRequests);
+DEFINE_STAT(STAT_TFTDamageEvents);
+
+CSV_DEFINE_CATEGORY_MODULE(TFTUNREALDEMO_API, TFTCombat, true);
+
+// ============================================================================
+// INSIGHTS CHANNEL
+// ============================================================================
+
+UE_TRACE_CHANNEL_DEFINE(TFTCombatChannel);
+
+UE_TRACE_EVENT_BEGIN(TFTCombat, UnitEvent)
+    UE_TRACE_EVENT_FIELD(uint64, Cycle)
+    UE_TRACE_EVENT_FIELD(uint32, Tick)
+    UE_TRACE_EVENT_FIELD(int32, Source)
+    UE_TRACE_EVENT_FIELD(int32, Target)
+    UE_TRACE_EVENT_FIELD(float, Amount)
+    UE_TRACE_EVENT_FIELD(uint8, Type)
+    UE_TRACE_EVENT_FIELD(uint8, Detail)
+UE_TRACE_EVENT_END()
+
+void TFTCombatTrace::OutputUnitEvent(ECombatEventType Type, uint32 Tick, int32 Source, int32 Target, float Amount, uint8 Detail)
+{
+    UE_TRACE_LOG(TFTCombat, UnitEvent, TFTCombatChannel)
+        << UnitEvent.Cycle(FPlatformTime::Cycles64())
+        << UnitEvent.Tick(Tick)
+        << UnitEvent.Source(Source)
+        << UnitEvent.Target(Target)
+        << UnitEvent.Amount(Amount)
+        << UnitEvent.Type((uint8)Type)
+        << UnitEvent.Detail(Detail);
+}
@@ -0,0 +1,102 @@
+// CombatStats.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Trace/Trace.h"
+
+enum class ECombatEventType : uint8;
+
+// ============================================================================
+// STAT GROUP
+// ============================================================================
+
+// "stat TFTCombat" in game; cycle stats also show up in Insights with -statnamedevents
+DECLARE_STATS_GROUP(TEXT("TFT Combat"), STATGROUP_TFTCombat, STATCAT_Advanced);
+
+// Unit entry points
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Think"), STAT_TFTThink, STATGROUP_TFTCombat, TFTUNREALDEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("FindNewTarget"), STAT_TFTFindNewTarget, STATGROUP_TFTCombat, TFTUNREALDEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("GetNearestEnemy"), STAT_TFTGetNearestEnemy, STATGROUP_TFTCombat, TFTUNREALDEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("RetargetAttackers"), STAT_TFTRetargetAttackers, STATGROUP_TFTCombat, TFTUNREALDEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("MoveToTarget"), STAT_TFTMoveToTarget, STATGROUP_TFTCombat, TFTUNREALDEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("FaceTarget"), STAT_TFTFaceTarget, STATGROUP_TFTCombat, TFTUNREALDEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AttemptAutoAttack"), STAT_TFTAttemptAutoAttack, STATGROUP_TFTCombat, TFTUNREALDEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("DealDamage"), STAT_TFTDealDamage, STATGROUP_TFTCombat, TFTUNREALDEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("TakeDamage"), STAT_TFTTakeDamage, STATGROUP_TFTCombat, TFTUNREALDEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ApplyReducedDamage"), STAT_TFTApplyReducedDamage, STATGROUP_TFTCombat, TFTUNREALDEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("GainMana"), STAT_TFTGainMana, STATGROUP_TFTCombat, TFTUNREALDEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("CastAbility"), STAT_TFTCastAbility, STATGROUP_TFTCombat, TFTUNREALDEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Die"), STAT_TFTDie, STATGROUP_TFTCombat, TFTUNREALDEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("SetState"), STAT_TFTSetState, STATGROUP_TFTCombat, TFTUNREALDEMO_API);
+
+// Per-frame subsystem updates, also written to CSV profiles
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AI Scheduler"), STAT_TFTAIScheduler, STATGROUP_TFTCombat, TFTUNREALDEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Movement Batch"), STAT_TFTMovementBatch, STATGROUP_TFTCombat, TFTUNREALDEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Damage Resolve"), STAT_TFTDamageResolve, STATGROUP_TFTCombat, TFTUNREALDEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Combat Clock"), STAT_TFTCombatClock, STATGROUP_TFTCombat, TFTUNREALDEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Registry Update"), STAT_TFTRegistryUpdate, STATGROUP_TFTCombat, TFTUNREALDEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Combat Lobby"), STAT_TFTCombatLobby, STATGROUP_TFTCombat, TFTUNREALDEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Event Dispatch"), STAT_TFTEventDispatch, STATGROUP_TFTCombat, TFTUNREALDEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Status Effects"), STAT_TFTStatusEffects, STATGROUP_TFTCombat, TFTUNREALDEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Projectiles"), STAT_TFTProjectiles, STATGROUP_TFTCombat, TFTUNREALDEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Ability Resolve"), STAT_TFTAbilityResolve, STATGROUP_TFTCombat, TFTUNREALDEMO_API);
+
+// Per-frame counters; reset every frame
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Targets Searched"), STAT_TFTTargetsSearched, STATGROUP_TFTCombat, TFTUNREALDEMO_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Units Scanned"), STAT_TFTUnitsScanned, STATGROUP_TFTCombat, TFTUNREALDEMO_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Move Requests"), STAT_TFTMoveRequests, STATGROUP_TFTCombat, TFTUNREALDEMO_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Damage Events"), STAT_TFTDamageEvents, STATGROUP_TFTCombat, TFTUNREALDEMO_API);
+
+// Frame scopes and counters land in CSV profiles, e.g. a soak run with -nullrhi -csvCaptureFrames=N
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(TFTUNREALDEMO_API, TFTCombat);
+
+// ============================================================================
+// SCOPE AND COUNTER MACROS
+// ============================================================================
+
+/** Cycle stat plus a named Insights CPU scope. For entry points that run many times a frame. */
+#define TFT_COMBAT_SCOPE(Name) \
+    SCOPE_CYCLE_COUNTER(STAT_TFT##Name); \
+    TRACE_CPUPROFILER_EVENT_SCOPE(TFT_##Name)
+
+/** TFT_COMBAT_SCOPE plus a CSV timing stat. For once-per-frame updates, so CSV captures stay cheap. */
+#define TFT_COMBAT_FRAME_SCOPE(Name) \
+    TFT_COMBAT_SCOPE(Name); \
+    CSV_SCOPED_TIMING_STAT(TFTCombat, Name)
+
+/** Adds to a per-frame counter and the CSV stat of the same name. Amount is evaluated once. */
+#define TFT_COMBAT_COUNTER(Name, Amount) \
+    do \
+    { \
+        const int32 TFTCounterAmount = (int32)(Amount); \
+        INC_DWORD_STAT_BY(STAT_TFT##Name, TFTCounterAmount); \
+        CSV_CUSTOM_STAT(TFTCombat, Name, TFTCounterAmount, ECsvCustomStatOp::Accumulate); \
+    } while (0)
+
+// ============================================================================
+// INSIGHTS CHANNEL
+// ============================================================================
+
+// Per-unit combat events in Unreal Insights: run with -trace=cpu,frame,TFTCombat
+UE_TRACE_CHANNEL_EXTERN(TFTCombatChannel, TFTUNREALDEMO_API);
+
+namespace TFTCombatTrace
+{
+    TFTUNREALDEMO_API void OutputUnitEvent(ECombatEventType Type, uint32 Tick, int32 Source, int32 Target, float Amount = 0.0f, uint8 Detail = 0);
+}
+
+#if UE_TRACE_ENABLED
+#define TFT_TRACE_COMBAT_EVENT(Type, Tick, Source, Target, ...) \
+    do \
+    { \
+        if (UE_TRACE_CHANNELEXPR_IS_ENABLED(TFTCombatChannel)) \
+        { \
+            TFTCombatTrace::OutputUnitEvent(ECombatEventType::Type, (uint32)(Tick), Source, Target, ##__VA_ARGS__); \
+        } \
+    } while (0)
+#else
+#define TFT_TRACE_COMBAT_EVENT(...) do { } while (0)
+#endif
@@ -0,0 +1,74 @@
+// CombatTypes.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatTypes.generated.h"
+
+// Forward declarations
+class AActor;
+
+// ============================================================================
+// ENUMS
+// ============================================================================
+
+UENUM(BlueprintType)
+enum class ETeam : uint8
+{
+    Player UMETA(DisplayName = "Player"),
+    Enemy UMETA(DisplayName = "Enemy"),
+    Neutral UMETA(DisplayName = "Neutral")
+};
+
+UENUM(BlueprintType)
+enum class EUnitState : uint8
+{
+    Bench UMETA(DisplayName = "Bench"),
+    BoardIdle UMETA(DisplayName = "Board Idle"),
+    Combat UMETA(DisplayName = "Combat")
+};
+
+UENUM(BlueprintType)
+enum class EDamageType : uint8
+{
+    Physical UMETA(DisplayName = "Physical"),
+    Magical UMETA(DisplayName = "Magical"),
+    TrueDamage UMETA(DisplayName = "True Damage")
+};
+
+/** How much cosmetic work a unit gets; set by UUnitSignificanceSubsystem. Gameplay runs the same at every level. */
+UENUM(BlueprintType)
+enum class EUnitSignificance : uint8
+{
+    Full UMETA(DisplayName = "Full"),
+    Reduced UMETA(DisplayName = "Reduced"),
+    Minimal UMETA(DisplayName = "Minimal")
+};
+
+// ============================================================================
+// STRUCTS
+// ============================================================================
+
+USTRUCT(BlueprintType)
+struct FDamageInfo
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadWrite)
+    float Amount;
+
+    UPROPERTY(BlueprintReadWrite)
+    EDamageType Type;
+
+    UPROPERTY(BlueprintReadWrite)
+    AActor* Causer;
+
+    FDamageInfo()
+        : Amount(0.0f), Type(EDamageType::Physical), Causer(nullptr)
+    {
+    }
+
+    FDamageInfo(float InAmount, EDamageType InType, AActor* InCauser = nullptr)
+        : Amount(InAmount), Type(InType), Causer(InCauser)
+    {
+    }
+};
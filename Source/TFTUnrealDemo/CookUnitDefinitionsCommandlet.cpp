@@ -0,0 +1,115 @@
+// CookUnitDefinitionsCommandlet.cpp
+
+#include "CookUnitDefinitionsCommandlet.h"
+#include "UnitDefinitionSubsystem.h"
+#include "UnitDefinitionTable.h"
+#include "TFTUnrealDemo.h"
+#include "Engine/DataTable.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+UCookUnitDefinitionsCommandlet::UCookUnitDefinitionsCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UCookUnitDefinitionsCommandlet::Main(const FString& Params)
+{
+    UDataTable* DataTable = nullptr;
+
+    FString CsvPath;
+    FString TablePath;
+
+    if (FParse::Value(*Params, TEXT("Table="), TablePath))
+    {
+        DataTable = LoadObject<UDataTable>(nullptr, *TablePath);
+    }
+    else if (FParse::Value(*Params, TEXT("Csv="), CsvPath))
+    {
+#if WITH_EDITOR
+        FString CsvText;
+        if (FFileHelper::LoadFileToString(CsvText, *CsvPath))
+        {
+            DataTable = NewObject<UDataTable>();
+            DataTable->RowStruct = FUnitDefinitionRow::StaticStruct();
+
+            for (const FString& Problem : DataTable->CreateTableFromCSVString(CsvText))
+            {
+                UE_LOG(LogTFTCombat, Warning, TEXT("%s: %s"), *CsvPath, *Problem);
+            }
+        }
+#endif
+    }
+    else
+    {
+        UE_LOG(LogTFTCombat, Error, TEXT("Usage: -run=CookUnitDefinitions (-Csv=<file.csv> | -Table=<DataTable path>) [-Out=<file>]"));
+        return 1;
+    }
+
+    if (!DataTable || DataTable->RowStruct != FUnitDefinitionRow::StaticStruct())
+    {
+        UE_LOG(LogTFTCombat, Error, TEXT("Could not load a FUnitDefinitionRow table from %s"), TablePath.IsEmpty() ? *CsvPath : *TablePath);
+        return 1;
+    }
+
+    // ========================================================================
+    // CONVERT
+    // ========================================================================
+
+    TArray<FUnitDefinitionTable::FSource> Sources;
+
+    DataTable->ForeachRow<FUnitDefinitionRow>(TEXT("CookUnitDefinitions"), [&Sources](const FName& RowName, const FUnitDefinitionRow& Row)
+        {
+            FUnitDefinitionTable::FSource& Source = Sources.AddDefaulted_GetRef();
+            Source.Name = RowName.ToString();
+            Source.MontagePaths[(int32)EUnitDefinitionMontage::Attack] = Row.AttackMontage.ToSoftObjectPath().ToString();
+            Source.MontagePaths[(int32)EUnitDefinitionMontage::Ability] = Row.AbilityMontage.ToSoftObjectPath().ToString();
+            Source.MontagePaths[(int32)EUnitDefinitionMontage::Death] = Row.DeathMontage.ToSoftObjectPath().ToString();
+
+            for (const FUnitDefinitionStarStats& StarStats : Row.StarLevels)
+            {
+                Source.StarLevels.Add(StarStats.ToStats());
+            }
+        });
+
+    TArray<uint8> Blob;
+    FString Error;
+    if (!FUnitDefinitionTable::Cook(Sources, Blob, Error))
+    {
+        UE_LOG(LogTFTCombat, Error, TEXT("%s"), *Error);
+        return 1;
+    }
+
+    // ========================================================================
+    // WRITE
+    // ========================================================================
+
+    FString OutPath;
+    if (!FParse::Value(*Params, TEXT("Out="), OutPath))
+    {
+        const IConsoleVariable* DefinitionFile = IConsoleManager::Get().FindConsoleVariable(TEXT("TFT.Units.DefinitionFile"));
+        OutPath = FPaths::ProjectContentDir() / (DefinitionFile ? DefinitionFile->GetString() : FString(TEXT("Data/UnitDefinitions.tftunits")));
+    }
+
+    if (!FFileHelper::SaveArrayToFile(Blob, *OutPath))
+    {
+        UE_LOG(LogTFTCombat, Error, TEXT("Could not write %s"), *OutPath);
+        return 1;
+    }
+
+    // Round trip through the loader so a bad cook fails here rather than at startup
+    FUnitDefinitionTable Check;
+    if (!Check.LoadFromFile(*OutPath) || Check.Num() != Sources.Num())
+    {
+        UE_LOG(LogTFTCombat, Error, TEXT("Cooked file %s does not load back"), *OutPath);
+        return 1;
+    }
+
+    UE_LOG(LogTFTCombat, Display, TEXT("Cooked %d unit definitions (%d bytes) to %s"), Sources.Num(), Blob.Num(), *OutPath);
+    return 0;
+}
@@ -0,0 +1,30 @@
+// CookUnitDefinitionsCommandlet.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "CookUnitDefinitionsCommandlet.generated.h"
+
+// ============================================================================
+// COOK UNIT DEFINITIONS COMMANDLET
+// ============================================================================
+
+/**
+ * Converts authored unit definitions (FUnitDefinitionRow) into the binary file read by
+ * UUnitDefinitionSubsystem and FUnitDefinitionTable.
+ *
+ * UnrealEditor-Cmd TFTUnrealDemo -run=CookUnitDefinitions
+ *     (-Csv=<file.csv> | -Table=/Game/Data/DT_UnitDefinitions) [-Out=<file.tftunits>]
+ *
+ * -Out defaults to TFT.Units.DefinitionFile under the content directory.
+ */
+UCLASS()
+class UCookUnitDefinitionsCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UCookUnitDefinitionsCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
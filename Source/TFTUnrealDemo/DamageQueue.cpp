@@ -0,0 +1,60 @@
+// DamageQueue.cpp
+
+#include "DamageQueue.h"
+
+void FDamageQueue::Push(int32 Source, int32 Target, float Amount, EDamageType Type)
+{
+    FQueuedDamage& Hit = Hits.AddDefaulted_GetRef();
+    Hit.Source = Source;
+    Hit.Target = Target;
+    Hit.Amount = Amount;
+    Hit.Type = Type;
+}
+
+void FDamageQueue::ComputeFinalDamage(const FUnitStatStore& Stats, TArray<FQueuedDamage>& Batch)
+{
+    // True damage passes straight through
+    for (FQueuedDamage& Hit : Batch)
+    {
+        Hit.FinalDamage = Hit.Amount;
+    }
+
+    for (const EDamageType Type : { EDamageType::Physical, EDamageType::Magical })
+    {
+        const FUnitStatStore::FStatArray& Resists = Type == EDamageType::Physical ? Stats.Armor : Stats.MagicResist;
+
+        TypeHitIndices.Reset();
+        GatheredAmounts.Reset();
+        GatheredResists.Reset();
+
+        for (int32 HitIndex = 0; HitIndex < Batch.Num(); ++HitIndex)
+        {
+            const FQueuedDamage& Hit = Batch[HitIndex];
+            if (Hit.Type != Type)
+            {
+                continue;
+            }
+
+            TypeHitIndices.Add(HitIndex);
+            GatheredAmounts.Add(Hit.Amount);
+            GatheredResists.Add(Resists.IsValidIndex(Hit.Target) ? Resists[Hit.Target] : 0.0f);
+        }
+
+        if (TypeHitIndices.Num() == 0)
+        {
+            continue;
+        }
+
+        const int32 NumPadded = Align(TypeHitIndices.Num(), FUnitStatStore::SimdWidth);
+        GatheredAmounts.SetNumZeroed(NumPadded);
+        GatheredResists.SetNumZeroed(NumPadded);
+        GatheredResults.SetNumUninitialized(NumPadded, EAllowShrinking::No);
+
+        FUnitStatStore::ReduceDamage(GatheredAmounts.GetData(), GatheredResists.GetData(), GatheredResults.GetData(), NumPadded);
+
+        for (int32 Index = 0; Index < TypeHitIndices.Num(); ++Index)
+        {
+            Batch[TypeHitIndices[Index]].FinalDamage = GatheredResults[Index];
+        }
+    }
+}
@@ -0,0 +1,91 @@
+// DamageQueue.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatTypes.h"
+#include "UnitStatStore.h"
+
+// ============================================================================
+// QUEUED DAMAGE
+// ============================================================================
+
+/** One hit waiting for the end-of-frame resolve. Units are referenced by handle. */
+struct FQueuedDamage
+{
+    int32 Source = INDEX_NONE;
+    int32 Target = INDEX_NONE;
+    float Amount = 0.0f;
+    float FinalDamage = 0.0f;
+    EDamageType Type = EDamageType::Physical;
+};
+
+// ============================================================================
+// DAMAGE QUEUE
+// ============================================================================
+
+/**
+ * Collects every hit of a frame and resolves them together. Damage reduction runs
+ * as one vectorized batch per EDamageType, then hits are applied in push order so
+ * same-frame kills always happen in the same sequence.
+ */
+class TFTUNREALDEMO_API FDamageQueue
+{
+public:
+    /** Guards against abilities that keep queuing damage from inside the resolve. */
+    static constexpr int32 MaxResolvePasses = 8;
+
+    void Push(int32 Source, int32 Target, float Amount, EDamageType Type);
+
+    int32 Num() const { return Hits.Num(); }
+    bool IsEmpty() const { return Hits.Num() == 0; }
+    void Reset() { Hits.Reset(); }
+
+    /**
+     * Computes FinalDamage for every queued hit against the target's resistances in Stats,
+     * then calls ApplyFunc(const FQueuedDamage&) for each hit in push order. Hits pushed
+     * from inside ApplyFunc are resolved in a follow-up pass. Returns the number of hits applied.
+     */
+    template <typename ApplyFuncType>
+    int32 Resolve(const FUnitStatStore& Stats, ApplyFuncType&& ApplyFunc);
+
+private:
+    void ComputeFinalDamage(const FUnitStatStore& Stats, TArray<FQueuedDamage>& Batch);
+
+    TArray<FQueuedDamage> Hits;
+    TArray<FQueuedDamage> Resolving;
+
+    // Per-type gather buffers for the reduction kernel
+    TArray<int32> TypeHitIndices;
+    FUnitStatStore::FStatArray GatheredAmounts;
+    FUnitStatStore::FStatArray GatheredResists;
+    FUnitStatStore::FStatArray GatheredResults;
+};
+
+// ============================================================================
+// TEMPLATE IMPLEMENTATION
+// ============================================================================
+
+template <typename ApplyFuncType>
+int32 FDamageQueue::Resolve(const FUnitStatStore& Stats, ApplyFuncType&& ApplyFunc)
+{
+    int32 NumApplied = 0;
+
+    for (int32 Pass = 0; Pass < MaxResolvePasses && Hits.Num() > 0; ++Pass)
+    {
+        // Swap so hits queued by ApplyFunc land in the next pass
+        Swap(Hits, Resolving);
+        Hits.Reset();
+
+        ComputeFinalDamage(Stats, Resolving);
+
+        for (const FQueuedDamage& Hit : Resolving)
+        {
+            ApplyFunc(Hit);
+        }
+
+        NumApplied += Resolving.Num();
+        Resolving.Reset();
+    }
+
+    return NumApplied;
+}
@@ -0,0 +1,71 @@
+// HexBoard.cpp
+
+#include "HexBoard.h"
+
+// Pointy-top hexes: rows are sqrt(3)/2 hex widths apart
+static constexpr float HexRowSpacing = 0.8660254f;
+
+int32 FHexBoard::GetStepTowards(int32 From, int32 To, FCellMask BlockedCells)
+{
+    int32 BestCell = INDEX_NONE;
+    int32 BestDistance = GetDistance(From, To);
+
+    for (int32 Direction = 0; Direction < NumNeighbors; ++Direction)
+    {
+        const int32 Neighbor = GetNeighbor(From, Direction);
+        if (Neighbor == INDEX_NONE || (BlockedCells & GetCellBit(Neighbor)))
+        {
+            continue;
+        }
+
+        const int32 Distance = GetDistance(Neighbor, To);
+        if (Distance < BestDistance || (Distance == BestDistance && BestCell != INDEX_NONE && Neighbor < BestCell))
+        {
+            BestDistance = Distance;
+            BestCell = Neighbor;
+        }
+    }
+
+    return BestCell;
+}
+
+FVector2f FHexBoard::GetCellCenter(int32 Cell, float HexWidth)
+{
+    const int32 Row = GetRow(Cell);
+    return FVector2f(HexWidth * (GetColumn(Cell) + 0.5f * (Row & 1)), HexWidth * HexRowSpacing * Row);
+}
+
+int32 FHexBoard::FindCellAt(const FVector2f& LocalPosition, float HexWidth)
+{
+    // Fractional axial coordinates, then cube rounding
+    const float R = LocalPosition.Y / (HexWidth * HexRowSpacing);
+    const float Q = LocalPosition.X / HexWidth - 0.5f * R;
+    const float S = -Q - R;
+
+    int32 RoundedQ = FMath::RoundToInt(Q);
+    int32 RoundedR = FMath::RoundToInt(R);
+    const int32 RoundedS = FMath::RoundToInt(S);
+
+    const float ErrorQ = FMath::Abs(RoundedQ - Q);
+    const float ErrorR = FMath::Abs(RoundedR - R);
+    const float ErrorS = FMath::Abs(RoundedS - S);
+
+    if (ErrorQ > ErrorR && ErrorQ > ErrorS)
+    {
+        RoundedQ = -RoundedR - RoundedS;
+    }
+    else if (ErrorR > ErrorS)
+    {
+        RoundedR = -RoundedQ - RoundedS;
+    }
+
+    const int32 Row = RoundedR;
+    const int32 Column = RoundedQ + (Row - (Row & 1)) / 2;
+
+    if (Row < 0 || Row >= NumRows || Column < 0 || Column >= NumColumns)
+    {
+        return INDEX_NONE;
+    }
+
+    return GetCell(Column, Row);
+}
@@ -0,0 +1,162 @@
+// HexBoard.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+// ============================================================================
+// HEX BOARD
+// ============================================================================
+
+/**
+ * The combat board as a fixed grid of pointy-top hexes, 7 columns by 8 rows (4 rows per
+ * side), in "odd-r" offset layout: odd rows are shifted half a hex to the right.
+ * Cell index = Row * NumColumns + Column, and cell 0 sits at the board-local origin.
+ *
+ * Distances, neighbors and in-range sets are computed at compile time, so every range
+ * check is a table lookup and never touches a transform.
+ */
+struct TFTUNREALDEMO_API FHexBoard
+{
+    static constexpr int32 NumColumns = 7;
+    static constexpr int32 NumRows = 8;
+    static constexpr int32 NumCells = NumColumns * NumRows;
+    static constexpr int32 NumNeighbors = 6;
+
+    /** Longest hex distance between two cells; larger ranges cover the whole board. */
+    static constexpr int32 MaxDistance = NumColumns - 1 + NumRows - 1;
+
+    /** Distance between neighboring cell centers in world units. Matches the registry's hash cell. */
+    static constexpr float DefaultHexWidth = 200.0f;
+
+    /** One bit per cell. */
+    using FCellMask = uint64;
+    static_assert(NumCells <= 64, "Cell masks are stored in a single uint64");
+
+    static constexpr bool IsValidCell(int32 Cell) { return Cell >= 0 && Cell < NumCells; }
+    static constexpr int32 GetCell(int32 Column, int32 Row) { return Row * NumColumns + Column; }
+    static constexpr int32 GetColumn(int32 Cell) { return Cell % NumColumns; }
+    static constexpr int32 GetRow(int32 Cell) { return Cell / NumColumns; }
+    static constexpr FCellMask GetCellBit(int32 Cell) { return FCellMask(1) << Cell; }
+
+    /** Axial coordinates make hex distance a closed-form expression. */
+    static constexpr int32 GetAxialQ(int32 Cell) { return GetColumn(Cell) - (GetRow(Cell) - (GetRow(Cell) & 1)) / 2; }
+    static constexpr int32 GetAxialR(int32 Cell) { return GetRow(Cell); }
+
+    static constexpr int32 ComputeDistance(int32 CellA, int32 CellB)
+    {
+        const int32 DeltaQ = GetAxialQ(CellA) - GetAxialQ(CellB);
+        const int32 DeltaR = GetAxialR(CellA) - GetAxialR(CellB);
+        const int32 DeltaS = DeltaQ + DeltaR;
+        return ((DeltaQ < 0 ? -DeltaQ : DeltaQ) + (DeltaR < 0 ? -DeltaR : DeltaR) + (DeltaS < 0 ? -DeltaS : DeltaS)) / 2;
+    }
+
+    // ========================================================================
+    // TABLE LOOKUPS
+    // ========================================================================
+
+    static int32 GetDistance(int32 CellA, int32 CellB);
+    static bool IsInRange(int32 CellA, int32 CellB, int32 RangeInHexes);
+
+    /** Every cell within RangeInHexes of Cell, including Cell itself. */
+    static FCellMask GetInRangeMask(int32 Cell, int32 RangeInHexes);
+
+    /** Neighbor in one of the six directions, INDEX_NONE past the board edge. */
+    static int32 GetNeighbor(int32 Cell, int32 Direction);
+
+    /**
+     * The free neighbor of From that gets closest to To, or INDEX_NONE when every step
+     * closer is blocked. Ties go to the lower cell index so paths are deterministic.
+     */
+    static int32 GetStepTowards(int32 From, int32 To, FCellMask BlockedCells);
+
+    // ========================================================================
+    // BOARD-LOCAL POSITIONS
+    // ========================================================================
+
+    static FVector2f GetCellCenter(int32 Cell, float HexWidth = DefaultHexWidth);
+
+    /** Cell containing a board-local position, or INDEX_NONE off the board. */
+    static int32 FindCellAt(const FVector2f& LocalPosition, float HexWidth = DefaultHexWidth);
+};
+
+// ============================================================================
+// PRECOMPUTED TABLES
+// ============================================================================
+
+namespace HexBoardPrivate
+{
+    struct FTables
+    {
+        uint8 Distance[FHexBoard::NumCells][FHexBoard::NumCells] = {};
+        int8 Neighbors[FHexBoard::NumCells][FHexBoard::NumNeighbors] = {};
+        FHexBoard::FCellMask InRange[FHexBoard::MaxDistance + 1][FHexBoard::NumCells] = {};
+    };
+
+    constexpr FTables BuildTables()
+    {
+        constexpr int32 AxialDirections[FHexBoard::NumNeighbors][2] = { { 1, 0 }, { 1, -1 }, { 0, -1 }, { -1, 0 }, { -1, 1 }, { 0, 1 } };
+
+        FTables Result;
+        FHexBoard::FCellMask ExactDistance[FHexBoard::MaxDistance + 1][FHexBoard::NumCells] = {};
+
+        for (int32 CellA = 0; CellA < FHexBoard::NumCells; ++CellA)
+        {
+            for (int32 CellB = 0; CellB < FHexBoard::NumCells; ++CellB)
+            {
+                const int32 Distance = FHexBoard::ComputeDistance(CellA, CellB);
+                Result.Distance[CellA][CellB] = (uint8)Distance;
+                ExactDistance[Distance][CellA] |= FHexBoard::GetCellBit(CellB);
+            }
+
+            for (int32 Direction = 0; Direction < FHexBoard::NumNeighbors; ++Direction)
+            {
+                const int32 Row = FHexBoard::GetAxialR(CellA) + AxialDirections[Direction][1];
+                const int32 Column = FHexBoard::GetAxialQ(CellA) + AxialDirections[Direction][0] + (Row - (Row & 1)) / 2;
+                const bool bOnBoard = Row >= 0 && Row < FHexBoard::NumRows && Column >= 0 && Column < FHexBoard::NumColumns;
+                Result.Neighbors[CellA][Direction] = (int8)(bOnBoard ? FHexBoard::GetCell(Column, Row) : INDEX_NONE);
+            }
+        }
+
+        // In-range sets are running unions of the exact-distance rings
+        for (int32 Cell = 0; Cell < FHexBoard::NumCells; ++Cell)
+        {
+            FHexBoard::FCellMask Accumulated = 0;
+            for (int32 Range = 0; Range <= FHexBoard::MaxDistance; ++Range)
+            {
+                Accumulated |= ExactDistance[Range][Cell];
+                Result.InRange[Range][Cell] = Accumulated;
+            }
+        }
+
+        return Result;
+    }
+
+    inline constexpr FTables Tables = BuildTables();
+
+    static_assert(Tables.Distance[0][FHexBoard::NumCells - 1] <= FHexBoard::MaxDistance, "MaxDistance must cover the whole board");
+    static_assert(Tables.InRange[FHexBoard::MaxDistance][0] == (FHexBoard::GetCellBit(FHexBoard::NumCells - 1) << 1) - 1, "Max range must reach every cell");
+}
+
+// ============================================================================
+// INLINE IMPLEMENTATION
+// ============================================================================
+
+FORCEINLINE int32 FHexBoard::GetDistance(int32 CellA, int32 CellB)
+{
+    return HexBoardPrivate::Tables.Distance[CellA][CellB];
+}
+
+FORCEINLINE bool FHexBoard::IsInRange(int32 CellA, int32 CellB, int32 RangeInHexes)
+{
+    return HexBoardPrivate::Tables.Distance[CellA][CellB] <= RangeInHexes;
+}
+
+FORCEINLINE FHexBoard::FCellMask FHexBoard::GetInRangeMask(int32 Cell, int32 RangeInHexes)
+{
+    return RangeInHexes < 0 ? 0 : HexBoardPrivate::Tables.InRange[FMath::Min(RangeInHexes, MaxDistance)][Cell];
+}
+
+FORCEINLINE int32 FHexBoard::GetNeighbor(int32 Cell, int32 Direction)
+{
+    return HexBoardPrivate::Tables.Neighbors[Cell][Direction];
+}
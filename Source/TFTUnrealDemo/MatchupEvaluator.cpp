@@ -0,0 +1,320 @@
+// MatchupEvaluator.cpp
+
+#include "MatchupEvaluator.h"
+#include "UnitDefinitionTable.h"
+#include "CombatReplay.h"
+#include "Async/ParallelFor.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Math/RandomStream.h"
+#include "Misc/Crc.h"
+#include "HAL/PlatformTime.h"
+
+// ============================================================================
+// LOADING
+// ============================================================================
+
+namespace MatchupEvaluatorPrivate
+{
+    void ReadFloat(const FJsonObject& Object, const TCHAR* FieldName, float& Value)
+    {
+        double Number = 0.0;
+        if (Object.TryGetNumberField(FieldName, Number))
+        {
+            Value = (float)Number;
+        }
+    }
+
+    bool ReadUnit(const FJsonObject& Object, ETeam Team, const FUnitDefinitionTable* UnitDefinitions, FMatchupUnit& OutUnit, FString& OutError)
+    {
+        FCombatUnitDesc& Desc = OutUnit.Desc;
+        Desc.Team = Team;
+
+        FString DefinitionName;
+        if (Object.TryGetStringField(TEXT("Definition"), DefinitionName))
+        {
+            const int32 DefinitionIndex = UnitDefinitions ? UnitDefinitions->FindIndex(FName(*DefinitionName)) : INDEX_NONE;
+            if (DefinitionIndex == INDEX_NONE)
+            {
+                OutError = FString::Printf(TEXT("Unknown unit definition '%s'"), *DefinitionName);
+                return false;
+            }
+
+            int32 StarLevel = 1;
+            Object.TryGetNumberField(TEXT("StarLevel"), StarLevel);
+            UnitDefinitions->FillCombatUnitDesc(DefinitionIndex, StarLevel, Desc);
+            OutUnit.Name = FString::Printf(TEXT("%s %d*"), *DefinitionName, FStarScaling::ClampStarLevel(StarLevel));
+        }
+
+        Object.TryGetStringField(TEXT("Name"), OutUnit.Name);
+
+        ReadFloat(Object, TEXT("MaxHealth"), Desc.MaxHealth);
+        ReadFloat(Object, TEXT("AttackDamage"), Desc.AttackDamage);
+        ReadFloat(Object, TEXT("AttackSpeed"), Desc.AttackSpeed);
+        ReadFloat(Object, TEXT("AttackRange"), Desc.AttackRange);
+        ReadFloat(Object, TEXT("Armor"), Desc.Armor);
+        ReadFloat(Object, TEXT("MagicResist"), Desc.MagicResist);
+        ReadFloat(Object, TEXT("MaxMana"), Desc.MaxMana);
+        ReadFloat(Object, TEXT("MovementSpeed"), Desc.MovementSpeed);
+        ReadFloat(Object, TEXT("StoppingDistance"), Desc.StoppingDistance);
+
+        int32 RangeHexes = Desc.AttackRangeHexes;
+        if (Object.TryGetNumberField(TEXT("AttackRangeHexes"), RangeHexes))
+        {
+            Desc.AttackRangeHexes = FMath::Max(1, RangeHexes);
+        }
+
+        int32 Cell = INDEX_NONE;
+        if (Object.TryGetNumberField(TEXT("Cell"), Cell))
+        {
+            if (!FHexBoard::IsValidCell(Cell))
+            {
+                OutError = FString::Printf(TEXT("Unit '%s' has cell %d outside the board"), *OutUnit.Name, Cell);
+                return false;
+            }
+            Desc.Cell = Cell;
+        }
+
+        const TArray<TSharedPtr<FJsonValue>>* Position = nullptr;
+        if (Object.TryGetArrayField(TEXT("Position"), Position))
+        {
+            if (Position->Num() != 2)
+            {
+                OutError = FString::Printf(TEXT("Unit '%s' needs a two-element Position"), *OutUnit.Name);
+                return false;
+            }
+            Desc.Position = FVector2f((float)(*Position)[0]->AsNumber(), (float)(*Position)[1]->AsNumber());
+        }
+
+        if (Desc.MaxHealth <= 0.0f || Desc.AttackSpeed <= 0.0f)
+        {
+            OutError = FString::Printf(TEXT("Unit '%s' needs positive MaxHealth and AttackSpeed"), *OutUnit.Name);
+            return false;
+        }
+
+        return true;
+    }
+}
+
+bool FMatchupDefinition::LoadFromJson(const FString& JsonText, FMatchupDefinition& OutDefinition, FString& OutError,
+    const FUnitDefinitionTable* UnitDefinitions)
+{
+    using namespace MatchupEvaluatorPrivate;
+
+    OutDefinition = FMatchupDefinition();
+
+    TSharedPtr<FJsonObject> Root;
+    const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
+    if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+    {
+        OutError = FString::Printf(TEXT("Invalid JSON: %s"), *Reader->GetErrorMessage());
+        return false;
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* Teams = nullptr;
+    if (!Root->TryGetArrayField(TEXT("Teams"), Teams) || Teams->Num() != NumTeams)
+    {
+        OutError = FString::Printf(TEXT("Expected a Teams array with %d entries"), NumTeams);
+        return false;
+    }
+
+    static const TCHAR* DefaultTeamNames[NumTeams] = { TEXT("Player"), TEXT("Enemy") };
+    FHexBoard::FCellMask UsedCells = 0;
+
+    for (int32 TeamIndex = 0; TeamIndex < NumTeams; ++TeamIndex)
+    {
+        const TSharedPtr<FJsonObject>* TeamObject = nullptr;
+        const TArray<TSharedPtr<FJsonValue>>* TeamUnits = nullptr;
+
+        if (!(*Teams)[TeamIndex]->TryGetObject(TeamObject)
+            || !(*TeamObject)->TryGetArrayField(TEXT("Units"), TeamUnits) || TeamUnits->Num() == 0)
+        {
+            OutError = FString::Printf(TEXT("Team %d needs a non-empty Units array"), TeamIndex);
+            return false;
+        }
+
+        if (!(*TeamObject)->TryGetStringField(TEXT("Name"), OutDefinition.TeamNames[TeamIndex]))
+        {
+            OutDefinition.TeamNames[TeamIndex] = DefaultTeamNames[TeamIndex];
+        }
+
+        const ETeam Team = TeamIndex == 0 ? ETeam::Player : ETeam::Enemy;
+
+        for (const TSharedPtr<FJsonValue>& UnitValue : *TeamUnits)
+        {
+            const TSharedPtr<FJsonObject>* UnitObject = nullptr;
+            if (!UnitValue->TryGetObject(UnitObject))
+            {
+                OutError = FString::Printf(TEXT("Team %d has a unit that is not an object"), TeamIndex);
+                return false;
+            }
+
+            FMatchupUnit& Unit = OutDefinition.Units.AddDefaulted_GetRef();
+            Unit.Name = FString::Printf(TEXT("%s %d"), *OutDefinition.TeamNames[TeamIndex], OutDefinition.Units.Num() - 1);
+
+            if (!ReadUnit(**UnitObject, Team, UnitDefinitions, Unit, OutError))
+            {
+                return false;
+            }
+
+            if (Unit.Desc.Cell != INDEX_NONE)
+            {
+                if (UsedCells & FHexBoard::GetCellBit(Unit.Desc.Cell))
+                {
+                    OutError = FString::Printf(TEXT("Unit '%s' shares cell %d with another unit"), *Unit.Name, Unit.Desc.Cell);
+                    return false;
+                }
+                UsedCells |= FHexBoard::GetCellBit(Unit.Desc.Cell);
+            }
+        }
+    }
+
+    return true;
+}
+
+// ============================================================================
+// EVALUATION
+// ============================================================================
+
+FMatchupResults FMatchupEvaluator::Run(const FMatchupDefinition& Definition, const FMatchupSettings& Settings)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    const int32 NumFights = FMath::Max(0, Settings.NumFights);
+    const int32 NumUnits = Definition.Units.Num();
+
+    // One slot per fight; nothing is shared between tasks while they run
+    TArray<FFightOutcome> Outcomes;
+    TArray<float> Damage;
+    TArray<uint8> Survived;
+    Outcomes.SetNum(NumFights);
+    Damage.SetNumZeroed(NumFights * NumUnits);
+    Survived.SetNumZeroed(NumFights * NumUnits);
+
+    const int32 NumTasks = FMath::DivideAndRoundUp(NumFights, FightsPerTask);
+
+    ParallelFor(NumTasks, [&](int32 TaskIndex)
+        {
+            FCombatSimulation Simulation(Settings.FixedDeltaTime);
+            TArray<int32> UnitOrder;
+
+            const int32 FirstFight = TaskIndex * FightsPerTask;
+            const int32 LastFight = FMath::Min(FirstFight + FightsPerTask, NumFights);
+
+            for (int32 FightIndex = FirstFight; FightIndex < LastFight; ++FightIndex)
+            {
+                RunFight(Simulation, UnitOrder, Definition, Settings, FightIndex, Outcomes[FightIndex],
+                    Damage.GetData() + FightIndex * NumUnits, Survived.GetData() + FightIndex * NumUnits);
+            }
+        },
+        Settings.bSingleThreaded ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+    // Reduce in fight order so floating point sums do not depend on scheduling
+    FMatchupResults Results;
+    Results.NumFights = NumFights;
+    Results.TotalDamageDealt.SetNumZeroed(NumUnits);
+    Results.Survivals.SetNumZeroed(NumUnits);
+
+    for (int32 FightIndex = 0; FightIndex < NumFights; ++FightIndex)
+    {
+        const FFightOutcome& Outcome = Outcomes[FightIndex];
+
+        if (Outcome.WinningTeam == INDEX_NONE)
+        {
+            ++Results.Draws;
+        }
+        else
+        {
+            ++Results.Wins[Outcome.WinningTeam];
+        }
+
+        Results.Timeouts += Outcome.bTimedOut ? 1 : 0;
+        Results.TotalFightSeconds += Outcome.Steps * (double)Settings.FixedDeltaTime;
+
+        for (int32 UnitIndex = 0; UnitIndex < NumUnits; ++UnitIndex)
+        {
+            Results.TotalDamageDealt[UnitIndex] += Damage[FightIndex * NumUnits + UnitIndex];
+            Results.Survivals[UnitIndex] += Survived[FightIndex * NumUnits + UnitIndex];
+        }
+
+        // Field by field; the struct has padding
+        const int32 OutcomeBits[] = { Outcome.WinningTeam, Outcome.Steps, Outcome.bTimedOut ? 1 : 0 };
+        Results.Checksum = FCrc::MemCrc32(OutcomeBits, sizeof(OutcomeBits), Results.Checksum);
+    }
+
+    Results.Checksum = FCrc::MemCrc32(Damage.GetData(), Damage.Num() * Damage.GetTypeSize(), Results.Checksum);
+    Results.WallSeconds = FPlatformTime::Seconds() - StartTime;
+    return Results;
+}
+
+void FMatchupEvaluator::RecordFight(const FMatchupDefinition& Definition, const FMatchupSettings& Settings, int32 FightIndex, FCombatReplayWriter& Writer)
+{
+    FCombatSimulation Simulation(Settings.FixedDeltaTime);
+    Simulation.SetReplayWriter(&Writer);
+
+    TArray<int32> UnitOrder;
+    TArray<float> Damage;
+    TArray<uint8> Survived;
+    Damage.SetNumZeroed(Definition.Units.Num());
+    Survived.SetNumZeroed(Definition.Units.Num());
+
+    FFightOutcome Outcome;
+    RunFight(Simulation, UnitOrder, Definition, Settings, FightIndex, Outcome, Damage.GetData(), Survived.GetData());
+
+    Writer.RecordEnd(Simulation.GetTickCount());
+}
+
+void FMatchupEvaluator::RunFight(FCombatSimulation& Simulation, TArray<int32>& UnitOrder, const FMatchupDefinition& Definition,
+    const FMatchupSettings& Settings, int32 FightIndex, FFightOutcome& OutOutcome, float* OutDamage, uint8* OutSurvived)
+{
+    // Depends on nothing but the base seed and the fight index
+    FRandomStream Stream((int32)GetFightSeed(Settings, FightIndex));
+
+    const int32 NumUnits = Definition.Units.Num();
+
+    UnitOrder.Reset(NumUnits);
+    for (int32 UnitIndex = 0; UnitIndex < NumUnits; ++UnitIndex)
+    {
+        UnitOrder.Add(UnitIndex);
+    }
+
+    if (Settings.bShuffleUnitOrder)
+    {
+        for (int32 Index = NumUnits - 1; Index > 0; --Index)
+        {
+            UnitOrder.Swap(Index, Stream.RandRange(0, Index));
+        }
+    }
+
+    Simulation.Reset();
+
+    for (const int32 UnitIndex : UnitOrder)
+    {
+        FCombatUnitDesc Desc = Definition.Units[UnitIndex].Desc;
+
+        // Units on the board keep their cell; only free-standing units are jittered
+        if (Desc.Cell == INDEX_NONE && Settings.PositionJitter > 0.0f)
+        {
+            Desc.Position.X += Stream.FRandRange(-Settings.PositionJitter, Settings.PositionJitter);
+            Desc.Position.Y += Stream.FRandRange(-Settings.PositionJitter, Settings.PositionJitter);
+        }
+
+        Simulation.AddUnit(Desc);
+    }
+
+    const int32 MaxSteps = FMath::CeilToInt(Settings.MaxFightSeconds / Settings.FixedDeltaTime);
+
+    OutOutcome.Steps = Simulation.RunToCompletion(MaxSteps);
+    OutOutcome.bTimedOut = !Simulation.IsFinished();
+    OutOutcome.WinningTeam = OutOutcome.bTimedOut ? INDEX_NONE : Simulation.GetWinningTeam();
+
+    // Simulation indices follow UnitOrder; results go back to definition order
+    for (int32 SimIndex = 0; SimIndex < NumUnits; ++SimIndex)
+    {
+        const FCombatUnit& Unit = Simulation.GetUnit(SimIndex);
+        OutDamage[UnitOrder[SimIndex]] = Unit.DamageDealt;
+        OutSurvived[UnitOrder[SimIndex]] = Unit.bIsAlive ? 1 : 0;
+    }
+}
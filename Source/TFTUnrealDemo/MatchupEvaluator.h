@@ -0,0 +1,142 @@
+// MatchupEvaluator.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatSimulation.h"
+
+// Forward declarations
+class FUnitDefinitionTable;
+class FCombatReplayWriter;
+
+// ============================================================================
+// MATCHUP DEFINITION
+// ============================================================================
+
+struct FMatchupUnit
+{
+    FString Name;
+    FCombatUnitDesc Desc;
+};
+
+/**
+ * Two team compositions to fight each other. The first team plays as ETeam::Player,
+ * the second as ETeam::Enemy.
+ *
+ * JSON layout (stat fields are optional and default to AUnitBase's defaults):
+ *
+ *   { "Teams": [
+ *       { "Name": "Blue", "Units": [
+ *           { "Name": "Knight", "MaxHealth": 700, "AttackDamage": 50, "AttackSpeed": 0.7,
+ *             "AttackRange": 150, "AttackRangeHexes": 1, "Armor": 40, "MagicResist": 40,
+ *             "MaxMana": 80, "Cell": 10 },
+ *           { "Name": "Archer", "Position": [ 400, -600 ] },
+ *           { "Definition": "Ranger", "StarLevel": 2, "Cell": 3 } ] },
+ *       { "Name": "Red", "Units": [ ... ] } ] }
+ *
+ * "Cell" places the unit on an FHexBoard cell; "Position" places it off the board.
+ * "Definition" starts from a unit type in an FUnitDefinitionTable; stat fields given
+ * next to it override the definition's.
+ */
+struct TFTUNREALDEMO_API FMatchupDefinition
+{
+    static constexpr int32 NumTeams = 2;
+
+    FString TeamNames[NumTeams];
+    TArray<FMatchupUnit> Units;
+
+    /** Parses the JSON layout above. Returns false and fills OutError on malformed input. */
+    static bool LoadFromJson(const FString& JsonText, FMatchupDefinition& OutDefinition, FString& OutError,
+        const FUnitDefinitionTable* UnitDefinitions = nullptr);
+
+    static int32 GetTeamIndex(ETeam Team) { return Team == ETeam::Player ? 0 : 1; }
+};
+
+// ============================================================================
+// SETTINGS AND RESULTS
+// ============================================================================
+
+struct FMatchupSettings
+{
+    int32 NumFights = 1000;
+    uint32 Seed = 0;
+    float MaxFightSeconds = 60.0f;
+
+    /** Random offset applied per fight to units placed off the board, in world units. */
+    float PositionJitter = 50.0f;
+
+    /** Shuffles the order units are added in per fight, which changes every index-order tie break. */
+    bool bShuffleUnitOrder = true;
+
+    /** Runs every fight on the calling thread. Results are identical either way. */
+    bool bSingleThreaded = false;
+
+    float FixedDeltaTime = FCombatSimulation::DefaultFixedDeltaTime;
+};
+
+struct TFTUNREALDEMO_API FMatchupResults
+{
+    int32 NumFights = 0;
+    int32 Wins[FMatchupDefinition::NumTeams] = {};
+    int32 Draws = 0;
+
+    /** Fights still running after MaxFightSeconds. Counted as draws too. */
+    int32 Timeouts = 0;
+
+    double TotalFightSeconds = 0.0;
+
+    /** Indexed like FMatchupDefinition::Units. */
+    TArray<double> TotalDamageDealt;
+    TArray<int32> Survivals;
+
+    /** CRC of every per-fight outcome. Matches between runs with the same seed and settings. */
+    uint32 Checksum = 0;
+
+    double WallSeconds = 0.0;
+
+    float GetWinRate(int32 TeamIndex) const { return NumFights > 0 ? (float)Wins[TeamIndex] / NumFights : 0.0f; }
+    float GetDrawRate() const { return NumFights > 0 ? (float)Draws / NumFights : 0.0f; }
+    float GetAverageFightSeconds() const { return NumFights > 0 ? (float)(TotalFightSeconds / NumFights) : 0.0f; }
+    float GetAverageDamageDealt(int32 UnitIndex) const { return NumFights > 0 ? (float)(TotalDamageDealt[UnitIndex] / NumFights) : 0.0f; }
+    float GetSurvivalRate(int32 UnitIndex) const { return NumFights > 0 ? (float)Survivals[UnitIndex] / NumFights : 0.0f; }
+};
+
+// ============================================================================
+// MATCHUP EVALUATOR
+// ============================================================================
+
+/**
+ * Monte Carlo evaluation of a matchup on FCombatSimulation. Every fight is seeded from
+ * the base seed and its fight index alone, runs on its own simulation, and writes its
+ * outcome into its own slot. Outcomes are summed in fight order afterwards, so results
+ * are bit-identical for a given seed no matter how many threads ran the fights.
+ */
+class TFTUNREALDEMO_API FMatchupEvaluator
+{
+public:
+    /** Fights handed to one parallel task, which reuses a single simulation for all of them. */
+    static constexpr int32 FightsPerTask = 32;
+
+    static FMatchupResults Run(const FMatchupDefinition& Definition, const FMatchupSettings& Settings);
+
+    /**
+     * Runs fight FightIndex of Run() again on its own and logs it to Writer, so an odd
+     * outcome from a large batch can be replayed and stepped through. The writer's header
+     * should ask for checksums to catch replays that drift.
+     */
+    static void RecordFight(const FMatchupDefinition& Definition, const FMatchupSettings& Settings, int32 FightIndex, FCombatReplayWriter& Writer);
+
+    /** Seed of fight FightIndex's random stream. */
+    static uint32 GetFightSeed(const FMatchupSettings& Settings, int32 FightIndex) { return HashCombine(Settings.Seed, GetTypeHash(FightIndex)); }
+
+private:
+    struct FFightOutcome
+    {
+        int32 WinningTeam = INDEX_NONE;
+        int32 Steps = 0;
+        bool bTimedOut = false;
+    };
+
+    /** Runs fight FightIndex. OutDamage and OutSurvived are indexed like the definition's units. */
+    static void RunFight(FCombatSimulation& Simulation, TArray<int32>& UnitOrder, const FMatchupDefinition& Definition,
+        const FMatchupSettings& Settings, int32 FightIndex, FFightOutcome& OutOutcome, float* OutDamage, uint8* OutSurvived);
+};
@@ -0,0 +1,134 @@
+// MatchupEvaluatorCommandlet.cpp
+
+#include "MatchupEvaluatorCommandlet.h"
+#include "MatchupEvaluator.h"
+#include "UnitDefinitionTable.h"
+#include "CombatReplay.h"
+#include "TFTUnrealDemo.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Async/TaskGraphInterfaces.h"
+
+UMatchupEvaluatorCommandlet::UMatchupEvaluatorCommandlet()
+{
+    IsClient = false;
+    IsEditor = false;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UMatchupEvaluatorCommandlet::Main(const FString& Params)
+{
+    FString MatchupPath;
+    if (!FParse::Value(*Params, TEXT("Matchup="), MatchupPath))
+    {
+        UE_LOG(LogTFTCombat, Error, TEXT("Usage: -run=MatchupEvaluator -Matchup=<file.json> [-Fights=N] [-Seed=N] [-MaxSeconds=S] [-Jitter=U] [-NoShuffle] [-SingleThread] [-Csv=<file.csv>] [-Units=<file.tftunits>] [-RecordFight=N -ReplayOut=<file.tftreplay>]"));
+        return 1;
+    }
+
+    FString JsonText;
+    if (!FFileHelper::LoadFileToString(JsonText, *MatchupPath))
+    {
+        UE_LOG(LogTFTCombat, Error, TEXT("Could not read matchup file %s"), *MatchupPath);
+        return 1;
+    }
+
+    // Unit types referenced by "Definition" come from the cooked table, read without loading any asset
+    FString UnitsPath;
+    if (!FParse::Value(*Params, TEXT("Units="), UnitsPath))
+    {
+        const IConsoleVariable* DefinitionFile = IConsoleManager::Get().FindConsoleVariable(TEXT("TFT.Units.DefinitionFile"));
+        UnitsPath = DefinitionFile ? FPaths::ProjectContentDir() / DefinitionFile->GetString() : FString();
+    }
+
+    FUnitDefinitionTable UnitDefinitions;
+    if (FPaths::FileExists(UnitsPath))
+    {
+        UnitDefinitions.LoadFromFile(*UnitsPath);
+    }
+
+    FMatchupDefinition Definition;
+    FString Error;
+    if (!FMatchupDefinition::LoadFromJson(JsonText, Definition, Error, &UnitDefinitions))
+    {
+        UE_LOG(LogTFTCombat, Error, TEXT("%s: %s"), *MatchupPath, *Error);
+        return 1;
+    }
+
+    FMatchupSettings Settings;
+    Settings.NumFights = 10000;
+    FParse::Value(*Params, TEXT("Fights="), Settings.NumFights);
+    FParse::Value(*Params, TEXT("Seed="), Settings.Seed);
+    FParse::Value(*Params, TEXT("MaxSeconds="), Settings.MaxFightSeconds);
+    FParse::Value(*Params, TEXT("Jitter="), Settings.PositionJitter);
+    Settings.bShuffleUnitOrder = !FParse::Param(*Params, TEXT("NoShuffle"));
+    Settings.bSingleThreaded = FParse::Param(*Params, TEXT("SingleThread"));
+
+    const FMatchupResults Results = FMatchupEvaluator::Run(Definition, Settings);
+
+    // ========================================================================
+    // REPORT
+    // ========================================================================
+
+    const int32 NumThreads = Settings.bSingleThreaded ? 1 : FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+
+    UE_LOG(LogTFTCombat, Display, TEXT("%s vs %s: %d fights, seed %u, %d threads, %.2f s (%.0f fights/s)"),
+        *Definition.TeamNames[0], *Definition.TeamNames[1], Results.NumFights, Settings.Seed, NumThreads,
+        Results.WallSeconds, Results.WallSeconds > 0.0 ? Results.NumFights / Results.WallSeconds : 0.0);
+
+    UE_LOG(LogTFTCombat, Display, TEXT("%s wins %.1f%%, %s wins %.1f%%, draws %.1f%% (%d timed out)"),
+        *Definition.TeamNames[0], Results.GetWinRate(0) * 100.0f,
+        *Definition.TeamNames[1], Results.GetWinRate(1) * 100.0f,
+        Results.GetDrawRate() * 100.0f, Results.Timeouts);
+
+    UE_LOG(LogTFTCombat, Display, TEXT("Average fight length %.2f s, checksum %08x"), Results.GetAverageFightSeconds(), Results.Checksum);
+
+    FString Csv = TEXT("Unit,Team,AverageDamageDealt,SurvivalRate\n");
+
+    for (int32 UnitIndex = 0; UnitIndex < Definition.Units.Num(); ++UnitIndex)
+    {
+        const FMatchupUnit& Unit = Definition.Units[UnitIndex];
+        const FString& TeamName = Definition.TeamNames[FMatchupDefinition::GetTeamIndex(Unit.Desc.Team)];
+
+        UE_LOG(LogTFTCombat, Display, TEXT("  %-24s %-12s damage %10.1f  survives %5.1f%%"),
+            *Unit.Name, *TeamName, Results.GetAverageDamageDealt(UnitIndex), Results.GetSurvivalRate(UnitIndex) * 100.0f);
+
+        Csv += FString::Printf(TEXT("%s,%s,%.3f,%.4f\n"),
+            *Unit.Name, *TeamName, Results.GetAverageDamageDealt(UnitIndex), Results.GetSurvivalRate(UnitIndex));
+    }
+
+    FString CsvPath;
+    if (FParse::Value(*Params, TEXT("Csv="), CsvPath) && !FFileHelper::SaveStringToFile(Csv, *CsvPath))
+    {
+        UE_LOG(LogTFTCombat, Error, TEXT("Could not write %s"), *CsvPath);
+        return 1;
+    }
+
+    // One fight of the batch as a replay log, for stepping through an odd result
+    int32 RecordFightIndex = INDEX_NONE;
+    FString ReplayPath;
+    if (FParse::Value(*Params, TEXT("RecordFight="), RecordFightIndex) && FParse::Value(*Params, TEXT("ReplayOut="), ReplayPath))
+    {
+        TUniquePtr<FArchive> ReplayFile(IFileManager::Get().CreateFileWriter(*ReplayPath));
+        if (!ReplayFile)
+        {
+            UE_LOG(LogTFTCombat, Error, TEXT("Could not write %s"), *ReplayPath);
+            return 1;
+        }
+
+        FCombatReplayHeader Header;
+        Header.FixedDeltaTime = Settings.FixedDeltaTime;
+        Header.Seed = FMatchupEvaluator::GetFightSeed(Settings, RecordFightIndex);
+        Header.ChecksumInterval = FMath::Max(1, FMath::RoundToInt(1.0f / Settings.FixedDeltaTime));
+
+        FCombatReplayWriter Writer(*ReplayFile, Header);
+        FMatchupEvaluator::RecordFight(Definition, Settings, RecordFightIndex, Writer);
+
+        UE_LOG(LogTFTCombat, Display, TEXT("Fight %d written to %s (%lld bytes)"), RecordFightIndex, *ReplayPath, Writer.GetBytesWritten());
+    }
+
+    return 0;
+}
@@ -0,0 +1,33 @@
+// MatchupEvaluatorCommandlet.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MatchupEvaluatorCommandlet.generated.h"
+
+// ============================================================================
+// MATCHUP EVALUATOR COMMANDLET
+// ============================================================================
+
+/**
+ * Runs thousands of seeded headless fights between two team compositions on every core
+ * and reports win rates, average fight length and damage dealt per unit.
+ *
+ * UnrealEditor-Cmd TFTUnrealDemo -run=MatchupEvaluator -Matchup=<file.json>
+ *     [-Fights=10000] [-Seed=0] [-MaxSeconds=60] [-Jitter=50] [-NoShuffle] [-SingleThread] [-Csv=<file.csv>]
+ *     [-Units=<file.tftunits>] [-RecordFight=N -ReplayOut=<file.tftreplay>]
+ *
+ * See FMatchupDefinition for the file layout. -Units defaults to the cooked unit definition
+ * file. The printed checksum is identical for the same inputs whether or not -SingleThread
+ * is passed. -RecordFight writes fight N of the batch as a replay for -run=CombatReplay.
+ */
+UCLASS()
+class UMatchupEvaluatorCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UMatchupEvaluatorCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,56 @@
+// ProjectileStore.cpp
+
+#include "ProjectileStore.h"
+
+void FProjectileStore::Launch(const FVector& Origin, const FVector& Destination, int32 Source, int32 Target,
+    float Speed, float Damage, EDamageType Type, bool bHoming)
+{
+    Locations.Add(Origin);
+    Destinations.Add(Destination);
+    Speeds.Add(FMath::Max(Speed, 1.0f));
+    Damages.Add(Damage);
+    Sources.Add(Source);
+    Targets.Add(Target);
+    Types.Add(Type);
+    Homing.Add(bHoming && Target != INDEX_NONE);
+}
+
+void FProjectileStore::RemoveUnit(int32 Unit)
+{
+    if (Unit == INDEX_NONE)
+    {
+        return;
+    }
+
+    for (int32 Index = Locations.Num() - 1; Index >= 0; --Index)
+    {
+        if (Sources[Index] == Unit || Targets[Index] == Unit)
+        {
+            RemoveAtSwap(Index);
+        }
+    }
+}
+
+void FProjectileStore::Reset()
+{
+    Locations.Reset();
+    Destinations.Reset();
+    Speeds.Reset();
+    Damages.Reset();
+    Sources.Reset();
+    Targets.Reset();
+    Types.Reset();
+    Homing.Reset();
+}
+
+void FProjectileStore::RemoveAtSwap(int32 Index)
+{
+    Locations.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Destinations.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Speeds.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Damages.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Sources.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Targets.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Types.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Homing.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
@@ -0,0 +1,107 @@
+// ProjectileStore.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatTypes.h"
+
+// ============================================================================
+// IMPACTS
+// ============================================================================
+
+/** A projectile that reached its destination this frame. Units are referenced by handle. */
+struct FProjectileImpact
+{
+    FVector Location = FVector::ZeroVector;
+    int32 Source = INDEX_NONE;
+    int32 Target = INDEX_NONE;
+    float Damage = 0.0f;
+    EDamageType Type = EDamageType::Physical;
+
+    /** Followed its target all the way; otherwise it flew to a fixed point and can miss. */
+    bool bHoming = false;
+};
+
+// ============================================================================
+// PROJECTILE STORE
+// ============================================================================
+
+/**
+ * Every projectile in flight as parallel flat arrays, advanced together in one loop.
+ * There is no per-projectile object: launching appends a slot, arriving swap-removes
+ * it, so the cost of a frame is one pass over the live projectiles and nothing else.
+ */
+class TFTUNREALDEMO_API FProjectileStore
+{
+public:
+    /** Adds a projectile at Origin flying to Destination, or after Target when bHoming. Source and Target are unit handles. */
+    void Launch(const FVector& Origin, const FVector& Destination, int32 Source, int32 Target,
+        float Speed, float Damage, EDamageType Type, bool bHoming);
+
+    /** Drops every projectile fired by or at Unit. */
+    void RemoveUnit(int32 Unit);
+
+    void Reset();
+
+    int32 Num() const { return Locations.Num(); }
+
+    TConstArrayView<FVector> GetLocations() const { return Locations; }
+    TConstArrayView<FVector> GetDestinations() const { return Destinations; }
+
+    /**
+     * Moves every projectile DeltaTime forward. Homing projectiles first ask
+     * GetTargetLocation(int32 Target, FVector& OutLocation) for their target; when it returns
+     * false they stop homing and finish the flight to where the target was last seen.
+     * Arrivals are removed and appended to OutImpacts.
+     */
+    template <typename GetTargetLocationFuncType>
+    void Advance(float DeltaTime, GetTargetLocationFuncType&& GetTargetLocation, TArray<FProjectileImpact>& OutImpacts);
+
+private:
+    void RemoveAtSwap(int32 Index);
+
+    TArray<FVector> Locations;
+    TArray<FVector> Destinations;
+    TArray<float> Speeds;
+    TArray<float> Damages;
+    TArray<int32> Sources;
+    TArray<int32> Targets;
+    TArray<EDamageType> Types;
+    TArray<bool> Homing;
+};
+
+// ============================================================================
+// TEMPLATE IMPLEMENTATION
+// ============================================================================
+
+template <typename GetTargetLocationFuncType>
+void FProjectileStore::Advance(float DeltaTime, GetTargetLocationFuncType&& GetTargetLocation, TArray<FProjectileImpact>& OutImpacts)
+{
+    // Backwards, so a swap-remove only moves an already advanced projectile into the slot
+    for (int32 Index = Locations.Num() - 1; Index >= 0; --Index)
+    {
+        if (Homing[Index] && !GetTargetLocation(Targets[Index], Destinations[Index]))
+        {
+            Homing[Index] = false;
+        }
+
+        const FVector ToDestination = Destinations[Index] - Locations[Index];
+        const float DistanceSq = ToDestination.SizeSquared();
+        const float Step = Speeds[Index] * DeltaTime;
+
+        if (DistanceSq > FMath::Square(Step))
+        {
+            Locations[Index] += ToDestination * (Step * FMath::InvSqrt(DistanceSq));
+            continue;
+        }
+
+        FProjectileImpact& Impact = OutImpacts.AddDefaulted_GetRef();
+        Impact.Location = Destinations[Index];
+        Impact.Source = Sources[Index];
+        Impact.Target = Targets[Index];
+        Impact.Damage = Damages[Index];
+        Impact.Type = Types[Index];
+        Impact.bHoming = Homing[Index];
+
+        RemoveAtSwap(Index);
+    }
+}
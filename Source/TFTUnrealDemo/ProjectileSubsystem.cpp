@@ -0,0 +1,262 @@
+// ProjectileSubsystem.cpp
+
+#include "ProjectileSubsystem.h"
+#include "CombatDamageSubsystem.h"
+#include "CombatReplicationSubsystem.h"
+#include "CombatStats.h"
+#include "UnitBase.h"
+#include "UnitRegistrySubsystem.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+// ============================================================================
+// CONSOLE VARIABLES
+// ============================================================================
+
+static bool GProjectileVisuals = true;
+static FAutoConsoleVariableRef CVarProjectileVisuals(
+    TEXT("TFT.Projectile.Visuals"),
+    GProjectileVisuals,
+    TEXT("Draw projectiles in flight. Impacts and damage are unaffected."));
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+void UProjectileSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    UnitRegistry = Collection.InitializeDependency<UUnitRegistrySubsystem>();
+    DamageSubsystem = Collection.InitializeDependency<UCombatDamageSubsystem>();
+    NetReplication = Collection.InitializeDependency<UCombatReplicationSubsystem>();
+    VisualActor = nullptr;
+    VisualInstances = nullptr;
+    ProjectileMesh = nullptr;
+}
+
+void UProjectileSubsystem::Deinitialize()
+{
+    Store.Reset();
+    Impacts.Reset();
+    InstanceTransforms.Reset();
+    UnitRegistry = nullptr;
+    DamageSubsystem = nullptr;
+    NetReplication = nullptr;
+    VisualActor = nullptr;
+    VisualInstances = nullptr;
+    NumVisibleInstances = 0;
+
+    Super::Deinitialize();
+}
+
+TStatId UProjectileSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UProjectileSubsystem, STATGROUP_Tickables);
+}
+
+bool UProjectileSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+// ============================================================================
+// LAUNCHING
+// ============================================================================
+
+bool UProjectileSubsystem::LaunchProjectile(AUnitBase* Source, AUnitBase* Target, float Damage, EDamageType DamageType, float Speed, bool bHoming)
+{
+    if (!Source || !Target || !Target->bIsAlive || !Source->HasAuthority() || Target->GetUnitHandle() == INDEX_NONE)
+    {
+        return false;
+    }
+
+    Store.Launch(Source->GetActorLocation(), Target->GetActorLocation(), Source->GetUnitHandle(), Target->GetUnitHandle(),
+        Speed, Damage, DamageType, bHoming);
+
+    if (NetReplication)
+    {
+        NetReplication->NotifyProjectileLaunched(Source, Target, Speed, bHoming);
+    }
+    return true;
+}
+
+void UProjectileSubsystem::LaunchCosmeticProjectile(const FVector& Origin, AUnitBase* Target, float Speed, bool bHoming)
+{
+    if (!GProjectileVisuals || !Target || Target->GetUnitHandle() == INDEX_NONE)
+    {
+        return;
+    }
+
+    // No source and no damage; impacts are never delivered on clients anyway
+    Store.Launch(Origin, Target->GetActorLocation(), INDEX_NONE, Target->GetUnitHandle(), Speed, 0.0f, EDamageType::Physical, bHoming);
+}
+
+// ============================================================================
+// TICK
+// ============================================================================
+
+void UProjectileSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    // Nothing in flight and nothing left on screen
+    if (Store.Num() == 0 && NumVisibleInstances == 0)
+    {
+        return;
+    }
+
+    TFT_COMBAT_FRAME_SCOPE(Projectiles);
+
+    Impacts.Reset();
+    Store.Advance(DeltaTime,
+        [this](int32 Handle, FVector& OutLocation)
+        {
+            const AUnitBase* Target = UnitRegistry ? UnitRegistry->GetUnit(Handle) : nullptr;
+            if (!Target || !Target->bIsAlive)
+            {
+                return false;
+            }
+
+            OutLocation = Target->GetActorLocation();
+            return true;
+        },
+        Impacts);
+
+    // Clients only fly cosmetic copies; the server's impacts deal the damage
+    if (GetWorld()->GetNetMode() != NM_Client)
+    {
+        DeliverImpacts();
+    }
+    UpdateVisuals();
+}
+
+void UProjectileSubsystem::DeliverImpacts()
+{
+    if (!UnitRegistry)
+    {
+        return;
+    }
+
+    for (const FProjectileImpact& Impact : Impacts)
+    {
+        // The target died, or stepped out of a fixed-point shot
+        AUnitBase* Target = UnitRegistry->GetUnit(Impact.Target);
+        if (!Target || !Target->bIsAlive)
+        {
+            continue;
+        }
+        if (!Impact.bHoming && FVector::DistSquared(Target->GetActorLocation(), Impact.Location) > FMath::Square(HitRadius))
+        {
+            continue;
+        }
+
+        // The shooter may have died since; its shot still lands
+        AUnitBase* Source = UnitRegistry->GetUnit(Impact.Source);
+        if (!DamageSubsystem || !DamageSubsystem->QueueDamage(Source, Target, Impact.Damage, Impact.Type))
+        {
+            Target->TakeDamage(FDamageInfo(Impact.Damage, Impact.Type, Source));
+        }
+    }
+}
+
+// ============================================================================
+// VISUALS
+// ============================================================================
+
+void UProjectileSubsystem::SetProjectileMesh(UStaticMesh* Mesh, float Scale)
+{
+    ProjectileMesh = Mesh;
+    ProjectileScale = Scale;
+
+    if (VisualInstances)
+    {
+        VisualInstances->SetStaticMesh(ProjectileMesh);
+    }
+}
+
+UInstancedStaticMeshComponent* UProjectileSubsystem::GetVisualInstances()
+{
+    if (VisualInstances)
+    {
+        return VisualInstances;
+    }
+
+    if (!GProjectileVisuals || GetWorld()->GetNetMode() == NM_DedicatedServer)
+    {
+        return nullptr;
+    }
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.ObjectFlags |= RF_Transient;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+    VisualActor = GetWorld()->SpawnActor<AActor>(SpawnParams);
+    if (!VisualActor)
+    {
+        return nullptr;
+    }
+
+    if (!ProjectileMesh)
+    {
+        ProjectileMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Sphere.Sphere"));
+    }
+
+    VisualInstances = NewObject<UInstancedStaticMeshComponent>(VisualActor);
+    VisualInstances->SetMobility(EComponentMobility::Movable);
+    VisualInstances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    VisualInstances->SetCastShadow(false);
+    VisualInstances->SetStaticMesh(ProjectileMesh);
+    VisualActor->SetRootComponent(VisualInstances);
+    VisualInstances->RegisterComponent();
+
+    return VisualInstances;
+}
+
+void UProjectileSubsystem::UpdateVisuals()
+{
+    UInstancedStaticMeshComponent* Instances = GetVisualInstances();
+    if (!Instances)
+    {
+        return;
+    }
+
+    // Instance i is projectile i; the store's swap-removes reorder both alike
+    const TConstArrayView<FVector> Locations = Store.GetLocations();
+    const TConstArrayView<FVector> Destinations = Store.GetDestinations();
+    const FVector Scale(ProjectileScale);
+    const int32 NumLive = Locations.Num();
+    const int32 NumToUpdate = FMath::Max(NumLive, NumVisibleInstances);
+
+    InstanceTransforms.Reset(NumToUpdate);
+    for (int32 Index = 0; Index < NumLive; ++Index)
+    {
+        const FRotator Facing = (Destinations[Index] - Locations[Index]).Rotation();
+        InstanceTransforms.Emplace(Facing, Locations[Index], Scale);
+    }
+
+    // Instances freed since last frame collapse to zero scale instead of being removed
+    const FTransform Hidden(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector);
+    for (int32 Index = NumLive; Index < NumToUpdate; ++Index)
+    {
+        InstanceTransforms.Add(Hidden);
+    }
+
+    // The instance count only grows, to the most projectiles ever in flight at once
+    const int32 NumInstances = Instances->GetInstanceCount();
+    if (NumLive > NumInstances)
+    {
+        TArray<FTransform> NewInstances;
+        NewInstances.Init(Hidden, NumLive - NumInstances);
+        Instances->AddInstances(NewInstances, false, true);
+    }
+
+    if (NumToUpdate > 0)
+    {
+        Instances->BatchUpdateInstancesTransforms(0, InstanceTransforms, true, true, true);
+    }
+
+    NumVisibleInstances = NumLive;
+}
@@ -0,0 +1,106 @@
+// ProjectileSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ProjectileStore.h"
+#include "ProjectileSubsystem.generated.h"
+
+// Forward declarations
+class AUnitBase;
+class UUnitRegistrySubsystem;
+class UCombatDamageSubsystem;
+class UCombatReplicationSubsystem;
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+
+// ============================================================================
+// PROJECTILE SUBSYSTEM
+// ============================================================================
+
+/**
+ * Ranged auto attacks and ability projectiles without actors. Flights live in an
+ * FProjectileStore and advance in one batch per frame; arrivals queue their damage with
+ * the damage subsystem like any other hit. Every projectile is drawn as one instance of
+ * a single instanced static mesh, so thousands in flight cost one draw call and one
+ * transform upload. Damage is simulated on the server only; launches are multicast through
+ * the board's ABoardCombatState and clients fly damage-free copies for the visuals.
+ * Dedicated servers skip the visuals.
+ */
+UCLASS()
+class TFTUNREALDEMO_API UProjectileSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** Fixed-point projectiles hit when the target is within this distance of the landing point. */
+    static constexpr float HitRadius = 60.0f;
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // ========================================================================
+    // LAUNCHING
+    // ========================================================================
+
+    /**
+     * Fires a projectile from Source at Target. Homing projectiles always land unless the
+     * target dies first; the others fly to where the target stood at launch and can be dodged.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Projectiles")
+    bool LaunchProjectile(AUnitBase* Source, AUnitBase* Target, float Damage, EDamageType DamageType, float Speed, bool bHoming = true);
+
+    /** Client side of a replicated launch: the same flight, drawn but never dealing damage. */
+    void LaunchCosmeticProjectile(const FVector& Origin, AUnitBase* Target, float Speed, bool bHoming);
+
+    /** Drops every projectile fired by or at the unit, e.g. when it is reset or returned to the pool. */
+    void RemoveUnit(int32 Handle) { Store.RemoveUnit(Handle); }
+
+    UFUNCTION(BlueprintPure, Category = "Projectiles")
+    int32 GetNumProjectiles() const { return Store.Num(); }
+
+    // ========================================================================
+    // VISUALS
+    // ========================================================================
+
+    /** Mesh and uniform scale every projectile is drawn with. Defaults to a small engine sphere. */
+    UFUNCTION(BlueprintCallable, Category = "Projectiles")
+    void SetProjectileMesh(UStaticMesh* Mesh, float Scale = 0.2f);
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    void DeliverImpacts();
+    void UpdateVisuals();
+    UInstancedStaticMeshComponent* GetVisualInstances();
+
+    UPROPERTY()
+    UUnitRegistrySubsystem* UnitRegistry;
+
+    UPROPERTY()
+    UCombatDamageSubsystem* DamageSubsystem;
+
+    UPROPERTY()
+    UCombatReplicationSubsystem* NetReplication;
+
+    /** Transient actor owning the instanced mesh, spawned with the first visible projectile. */
+    UPROPERTY()
+    AActor* VisualActor;
+
+    UPROPERTY()
+    UInstancedStaticMeshComponent* VisualInstances;
+
+    UPROPERTY()
+    UStaticMesh* ProjectileMesh;
+
+    FProjectileStore Store;
+    TArray<FProjectileImpact> Impacts;
+    TArray<FTransform> InstanceTransforms;
+
+    /** Instances drawn last frame. Instances are never removed; the ones past this are collapsed. */
+    int32 NumVisibleInstances = 0;
+    float ProjectileScale = 0.2f;
+};
@@ -0,0 +1,195 @@
+// StarCombineSubsystem.cpp
+
+#include "StarCombineSubsystem.h"
+#include "UnitBase.h"
+#include "UnitPoolSubsystem.h"
+#include "StarScaling.h"
+#include "TFTUnrealDemo.h"
+#include "Engine/World.h"
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+void UStarCombineSubsystem::Deinitialize()
+{
+    Groups.Reset();
+    UnitGroups.Reset();
+    DirtyGroups.Reset();
+
+    Super::Deinitialize();
+}
+
+TStatId UStarCombineSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UStarCombineSubsystem, STATGROUP_Tickables);
+}
+
+bool UStarCombineSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+// ============================================================================
+// TRACKING
+// ============================================================================
+
+UStarCombineSubsystem::FGroupKey UStarCombineSubsystem::MakeKey(const AUnitBase* Unit)
+{
+    FGroupKey Key;
+    Key.UnitType = Unit->GetUnitTypeName();
+    Key.StarLevel = Unit->StarLevel;
+    return Key;
+}
+
+void UStarCombineSubsystem::AddUnit(AUnitBase* Unit)
+{
+    if (!Unit)
+    {
+        return;
+    }
+
+    const FGroupKey Key = MakeKey(Unit);
+
+    if (const FGroupKey* OldKey = UnitGroups.Find(Unit))
+    {
+        if (*OldKey == Key)
+        {
+            return;
+        }
+        RemoveUnit(Unit);
+    }
+
+    TArray<AUnitBase*>& Copies = Groups.FindOrAdd(Key);
+    Copies.Add(Unit);
+    UnitGroups.Add(Unit, Key);
+
+    if (Copies.Num() >= FStarScaling::CopiesPerCombine)
+    {
+        MarkDirty(Key);
+    }
+}
+
+void UStarCombineSubsystem::RemoveUnit(AUnitBase* Unit)
+{
+    FGroupKey Key;
+    if (!UnitGroups.RemoveAndCopyValue(Unit, Key))
+    {
+        return;
+    }
+
+    if (TArray<AUnitBase*>* Copies = Groups.Find(Key))
+    {
+        Copies->RemoveSingleSwap(Unit, EAllowShrinking::No);
+    }
+}
+
+void UStarCombineSubsystem::NotifyLeftCombat(AUnitBase* Unit)
+{
+    const FGroupKey* Key = UnitGroups.Find(Unit);
+    const TArray<AUnitBase*>* Copies = Key ? Groups.Find(*Key) : nullptr;
+
+    if (Copies && Copies->Num() >= FStarScaling::CopiesPerCombine)
+    {
+        MarkDirty(*Key);
+    }
+}
+
+int32 UStarCombineSubsystem::GetCopyCount(FName UnitType, int32 StarLevel) const
+{
+    FGroupKey Key;
+    Key.UnitType = UnitType;
+    Key.StarLevel = StarLevel;
+
+    const TArray<AUnitBase*>* Copies = Groups.Find(Key);
+    return Copies ? Copies->Num() : 0;
+}
+
+void UStarCombineSubsystem::MarkDirty(const FGroupKey& Key)
+{
+    if (Key.StarLevel < FStarScaling::MaxStarLevel)
+    {
+        DirtyGroups.AddUnique(Key);
+    }
+}
+
+// ============================================================================
+// COMBINING
+// ============================================================================
+
+void UStarCombineSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    // Index loop: a combine can mark the next star's group dirty and it is handled this update
+    for (int32 Index = 0; Index < DirtyGroups.Num(); ++Index)
+    {
+        const FGroupKey Key = DirtyGroups[Index];
+        while (TryCombineGroup(Key))
+        {
+        }
+    }
+
+    DirtyGroups.Reset();
+}
+
+bool UStarCombineSubsystem::TryCombineGroup(const FGroupKey& Key)
+{
+    TArray<AUnitBase*>* Copies = Groups.Find(Key);
+    if (!Copies || Copies->Num() < FStarScaling::CopiesPerCombine)
+    {
+        return false;
+    }
+
+    // Copies fighting this round are left alone until they leave combat
+    TArray<AUnitBase*, TInlineAllocator<FStarScaling::CopiesPerCombine>> Merging;
+    for (AUnitBase* Unit : *Copies)
+    {
+        if (IsValid(Unit) && Unit->GetState() != EUnitState::Combat)
+        {
+            Merging.Add(Unit);
+            if (Merging.Num() == FStarScaling::CopiesPerCombine)
+            {
+                break;
+            }
+        }
+    }
+
+    if (Merging.Num() < FStarScaling::CopiesPerCombine)
+    {
+        return false;
+    }
+
+    // Keep a copy that is already on the board so the upgrade stays where the player put it
+    const int32 KeptIndex = Merging.IndexOfByPredicate([](const AUnitBase* Unit) { return Unit->GetState() == EUnitState::BoardIdle; });
+    AUnitBase* Kept = Merging[FMath::Max(KeptIndex, 0)];
+
+    UUnitPoolSubsystem* Pool = GetWorld()->GetSubsystem<UUnitPoolSubsystem>();
+
+    for (AUnitBase* Unit : Merging)
+    {
+        RemoveUnit(Unit);
+
+        if (Unit == Kept)
+        {
+            continue;
+        }
+
+        if (Pool)
+        {
+            Pool->ReleaseUnit(Unit);
+        }
+        else
+        {
+            Unit->Destroy();
+        }
+    }
+
+    // Re-adds the kept copy to the next star's group, which may complete another set
+    Kept->SetStarLevel(Key.StarLevel + 1);
+    ++NumCombines;
+
+    UE_LOG(LogTFTCombat, Log, TEXT("⭐ Combined three %s into a %d-star"), *Key.UnitType.ToString(), Kept->StarLevel);
+    OnUnitsCombined.Broadcast(Kept, Kept->StarLevel);
+    return true;
+}
@@ -0,0 +1,82 @@
+// StarCombineSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "StarCombineSubsystem.generated.h"
+
+// Forward declarations
+class AUnitBase;
+
+// ============================================================================
+// STAR COMBINE SUBSYSTEM
+// ============================================================================
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnUnitsCombined, AUnitBase*, CombinedUnit, int32, NewStarLevel);
+
+/**
+ * Keeps a running count of the player's copies per unit type and star level. Units
+ * report themselves when they join, leave or change star, so noticing a third copy is a
+ * counter check instead of a scan over the bench and board. Groups that reach
+ * FStarScaling::CopiesPerCombine are merged on the next update: one copy (a board unit
+ * if there is one) goes up a star, the others return to the unit pool. Copies still in
+ * combat wait until the round ends.
+ */
+UCLASS()
+class TFTUNREALDEMO_API UStarCombineSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // ========================================================================
+    // TRACKING
+    // ========================================================================
+
+    /** Counts the unit as an owned copy, or moves it to its new group after a type or star change. */
+    void AddUnit(AUnitBase* Unit);
+
+    void RemoveUnit(AUnitBase* Unit);
+
+    /** Copies held back by combat can merge now. */
+    void NotifyLeftCombat(AUnitBase* Unit);
+
+    UFUNCTION(BlueprintPure, Category = "Star Combine")
+    int32 GetCopyCount(FName UnitType, int32 StarLevel) const;
+
+    UFUNCTION(BlueprintPure, Category = "Star Combine")
+    int32 GetNumCombines() const { return NumCombines; }
+
+    UPROPERTY(BlueprintAssignable, Category = "Star Combine")
+    FOnUnitsCombined OnUnitsCombined;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FGroupKey
+    {
+        FName UnitType;
+        int32 StarLevel = 0;
+
+        bool operator==(const FGroupKey& Other) const { return UnitType == Other.UnitType && StarLevel == Other.StarLevel; }
+        friend uint32 GetTypeHash(const FGroupKey& Key) { return HashCombine(GetTypeHash(Key.UnitType), GetTypeHash(Key.StarLevel)); }
+    };
+
+    static FGroupKey MakeKey(const AUnitBase* Unit);
+
+    void MarkDirty(const FGroupKey& Key);
+    bool TryCombineGroup(const FGroupKey& Key);
+
+    /** Owned copies per unit type and star level. */
+    TMap<FGroupKey, TArray<AUnitBase*>> Groups;
+    TMap<AUnitBase*, FGroupKey> UnitGroups;
+
+    /** Groups that reached a full set since the last update. */
+    TArray<FGroupKey> DirtyGroups;
+
+    int32 NumCombines = 0;
+};
@@ -0,0 +1,106 @@
+// StarScaling.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+// ============================================================================
+// STAR SCALING
+// ============================================================================
+
+/**
+ * Star-level stat rules. Three copies of a unit at one star combine into one copy at the
+ * next star, which multiplies health by HealthGrowth and attack damage by DamageGrowth.
+ * Other stats do not change with stars.
+ *
+ * Every multiplier is folded into a table at compile time, so a star-up is a multiply
+ * by a constant: GetHealthMultiplier<3>() is a literal, GetHealthMultiplier(Star) an
+ * array read.
+ */
+struct FStarScaling
+{
+    static constexpr int32 MaxStarLevel = 3;
+    static constexpr int32 CopiesPerCombine = 3;
+
+    static constexpr float HealthGrowth = 1.8f;
+    static constexpr float DamageGrowth = 1.5f;
+
+    /** Growth^(StarLevel - 1), evaluated by the compiler. */
+    static constexpr float ComputeMultiplier(float Growth, int32 StarLevel)
+    {
+        float Result = 1.0f;
+        for (int32 Star = 1; Star < StarLevel; ++Star)
+        {
+            Result *= Growth;
+        }
+        return Result;
+    }
+
+    struct FTable
+    {
+        float Health[MaxStarLevel + 1] = {};
+        float Damage[MaxStarLevel + 1] = {};
+    };
+
+    static constexpr FTable BuildTable()
+    {
+        FTable Result;
+        for (int32 Star = 1; Star <= MaxStarLevel; ++Star)
+        {
+            Result.Health[Star] = ComputeMultiplier(HealthGrowth, Star);
+            Result.Damage[Star] = ComputeMultiplier(DamageGrowth, Star);
+        }
+        return Result;
+    }
+
+    static constexpr int32 ClampStarLevel(int32 StarLevel)
+    {
+        return StarLevel < 1 ? 1 : (StarLevel > MaxStarLevel ? MaxStarLevel : StarLevel);
+    }
+
+    template <int32 StarLevel>
+    static constexpr float GetHealthMultiplier()
+    {
+        static_assert(StarLevel >= 1 && StarLevel <= MaxStarLevel, "Star level out of range");
+        return ComputeMultiplier(HealthGrowth, StarLevel);
+    }
+
+    template <int32 StarLevel>
+    static constexpr float GetDamageMultiplier()
+    {
+        static_assert(StarLevel >= 1 && StarLevel <= MaxStarLevel, "Star level out of range");
+        return ComputeMultiplier(DamageGrowth, StarLevel);
+    }
+
+    static float GetHealthMultiplier(int32 StarLevel);
+    static float GetDamageMultiplier(int32 StarLevel);
+
+    /** Copies of a unit at one star that add up to a single copy at TargetStarLevel. */
+    static constexpr int32 GetCopiesForStarLevel(int32 TargetStarLevel)
+    {
+        int32 Copies = 1;
+        for (int32 Star = 1; Star < TargetStarLevel; ++Star)
+        {
+            Copies *= CopiesPerCombine;
+        }
+        return Copies;
+    }
+};
+
+namespace StarScalingPrivate
+{
+    inline constexpr FStarScaling::FTable Table = FStarScaling::BuildTable();
+
+    static_assert(Table.Health[1] == 1.0f && Table.Damage[1] == 1.0f, "One star is the authored baseline");
+    static_assert(Table.Health[2] == FStarScaling::HealthGrowth && Table.Damage[2] == FStarScaling::DamageGrowth, "Growth is per star");
+    static_assert(FStarScaling::GetCopiesForStarLevel(FStarScaling::MaxStarLevel) == 9, "A three star unit is nine one star copies");
+}
+
+FORCEINLINE float FStarScaling::GetHealthMultiplier(int32 StarLevel)
+{
+    return StarScalingPrivate::Table.Health[ClampStarLevel(StarLevel)];
+}
+
+FORCEINLINE float FStarScaling::GetDamageMultiplier(int32 StarLevel)
+{
+    return StarScalingPrivate::Table.Damage[ClampStarLevel(StarLevel)];
+}
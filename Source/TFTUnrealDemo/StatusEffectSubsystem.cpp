@@ -0,0 +1,118 @@
+// StatusEffectSubsystem.cpp
+
+#include "StatusEffectSubsystem.h"
+#include "UnitRegistrySubsystem.h"
+#include "UnitBase.h"
+#include "CombatStats.h"
+#include "Engine/World.h"
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+void UStatusEffectSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    UnitRegistry = Collection.InitializeDependency<UUnitRegistrySubsystem>();
+}
+
+void UStatusEffectSubsystem::Deinitialize()
+{
+    Store.Reset();
+    DirtyUnits.Reset();
+    UnitRegistry = nullptr;
+
+    Super::Deinitialize();
+}
+
+TStatId UStatusEffectSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UStatusEffectSubsystem, STATGROUP_Tickables);
+}
+
+bool UStatusEffectSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+// ============================================================================
+// EFFECTS
+// ============================================================================
+
+int32 UStatusEffectSubsystem::ApplyEffect(AUnitBase* Target, const FStatusEffectSpec& Spec, AUnitBase* Source)
+{
+    if (!Target || !Target->bIsAlive || Target->GetUnitHandle() == INDEX_NONE || !Target->HasAuthority())
+    {
+        return 0;
+    }
+
+    const uint32 EffectId = Store.Add(Target->GetUnitHandle(), Spec, Source ? Source->GetUnitHandle() : INDEX_NONE);
+
+    // Stuns and slows take hold immediately rather than at the next tick
+    ApplyDirtyModifiers();
+    return (int32)EffectId;
+}
+
+bool UStatusEffectSubsystem::RemoveEffect(AUnitBase* Target, int32 EffectId)
+{
+    if (!Target || !Store.Remove(Target->GetUnitHandle(), (uint32)EffectId))
+    {
+        return false;
+    }
+
+    ApplyDirtyModifiers();
+    return true;
+}
+
+void UStatusEffectSubsystem::ClearEffects(int32 Handle)
+{
+    Store.ClearUnit(Handle);
+    ApplyDirtyModifiers();
+}
+
+float UStatusEffectSubsystem::GetShield(const AUnitBase* Unit) const
+{
+    return Unit ? Store.GetShield(Unit->GetUnitHandle()) : 0.0f;
+}
+
+int32 UStatusEffectSubsystem::GetNumEffects(const AUnitBase* Unit) const
+{
+    return Unit ? Store.NumEffects(Unit->GetUnitHandle()) : 0;
+}
+
+// ============================================================================
+// TICK
+// ============================================================================
+
+void UStatusEffectSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+    TFT_COMBAT_FRAME_SCOPE(StatusEffects);
+
+    Store.Advance(DeltaTime, [this](int32 Handle, int32 SourceHandle, float Amount, EDamageType DamageType)
+        {
+            AUnitBase* Unit = UnitRegistry ? UnitRegistry->GetUnit(Handle) : nullptr;
+            if (Unit && Unit->bIsAlive)
+            {
+                Unit->TakeDamage(FDamageInfo(Amount, DamageType, UnitRegistry->GetUnit(SourceHandle)));
+            }
+        });
+
+    ApplyDirtyModifiers();
+}
+
+void UStatusEffectSubsystem::ApplyDirtyModifiers()
+{
+    Store.ConsumeDirtyUnits(DirtyUnits);
+
+    for (const int32 Handle : DirtyUnits)
+    {
+        if (AUnitBase* Unit = UnitRegistry ? UnitRegistry->GetUnit(Handle) : nullptr)
+        {
+            FStatusModifiers Modifiers;
+            Store.ComputeModifiers(Handle, Modifiers);
+            Unit->SetStatusModifiers(Modifiers);
+        }
+    }
+}
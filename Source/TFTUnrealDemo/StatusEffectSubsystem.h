@@ -0,0 +1,69 @@
+// StatusEffectSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "StatusEffects.h"
+#include "StatusEffectSubsystem.generated.h"
+
+// Forward declarations
+class AUnitBase;
+class UUnitRegistrySubsystem;
+
+// ============================================================================
+// STATUS EFFECT SUBSYSTEM
+// ============================================================================
+
+/**
+ * Stuns, slows, shields, buffs and damage over time for units in play. Effects live in
+ * an FStatusEffectStore keyed by registry handle. When a unit's effects change, its
+ * final stats are recomputed once and written to the unit stat store, which is what
+ * damage reduction and auto attacks read; a frame with no expiries costs one heap peek.
+ */
+UCLASS()
+class TFTUNREALDEMO_API UStatusEffectSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // ========================================================================
+    // EFFECTS
+    // ========================================================================
+
+    /** Applies Spec to Target and returns an id for RemoveEffect, or 0 if Target is not in play. */
+    UFUNCTION(BlueprintCallable, Category = "Status Effects")
+    int32 ApplyEffect(AUnitBase* Target, const FStatusEffectSpec& Spec, AUnitBase* Source);
+
+    UFUNCTION(BlueprintCallable, Category = "Status Effects")
+    bool RemoveEffect(AUnitBase* Target, int32 EffectId);
+
+    /** Drops every effect on the unit, e.g. on death, reset or return to the pool. */
+    void ClearEffects(int32 Handle);
+
+    /** Takes Damage out of the unit's shields and returns what is left for health. */
+    float AbsorbDamage(int32 Handle, float Damage) { return Store.AbsorbDamage(Handle, Damage); }
+
+    UFUNCTION(BlueprintPure, Category = "Status Effects")
+    float GetShield(const AUnitBase* Unit) const;
+
+    UFUNCTION(BlueprintPure, Category = "Status Effects")
+    int32 GetNumEffects(const AUnitBase* Unit) const;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    /** Pushes recomputed modifiers to every unit whose effects changed. */
+    void ApplyDirtyModifiers();
+
+    UPROPERTY()
+    UUnitRegistrySubsystem* UnitRegistry;
+
+    FStatusEffectStore Store;
+    TArray<int32> DirtyUnits;
+};
@@ -0,0 +1,213 @@
+// StatusEffects.cpp
+
+#include "StatusEffects.h"
+
+// ============================================================================
+// EFFECTS
+// ============================================================================
+
+uint32 FStatusEffectStore::Add(int32 Unit, const FStatusEffectSpec& Spec, int32 Source)
+{
+    check(Unit >= 0);
+
+    if (Stacks.Num() <= Unit)
+    {
+        Stacks.SetNum(Unit + 1);
+    }
+
+    FEffect& Effect = Stacks[Unit].AddDefaulted_GetRef();
+    Effect.Id = NextEffectId++;
+    Effect.Source = Source;
+    Effect.ExpireTime = Now + FMath::Max(Spec.Duration, 0.0f);
+    Effect.Magnitude = Spec.Magnitude;
+    Effect.Multiplier = Spec.Multiplier;
+    Effect.Kind = Spec.Kind;
+    Effect.Stat = Spec.Stat;
+    Effect.DamageType = Spec.DamageType;
+
+    Schedule(Unit, Effect.Id, Effect.ExpireTime, false);
+    if (Effect.Kind == EStatusEffectKind::DamageOverTime && Now + DamageTickInterval <= Effect.ExpireTime)
+    {
+        Schedule(Unit, Effect.Id, Now + DamageTickInterval, true);
+    }
+
+    MarkDirty(Unit);
+    return Effect.Id;
+}
+
+bool FStatusEffectStore::Remove(int32 Unit, uint32 EffectId)
+{
+    const int32 EffectIndex = FindEffect(Unit, EffectId);
+    if (EffectIndex == INDEX_NONE)
+    {
+        return false;
+    }
+
+    // Its timeline entries go stale and are dropped when they come due
+    Stacks[Unit].RemoveAt(EffectIndex, EAllowShrinking::No);
+    MarkDirty(Unit);
+    return true;
+}
+
+void FStatusEffectStore::ClearUnit(int32 Unit)
+{
+    if (Stacks.IsValidIndex(Unit) && Stacks[Unit].Num() > 0)
+    {
+        Stacks[Unit].Reset();
+        MarkDirty(Unit);
+    }
+}
+
+void FStatusEffectStore::Reset()
+{
+    Stacks.Reset();
+    Timeline.Reset();
+    Dirty.Reset();
+    DirtyUnits.Reset();
+    Now = 0.0;
+    NextEffectId = 1;
+    NextSequence = 0;
+}
+
+int32 FStatusEffectStore::FindEffect(int32 Unit, uint32 EffectId) const
+{
+    if (!Stacks.IsValidIndex(Unit))
+    {
+        return INDEX_NONE;
+    }
+
+    return Stacks[Unit].IndexOfByPredicate([EffectId](const FEffect& Effect) { return Effect.Id == EffectId; });
+}
+
+void FStatusEffectStore::Schedule(int32 Unit, uint32 EffectId, double Time, bool bDamageTick)
+{
+    FTimelineEntry Entry;
+    Entry.Time = Time;
+    Entry.Sequence = NextSequence++;
+    Entry.EffectId = EffectId;
+    Entry.Unit = Unit;
+    Entry.bDamageTick = bDamageTick;
+
+    Timeline.HeapPush(Entry, FTimelineOrder());
+}
+
+// ============================================================================
+// SHIELDS
+// ============================================================================
+
+float FStatusEffectStore::AbsorbDamage(int32 Unit, float Damage)
+{
+    if (!Stacks.IsValidIndex(Unit) || Damage <= 0.0f)
+    {
+        return Damage;
+    }
+
+    FEffectStack& Stack = Stacks[Unit];
+    for (int32 EffectIndex = 0; EffectIndex < Stack.Num() && Damage > 0.0f; )
+    {
+        FEffect& Effect = Stack[EffectIndex];
+        if (Effect.Kind != EStatusEffectKind::Shield)
+        {
+            ++EffectIndex;
+            continue;
+        }
+
+        const float Absorbed = FMath::Min(Effect.Magnitude, Damage);
+        Effect.Magnitude -= Absorbed;
+        Damage -= Absorbed;
+
+        // Broken shields go away; their expiry entry goes stale
+        if (Effect.Magnitude <= 0.0f)
+        {
+            Stack.RemoveAt(EffectIndex, EAllowShrinking::No);
+            continue;
+        }
+
+        ++EffectIndex;
+    }
+
+    return Damage;
+}
+
+float FStatusEffectStore::GetShield(int32 Unit) const
+{
+    float Shield = 0.0f;
+
+    if (Stacks.IsValidIndex(Unit))
+    {
+        for (const FEffect& Effect : Stacks[Unit])
+        {
+            if (Effect.Kind == EStatusEffectKind::Shield)
+            {
+                Shield += Effect.Magnitude;
+            }
+        }
+    }
+
+    return Shield;
+}
+
+// ============================================================================
+// MODIFIERS
+// ============================================================================
+
+void FStatusEffectStore::ComputeModifiers(int32 Unit, FStatusModifiers& OutModifiers) const
+{
+    OutModifiers = FStatusModifiers();
+
+    if (!Stacks.IsValidIndex(Unit))
+    {
+        return;
+    }
+
+    for (const FEffect& Effect : Stacks[Unit])
+    {
+        switch (Effect.Kind)
+        {
+        case EStatusEffectKind::StatModifier:
+            OutModifiers.Add[(int32)Effect.Stat] += Effect.Magnitude;
+            OutModifiers.Mul[(int32)Effect.Stat] *= Effect.Multiplier;
+            break;
+
+        case EStatusEffectKind::Stun:
+            OutModifiers.CrowdControl |= ECrowdControl::Stun;
+            break;
+
+        case EStatusEffectKind::Root:
+            OutModifiers.CrowdControl |= ECrowdControl::Root;
+            break;
+
+        case EStatusEffectKind::Disarm:
+            OutModifiers.CrowdControl |= ECrowdControl::Disarm;
+            break;
+
+        default:
+            break;
+        }
+    }
+}
+
+void FStatusEffectStore::MarkDirty(int32 Unit)
+{
+    if (Dirty.Num() <= Unit)
+    {
+        Dirty.Add(false, Unit + 1 - Dirty.Num());
+    }
+
+    if (!Dirty[Unit])
+    {
+        Dirty[Unit] = true;
+        DirtyUnits.Add(Unit);
+    }
+}
+
+void FStatusEffectStore::ConsumeDirtyUnits(TArray<int32>& OutUnits)
+{
+    for (const int32 Unit : DirtyUnits)
+    {
+        Dirty[Unit] = false;
+    }
+
+    OutUnits.Reset();
+    Swap(OutUnits, DirtyUnits);
+}
@@ -0,0 +1,261 @@
+// StatusEffects.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatTypes.h"
+#include "StatusEffects.generated.h"
+
+// ============================================================================
+// ENUMS
+// ============================================================================
+
+UENUM(BlueprintType)
+enum class EStatusEffectKind : uint8
+{
+    /** Changes one stat; slows and buffs are stat modifiers. */
+    StatModifier UMETA(DisplayName = "Stat Modifier"),
+    /** No moving, attacking or casting; attack cooldowns pause. */
+    Stun UMETA(DisplayName = "Stun"),
+    /** No moving. */
+    Root UMETA(DisplayName = "Root"),
+    /** No auto attacks. */
+    Disarm UMETA(DisplayName = "Disarm"),
+    /** Absorbs damage before health. */
+    Shield UMETA(DisplayName = "Shield"),
+    DamageOverTime UMETA(DisplayName = "Damage Over Time")
+};
+
+/** Stats status effects can modify. */
+UENUM(BlueprintType)
+enum class EUnitStat : uint8
+{
+    Armor UMETA(DisplayName = "Armor"),
+    MagicResist UMETA(DisplayName = "Magic Resist"),
+    AttackSpeed UMETA(DisplayName = "Attack Speed"),
+    AttackDamage UMETA(DisplayName = "Attack Damage"),
+    MovementSpeed UMETA(DisplayName = "Movement Speed"),
+
+    Count UMETA(Hidden)
+};
+
+enum class ECrowdControl : uint8
+{
+    None = 0,
+    Stun = 1 << 0,
+    Root = 1 << 1,
+    Disarm = 1 << 2,
+};
+ENUM_CLASS_FLAGS(ECrowdControl);
+
+// ============================================================================
+// STRUCTS
+// ============================================================================
+
+/** One status effect as authored by abilities and Blueprints. */
+USTRUCT(BlueprintType)
+struct FStatusEffectSpec
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Status Effect")
+    EStatusEffectKind Kind = EStatusEffectKind::StatModifier;
+
+    /** Seconds until the effect wears off. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Status Effect", meta = (ClampMin = "0"))
+    float Duration = 1.0f;
+
+    /** Stat modifiers only. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Status Effect")
+    EUnitStat Stat = EUnitStat::Armor;
+
+    /** Stat modifiers: added to the base stat. Shields: damage absorbed. Damage over time: damage per second. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Status Effect")
+    float Magnitude = 0.0f;
+
+    /** Stat modifiers only, applied after every Magnitude is added. A 30% slow is 0.7 on MovementSpeed. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Status Effect", meta = (ClampMin = "0"))
+    float Multiplier = 1.0f;
+
+    /** Damage over time only. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Status Effect")
+    EDamageType DamageType = EDamageType::Magical;
+};
+
+/** Everything a unit's active effects add up to. Final stat = (base + Add) * Mul. */
+struct FStatusModifiers
+{
+    static constexpr int32 NumStats = (int32)EUnitStat::Count;
+
+    /** Attack intervals are 1 / AttackSpeed, so it never reaches zero. */
+    static constexpr float MinAttackSpeed = 0.1f;
+
+    float Add[NumStats];
+    float Mul[NumStats];
+    ECrowdControl CrowdControl = ECrowdControl::None;
+
+    FStatusModifiers()
+    {
+        for (int32 StatIndex = 0; StatIndex < NumStats; ++StatIndex)
+        {
+            Add[StatIndex] = 0.0f;
+            Mul[StatIndex] = 1.0f;
+        }
+    }
+
+    float Apply(EUnitStat Stat, float Base) const
+    {
+        const float Value = (Base + Add[(int32)Stat]) * Mul[(int32)Stat];
+        return FMath::Max(Value, Stat == EUnitStat::AttackSpeed ? MinAttackSpeed : 0.0f);
+    }
+
+    bool Has(ECrowdControl Flags) const { return EnumHasAnyFlags(CrowdControl, Flags); }
+};
+
+// ============================================================================
+// STATUS EFFECT STORE
+// ============================================================================
+
+/**
+ * Active status effects of every unit, indexed by unit handle. Each unit's effects sit
+ * in a small inline stack; expiries and damage-over-time ticks all go through one
+ * min-heap timeline, so Advance() only touches effects that are actually due.
+ * Modifier totals are never recomputed per frame: units are flagged dirty when an
+ * effect is added, removed or expires, and the owner recomputes just those.
+ */
+class TFTUNREALDEMO_API FStatusEffectStore
+{
+public:
+    /** Seconds between damage-over-time hits. */
+    static constexpr double DamageTickInterval = 0.5;
+
+    /** Adds an effect to Unit and returns its id, unique for the store's lifetime. Source is a unit handle or INDEX_NONE. */
+    uint32 Add(int32 Unit, const FStatusEffectSpec& Spec, int32 Source);
+
+    bool Remove(int32 Unit, uint32 EffectId);
+    void ClearUnit(int32 Unit);
+    void Reset();
+
+    /** Takes Damage out of Unit's shields, oldest first, and returns what is left for health. */
+    float AbsorbDamage(int32 Unit, float Damage);
+
+    float GetShield(int32 Unit) const;
+    int32 NumEffects(int32 Unit) const { return Stacks.IsValidIndex(Unit) ? Stacks[Unit].Num() : 0; }
+
+    /** Sums Unit's stat modifiers and crowd control. */
+    void ComputeModifiers(int32 Unit, FStatusModifiers& OutModifiers) const;
+
+    /** Moves every unit whose modifiers changed since the last call into OutUnits. */
+    void ConsumeDirtyUnits(TArray<int32>& OutUnits);
+
+    /**
+     * Moves time forward, expiring effects and calling DamageFunc(Unit, Source, Amount,
+     * DamageType) for every damage-over-time hit that came due, in time order. DamageFunc
+     * may add or remove effects.
+     */
+    template <typename DamageFuncType>
+    void Advance(double DeltaTime, DamageFuncType&& DamageFunc);
+
+    double GetTime() const { return Now; }
+
+private:
+    struct FEffect
+    {
+        double ExpireTime = 0.0;
+        uint32 Id = 0;
+        int32 Source = INDEX_NONE;
+
+        /** Stat modifier add, remaining shield, or damage per second. */
+        float Magnitude = 0.0f;
+        float Multiplier = 1.0f;
+
+        EStatusEffectKind Kind = EStatusEffectKind::StatModifier;
+        EUnitStat Stat = EUnitStat::Armor;
+        EDamageType DamageType = EDamageType::Magical;
+    };
+
+    struct FTimelineEntry
+    {
+        double Time = 0.0;
+        uint32 Sequence = 0;
+        uint32 EffectId = 0;
+        int32 Unit = INDEX_NONE;
+        bool bDamageTick = false;
+    };
+
+    struct FTimelineOrder
+    {
+        // Ties: damage ticks before expiries, so a hit due as the effect ends still lands
+        bool operator()(const FTimelineEntry& A, const FTimelineEntry& B) const
+        {
+            if (A.Time != B.Time)
+            {
+                return A.Time < B.Time;
+            }
+            if (A.bDamageTick != B.bDamageTick)
+            {
+                return A.bDamageTick;
+            }
+            return A.Sequence < B.Sequence;
+        }
+    };
+
+    using FEffectStack = TArray<FEffect, TInlineAllocator<4>>;
+
+    void Schedule(int32 Unit, uint32 EffectId, double Time, bool bDamageTick);
+    void MarkDirty(int32 Unit);
+    int32 FindEffect(int32 Unit, uint32 EffectId) const;
+
+    TArray<FEffectStack> Stacks;
+
+    /** Expiries and damage ticks. Entries for removed effects go stale and are skipped. */
+    TArray<FTimelineEntry> Timeline;
+
+    TBitArray<> Dirty;
+    TArray<int32> DirtyUnits;
+
+    double Now = 0.0;
+    uint32 NextEffectId = 1;
+    uint32 NextSequence = 0;
+};
+
+// ============================================================================
+// TEMPLATE IMPLEMENTATION
+// ============================================================================
+
+template <typename DamageFuncType>
+void FStatusEffectStore::Advance(double DeltaTime, DamageFuncType&& DamageFunc)
+{
+    Now += DeltaTime;
+
+    // Pop before acting; the damage callback is free to change effects
+    while (Timeline.Num() > 0 && Timeline.HeapTop().Time <= Now)
+    {
+        FTimelineEntry Entry;
+        Timeline.HeapPop(Entry, FTimelineOrder(), EAllowShrinking::No);
+
+        const int32 EffectIndex = FindEffect(Entry.Unit, Entry.EffectId);
+        if (EffectIndex == INDEX_NONE)
+        {
+            continue;
+        }
+
+        if (!Entry.bDamageTick)
+        {
+            Stacks[Entry.Unit].RemoveAt(EffectIndex, EAllowShrinking::No);
+            MarkDirty(Entry.Unit);
+            continue;
+        }
+
+        const FEffect& Effect = Stacks[Entry.Unit][EffectIndex];
+        const float Amount = Effect.Magnitude * (float)DamageTickInterval;
+        const int32 Source = Effect.Source;
+        const EDamageType DamageType = Effect.DamageType;
+
+        if (Entry.Time + DamageTickInterval <= Effect.ExpireTime)
+        {
+            Schedule(Entry.Unit, Entry.EffectId, Entry.Time + DamageTickInterval, true);
+        }
+
+        DamageFunc(Entry.Unit, Source, Amount, DamageType);
+    }
+}
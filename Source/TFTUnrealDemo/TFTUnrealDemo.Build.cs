@@ -15,9 +15,10 @@ public class TFTUnrealDemo : ModuleRules
             "InputCore",
             "AIModule",
             "GameplayTasks",
-            "NavigationSystem"
+            "NavigationSystem",
+            "NetCore"
         });
 
-        PrivateDependencyModuleNames.AddRange(new string[] { });
+        PrivateDependencyModuleNames.AddRange(new string[] { "Json" });
     }
 }
\ No newline at end of file
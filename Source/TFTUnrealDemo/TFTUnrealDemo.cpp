@@ -3,4 +3,6 @@
 #include "TFTUnrealDemo.h"
 #include "Modules/ModuleManager.h"
 
+DEFINE_LOG_CATEGORY(LogTFTCombat);
+
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, TFTUnrealDemo, "TFTUnrealDemo" );
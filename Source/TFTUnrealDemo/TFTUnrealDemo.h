@@ -4,3 +4,9 @@
 
 #include "CoreMinimal.h"
 
+// Combat gameplay logging. Per-event messages are Verbose; the binary FCombatEventLog is the cheap path.
+#if UE_BUILD_SHIPPING
+DECLARE_LOG_CATEGORY_EXTERN(LogTFTCombat, Log, Warning);
+#else
+DECLARE_LOG_CATEGORY_EXTERN(LogTFTCombat, Log, All);
+#endif
@@ -0,0 +1,178 @@
+// UnitAISchedulerSubsystem.cpp
+
+#include "UnitAISchedulerSubsystem.h"
+#include "UnitBase.h"
+#include "CombatStats.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+// ============================================================================
+// CONSOLE VARIABLES
+// ============================================================================
+
+static float GUnitDecisionRate = 10.0f;
+static FAutoConsoleVariableRef CVarUnitDecisionRate(
+    TEXT("TFT.AI.DecisionRate"),
+    GUnitDecisionRate,
+    TEXT("How many times per second each combat unit re-evaluates its target and movement."));
+
+static float GUnitMaxThinkMsPerFrame = 2.0f;
+static FAutoConsoleVariableRef CVarUnitMaxThinkMsPerFrame(
+    TEXT("TFT.AI.MaxMsPerFrame"),
+    GUnitMaxThinkMsPerFrame,
+    TEXT("Time budget for unit Think() calls per frame. 0 disables the budget."));
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+void UUnitAISchedulerSubsystem::Deinitialize()
+{
+    Entries.Reset();
+    NumScheduled = 0;
+
+    Super::Deinitialize();
+}
+
+TStatId UUnitAISchedulerSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UUnitAISchedulerSubsystem, STATGROUP_Tickables);
+}
+
+bool UUnitAISchedulerSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+double UUnitAISchedulerSubsystem::GetDecisionInterval() const
+{
+    return GUnitDecisionRate > 0.0f ? 1.0 / GUnitDecisionRate : 0.0;
+}
+
+// ============================================================================
+// REGISTRATION
+// ============================================================================
+
+void UUnitAISchedulerSubsystem::AddUnit(AUnitBase* Unit)
+{
+    const int32 Handle = Unit ? Unit->GetUnitHandle() : INDEX_NONE;
+    if (Handle == INDEX_NONE)
+    {
+        return;
+    }
+
+    if (Handle >= Entries.Num())
+    {
+        Entries.SetNum(Handle + 1);
+    }
+
+    FScheduledUnit& Entry = Entries[Handle];
+    if (Entry.Unit == Unit)
+    {
+        return;
+    }
+
+    // Golden-ratio phase offsets spread units evenly across the decision interval
+    const double Phase = FMath::Frac(Handle * 0.6180339887);
+    Entry.Unit = Unit;
+    Entry.NextThinkTime = GetWorld()->GetTimeSeconds() + Phase * GetDecisionInterval();
+    ++NumScheduled;
+}
+
+void UUnitAISchedulerSubsystem::RemoveUnit(AUnitBase* Unit)
+{
+    const int32 Handle = Unit ? Unit->GetUnitHandle() : INDEX_NONE;
+    if (!Entries.IsValidIndex(Handle) || Entries[Handle].Unit != Unit)
+    {
+        return;
+    }
+
+    Entries[Handle] = FScheduledUnit();
+    --NumScheduled;
+}
+
+void UUnitAISchedulerSubsystem::WakeUnit(const AUnitBase* Unit)
+{
+    const int32 Handle = Unit ? Unit->GetUnitHandle() : INDEX_NONE;
+    if (Entries.IsValidIndex(Handle) && Entries[Handle].Unit == Unit)
+    {
+        Entries[Handle].NextThinkTime = 0.0;
+        ++PendingWakeups;
+    }
+}
+
+// ============================================================================
+// SCHEDULING
+// ============================================================================
+
+void UUnitAISchedulerSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+    TFT_COMBAT_FRAME_SCOPE(AIScheduler);
+
+    FAISchedulerFrameStats FrameStats;
+    FrameStats.UnitsScheduled = NumScheduled;
+    FrameStats.Wakeups = PendingWakeups;
+    PendingWakeups = 0;
+
+    const int32 NumEntries = Entries.Num();
+    if (NumEntries == 0)
+    {
+        LastFrameStats = FrameStats;
+        return;
+    }
+
+    const double Now = GetWorld()->GetTimeSeconds();
+    const double DecisionInterval = GetDecisionInterval();
+    const double BudgetSeconds = GUnitMaxThinkMsPerFrame / 1000.0;
+    const double StartTime = FPlatformTime::Seconds();
+
+    NextStartIndex = NextStartIndex % NumEntries;
+    int32 Visited = 0;
+
+    for (; Visited < NumEntries; ++Visited)
+    {
+        const int32 Index = (NextStartIndex + Visited) % NumEntries;
+        AUnitBase* Unit = Entries[Index].Unit;
+        if (!Unit || Entries[Index].NextThinkTime > Now || !Unit->IsReadyToThink())
+        {
+            continue;
+        }
+
+        if (BudgetSeconds > 0.0 && FrameStats.ThinksRun > 0 && FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+        {
+            break;
+        }
+
+        Unit->Think();
+        ++FrameStats.ThinksRun;
+
+        // Think again at the decision rate, or sooner if the next attack comes off cooldown first
+        double Delay = DecisionInterval;
+        const float Cooldown = Unit->GetAttackCooldown();
+        if (Cooldown > 0.0f && Cooldown < Delay)
+        {
+            Delay = Cooldown;
+        }
+
+        // Think() can add or remove units, so re-fetch the entry
+        if (Entries[Index].Unit == Unit)
+        {
+            Entries[Index].NextThinkTime = Now + Delay;
+        }
+    }
+
+    // Count what the budget pushed out and resume from there next frame
+    for (int32 Remaining = Visited; Remaining < NumEntries; ++Remaining)
+    {
+        const FScheduledUnit& Entry = Entries[(NextStartIndex + Remaining) % NumEntries];
+        if (Entry.Unit && Entry.NextThinkTime <= Now && Entry.Unit->IsReadyToThink())
+        {
+            ++FrameStats.ThinksDeferred;
+        }
+    }
+
+    NextStartIndex = (NextStartIndex + Visited) % NumEntries;
+    FrameStats.ThinkMilliseconds = (float)((FPlatformTime::Seconds() - StartTime) * 1000.0);
+    LastFrameStats = FrameStats;
+}
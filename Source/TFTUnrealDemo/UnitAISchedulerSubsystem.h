@@ -0,0 +1,96 @@
+// UnitAISchedulerSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UnitAISchedulerSubsystem.generated.h"
+
+// Forward declarations
+class AUnitBase;
+
+// ============================================================================
+// STRUCTS
+// ============================================================================
+
+/** What the scheduler did in its last update. */
+USTRUCT(BlueprintType)
+struct FAISchedulerFrameStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "AI")
+    int32 UnitsScheduled = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "AI")
+    int32 ThinksRun = 0;
+
+    /** Units that were due but pushed to the next frame by the time budget. */
+    UPROPERTY(BlueprintReadOnly, Category = "AI")
+    int32 ThinksDeferred = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "AI")
+    int32 Wakeups = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "AI")
+    float ThinkMilliseconds = 0.0f;
+};
+
+// ============================================================================
+// AI SCHEDULER SUBSYSTEM
+// ============================================================================
+
+/**
+ * Owns Think() invocation for every unit. Units think at TFT.AI.DecisionRate with their
+ * phases staggered across frames, as soon as their attack cooldown is ready, or
+ * immediately after a wake event (retargeted after a death, took damage, finished a cast).
+ * TFT.AI.MaxMsPerFrame caps the think time spent per frame; overflow carries to the next frame.
+ */
+UCLASS()
+class TFTUNREALDEMO_API UUnitAISchedulerSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // ========================================================================
+    // REGISTRATION
+    // ========================================================================
+
+    void AddUnit(AUnitBase* Unit);
+    void RemoveUnit(AUnitBase* Unit);
+
+    /** Makes the unit think on the scheduler's next update. */
+    void WakeUnit(const AUnitBase* Unit);
+
+    // ========================================================================
+    // STATS
+    // ========================================================================
+
+    UFUNCTION(BlueprintPure, Category = "AI")
+    FAISchedulerFrameStats GetLastFrameStats() const { return LastFrameStats; }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FScheduledUnit
+    {
+        AUnitBase* Unit = nullptr;
+        double NextThinkTime = 0.0;
+    };
+
+    double GetDecisionInterval() const;
+
+    /** Entries are indexed by unit registry handle. */
+    TArray<FScheduledUnit> Entries;
+    int32 NumScheduled = 0;
+
+    /** Round-robin start so budget-deferred units go first next frame. */
+    int32 NextStartIndex = 0;
+
+    FAISchedulerFrameStats LastFrameStats;
+    int32 PendingWakeups = 0;
+};
@@ -1,14 +1,48 @@
 ﻿// UnitBase.cpp
 
 #include "UnitBase.h"
+#include "UnitRegistrySubsystem.h"
+#include "CombatDamageSubsystem.h"
+#include "UnitAISchedulerSubsystem.h"
+#include "UnitMovementSubsystem.h"
+#include "BoardGridSubsystem.h"
+#include "UnitPoolSubsystem.h"
+#include "CombatClockSubsystem.h"
+#include "UnitDefinitionSubsystem.h"
+#include "StarCombineSubsystem.h"
+#include "StarScaling.h"
+#include "CombatRules.h"
+#include "CombatEventLog.h"
+#include "CombatStats.h"
+#include "CombatSnapshot.h"
+#include "CombatReplaySubsystem.h"
+#include "CombatReplicationSubsystem.h"
+#include "CombatNetState.h"
+#include "CombatEventBusSubsystem.h"
+#include "StatusEffectSubsystem.h"
+#include "ProjectileSubsystem.h"
+#include "AbilitySubsystem.h"
+#include "TFTUnrealDemo.h"
 #include "AIController.h"
 #include "Animation/AnimInstance.h"
 #include "Animation/AnimMontage.h"
 #include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
-#include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
+#include "Engine/GameInstance.h"
 #include "TimerManager.h"
+#include "HAL/IConsoleManager.h"
+
+// ============================================================================
+// CONSOLE VARIABLES
+// ============================================================================
+
+static float GUnitFaceTargetTolerance = 1.0f;
+static FAutoConsoleVariableRef CVarUnitFaceTargetTolerance(
+    TEXT("TFT.Unit.FaceTargetTolerance"),
+    GUnitFaceTargetTolerance,
+    TEXT("Yaw difference in degrees below which a unit counts as already facing its target."));
 
 // ============================================================================
 // CONSTRUCTOR
@@ -21,14 +55,18 @@ AUnitBase::AUnitBase()
     // Initialize default values
     UnitName = TEXT("Unit");
     StarLevel = 1;
+    bStatsIncludeStarLevel = true;
     Team = ETeam::Player;
     TeamID = 0;
+    BoardId = 0;
 
     MaxHealth = 100.0f;
     CurrentHealth = 100.0f;
     AttackDamage = 10.0f;
     AttackSpeed = 1.0f;
     AttackRange = 150.0f;
+    AttackRangeHexes = 0;
+    ProjectileSpeed = 0.0f;
     Armor = 0.0f;
     MagicResist = 0.0f;
     MaxMana = 50.0f;
@@ -48,8 +86,26 @@ AUnitBase::AUnitBase()
     StoppingDistance = 50.0f;
 
     CurrentState = EUnitState::Bench;
-    AttackCooldown = 0.0f;
     AIControllerRef = nullptr;
+    UnitRegistry = nullptr;
+    DamageSubsystem = nullptr;
+    AIScheduler = nullptr;
+    MovementSubsystem = nullptr;
+    BoardGrid = nullptr;
+    CombatClock = nullptr;
+    StarCombine = nullptr;
+    ReplayRecorder = nullptr;
+    NetReplication = nullptr;
+    EventBus = nullptr;
+    StatusEffects = nullptr;
+    Projectiles = nullptr;
+    Abilities = nullptr;
+    RegistryHandle = INDEX_NONE;
+    DefinitionIndex = INDEX_NONE;
+    Significance = EUnitSignificance::Full;
+    BaseMaxHealth = 0.0f;
+    BaseAttackDamage = 0.0f;
+    bInPool = false;
 
     // Set this character to be controlled by AI
     AutoPossessAI = EAutoPossessAI::PlacedInWorldOrSpawned;
@@ -61,6 +117,10 @@ AUnitBase::AUnitBase()
 
     // Disable physics simulation
     GetCapsuleComponent()->SetSimulatePhysics(false);
+
+    // Off-screen units only advance montages; on screen, URO lowers the anim rate with screen size
+    GetMesh()->bEnableUpdateRateOptimizations = true;
+    GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered;
 }
 
 // ============================================================================
@@ -71,27 +131,407 @@ void AUnitBase::BeginPlay()
 {
     Super::BeginPlay();
 
-    UE_LOG(LogTemp, Error, TEXT("🚨🚨🚨 HELLO FROM C++ BEGINPLAY! 🚨🚨🚨"));
-    UE_LOG(LogTemp, Error, TEXT("Unit name is: %s"), *UnitName);
+    // Data-driven units replace their Blueprint stats with the definition's
+    ApplyNamedDefinition();
+
+    // Blueprint stats are scaled to StarLevel unless they were authored for it
+    if (DefinitionIndex == INDEX_NONE)
+    {
+        SetStarLevel(StarLevel);
+    }
 
     // Initialize stats
     CurrentHealth = MaxHealth;
     CurrentMana = 0.0f;
-    AttackCooldown = 0.0f;
 
     // Get AI Controller reference
     AIControllerRef = Cast<AAIController>(GetController());
 
     if (!AIControllerRef)
     {
-        UE_LOG(LogTemp, Error, TEXT("%s: No AI Controller found!"), *UnitName);
+        UE_LOG(LogTFTCombat, Error, TEXT("%s: No AI Controller found!"), *UnitName);
     }
 
-    UE_LOG(LogTemp, Log, TEXT("✅ %s initialized - HP: %.0f/%.0f, Team: %d"),
+    // Join the unit registry so other units can find us as a target
+    UnitRegistry = GetWorld()->GetSubsystem<UUnitRegistrySubsystem>();
+    DamageSubsystem = GetWorld()->GetSubsystem<UCombatDamageSubsystem>();
+    MovementSubsystem = GetWorld()->GetSubsystem<UUnitMovementSubsystem>();
+    BoardGrid = GetWorld()->GetSubsystem<UBoardGridSubsystem>();
+    CombatClock = GetWorld()->GetSubsystem<UCombatClockSubsystem>();
+    ReplayRecorder = GetWorld()->GetSubsystem<UCombatReplaySubsystem>();
+    EventBus = GetWorld()->GetSubsystem<UCombatEventBusSubsystem>();
+    RegisterWithRegistry();
+    RefreshCombatStats();
+
+    UE_LOG(LogTFTCombat, Log, TEXT("✅ %s initialized - HP: %.0f/%.0f, Team: %d"),
         *UnitName, CurrentHealth, MaxHealth, (int32)Team);
 
+    // Network clients only render the fight; state comes from the server's ABoardCombatState
+    if (!HasAuthority())
+    {
+        return;
+    }
+
+    // Think() is driven by the AI scheduler rather than every tick
+    AIScheduler = GetWorld()->GetSubsystem<UUnitAISchedulerSubsystem>();
+    if (AIScheduler)
+    {
+        AIScheduler->AddUnit(this);
+    }
+
+    NetReplication = GetWorld()->GetSubsystem<UCombatReplicationSubsystem>();
+    StatusEffects = GetWorld()->GetSubsystem<UStatusEffectSubsystem>();
+    Projectiles = GetWorld()->GetSubsystem<UProjectileSubsystem>();
+    Abilities = GetWorld()->GetSubsystem<UAbilitySubsystem>();
+
+    // Looked up before the pool check so prewarmed units are tracked once handed out
+    StarCombine = GetWorld()->GetSubsystem<UStarCombineSubsystem>();
+
+    // Prewarmed units wait benched and hidden until the pool hands them out
+    if (bInPool)
+    {
+        SetTargetable(false);
+        return;
+    }
+
     SetState(EUnitState::Combat);
-    UE_LOG(LogTemp, Warning, TEXT("🚨 SetState called from C++ successfully! 🚨"));
+    UpdateStarCombineTracking();
+}
+
+void AUnitBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (AIScheduler)
+    {
+        AIScheduler->RemoveUnit(this);
+        AIScheduler = nullptr;
+    }
+
+    if (MovementSubsystem)
+    {
+        MovementSubsystem->RemoveUnit(this);
+        MovementSubsystem = nullptr;
+    }
+
+    if (BoardGrid)
+    {
+        BoardGrid->RemoveUnit(RegistryHandle);
+        BoardGrid = nullptr;
+    }
+
+    CancelCombatEvents();
+    CombatClock = nullptr;
+
+    if (StarCombine)
+    {
+        StarCombine->RemoveUnit(this);
+        StarCombine = nullptr;
+    }
+
+    if (ReplayRecorder)
+    {
+        ReplayRecorder->RemoveUnit(this);
+        ReplayRecorder = nullptr;
+    }
+
+    if (NetReplication)
+    {
+        NetReplication->RemoveUnit(this);
+        NetReplication = nullptr;
+    }
+
+    ClearStatusEffects();
+    StatusEffects = nullptr;
+
+    RemoveProjectiles();
+    Projectiles = nullptr;
+    Abilities = nullptr;
+
+    UnregisterFromRegistry();
+    UnitRegistry = nullptr;
+    DamageSubsystem = nullptr;
+    EventBus = nullptr;
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void AUnitBase::RegisterWithRegistry()
+{
+    if (UnitRegistry && RegistryHandle == INDEX_NONE)
+    {
+        RegistryHandle = UnitRegistry->RegisterUnit(this);
+    }
+}
+
+void AUnitBase::SetTargetable(bool bTargetable)
+{
+    if (UnitRegistry && RegistryHandle != INDEX_NONE)
+    {
+        UnitRegistry->SetUnitTargetable(RegistryHandle, bTargetable);
+    }
+}
+
+void AUnitBase::ClearStatusEffects()
+{
+    if (StatusEffects && RegistryHandle != INDEX_NONE)
+    {
+        StatusEffects->ClearEffects(RegistryHandle);
+    }
+}
+
+void AUnitBase::RemoveProjectiles()
+{
+    if (Projectiles && RegistryHandle != INDEX_NONE)
+    {
+        Projectiles->RemoveUnit(RegistryHandle);
+    }
+}
+
+void AUnitBase::UnregisterFromRegistry()
+{
+    if (UnitRegistry && RegistryHandle != INDEX_NONE)
+    {
+        UnitRegistry->UnregisterUnit(RegistryHandle);
+    }
+
+    RegistryHandle = INDEX_NONE;
+}
+
+// ============================================================================
+// STATS
+// ============================================================================
+
+void AUnitBase::RefreshCombatStats()
+{
+    GetCharacterMovement()->MaxWalkSpeed = StatusModifiers.Apply(EUnitStat::MovementSpeed, MovementSpeed);
+
+    FUnitStatStore* Stats = GetStatStore();
+    if (!Stats)
+    {
+        return;
+    }
+
+    // The store holds the final stats, so damage and attacks never look at modifiers
+    Stats->CurrentHealth[RegistryHandle] = CurrentHealth;
+    Stats->CurrentMana[RegistryHandle] = CurrentMana;
+    Stats->Armor[RegistryHandle] = StatusModifiers.Apply(EUnitStat::Armor, Armor);
+    Stats->MagicResist[RegistryHandle] = StatusModifiers.Apply(EUnitStat::MagicResist, MagicResist);
+    Stats->AttackSpeed[RegistryHandle] = StatusModifiers.Apply(EUnitStat::AttackSpeed, AttackSpeed);
+    Stats->AttackDamage[RegistryHandle] = StatusModifiers.Apply(EUnitStat::AttackDamage, AttackDamage);
+    Stats->AttackRange[RegistryHandle] = AttackRange;
+    UpdateCooldownMask();
+}
+
+void AUnitBase::SetStatusModifiers(const FStatusModifiers& NewModifiers)
+{
+    const bool bWasStunned = IsStunned();
+    const bool bWasHeld = StatusModifiers.Has(ECrowdControl::Stun | ECrowdControl::Root);
+
+    StatusModifiers = NewModifiers;
+    RefreshCombatStats();
+
+    if (!bWasHeld && StatusModifiers.Has(ECrowdControl::Stun | ECrowdControl::Root))
+    {
+        StopMovement();
+    }
+
+    if (bWasStunned && !IsStunned())
+    {
+        WakeAI();
+    }
+}
+
+bool AUnitBase::ApplyUnitDefinition(int32 NewDefinitionIndex, int32 NewStarLevel)
+{
+    UUnitDefinitionSubsystem* Definitions = GetGameInstance() ? GetGameInstance()->GetSubsystem<UUnitDefinitionSubsystem>() : nullptr;
+    if (!Definitions || !Definitions->GetTable().IsValidIndex(NewDefinitionIndex))
+    {
+        return false;
+    }
+
+    const FUnitDefinitionTable& Table = Definitions->GetTable();
+    const FUnitDefinitionStats& Stats = Table.GetStats(NewDefinitionIndex, NewStarLevel);
+
+    DefinitionIndex = NewDefinitionIndex;
+    DefinitionName = Table.GetName(DefinitionIndex);
+    UnitName = DefinitionName.ToString();
+    StarLevel = FStarScaling::ClampStarLevel(NewStarLevel);
+
+    MaxHealth = Stats.MaxHealth;
+    AttackDamage = Stats.AttackDamage;
+    AttackSpeed = Stats.AttackSpeed;
+    AttackRange = Stats.AttackRange;
+    AttackRangeHexes = Stats.AttackRangeHexes;
+    Armor = Stats.Armor;
+    MagicResist = Stats.MagicResist;
+    MaxMana = Stats.MaxMana;
+    MovementSpeed = Stats.MovementSpeed;
+    StoppingDistance = Stats.StoppingDistance;
+    GetCharacterMovement()->MaxWalkSpeed = MovementSpeed;
+
+    // Keep the Blueprint's montage when the definition leaves one out
+    if (UAnimMontage* Montage = Definitions->GetMontage(DefinitionIndex, EUnitDefinitionMontage::Attack))
+    {
+        AttackMontage = Montage;
+    }
+    if (UAnimMontage* Montage = Definitions->GetMontage(DefinitionIndex, EUnitDefinitionMontage::Ability))
+    {
+        AbilityMontage = Montage;
+    }
+    if (UAnimMontage* Montage = Definitions->GetMontage(DefinitionIndex, EUnitDefinitionMontage::Death))
+    {
+        DeathMontage = Montage;
+    }
+
+    CurrentHealth = MaxHealth;
+    CurrentMana = 0.0f;
+    RefreshCombatStats();
+    UpdateStarCombineTracking();
+    return true;
+}
+
+void AUnitBase::SetStarLevel(int32 NewStarLevel)
+{
+    // Definition units carry cooked stats for every star
+    if (DefinitionIndex != INDEX_NONE && ApplyUnitDefinition(DefinitionIndex, NewStarLevel))
+    {
+        return;
+    }
+
+    CaptureBaseStats();
+
+    StarLevel = FStarScaling::ClampStarLevel(NewStarLevel);
+    MaxHealth = BaseMaxHealth * FStarScaling::GetHealthMultiplier(StarLevel);
+    AttackDamage = BaseAttackDamage * FStarScaling::GetDamageMultiplier(StarLevel);
+
+    CurrentHealth = MaxHealth;
+    RefreshCombatStats();
+    UpdateStarCombineTracking();
+}
+
+void AUnitBase::ApplyNamedDefinition()
+{
+    if (DefinitionName.IsNone())
+    {
+        return;
+    }
+
+    const UUnitDefinitionSubsystem* Definitions = GetGameInstance() ? GetGameInstance()->GetSubsystem<UUnitDefinitionSubsystem>() : nullptr;
+    if (!Definitions || !ApplyUnitDefinition(Definitions->FindDefinition(DefinitionName), StarLevel))
+    {
+        UE_LOG(LogTFTCombat, Warning, TEXT("%s: No unit definition named %s"), *UnitName, *DefinitionName.ToString());
+    }
+}
+
+void AUnitBase::RestoreClassDefaults()
+{
+    const AUnitBase* Defaults = GetClass()->GetDefaultObject<AUnitBase>();
+
+    UnitName = Defaults->UnitName;
+    StarLevel = Defaults->StarLevel;
+    bStatsIncludeStarLevel = Defaults->bStatsIncludeStarLevel;
+    DefinitionName = Defaults->DefinitionName;
+    DefinitionIndex = INDEX_NONE;
+
+    MaxHealth = Defaults->MaxHealth;
+    AttackDamage = Defaults->AttackDamage;
+    AttackSpeed = Defaults->AttackSpeed;
+    AttackRange = Defaults->AttackRange;
+    AttackRangeHexes = Defaults->AttackRangeHexes;
+    ProjectileSpeed = Defaults->ProjectileSpeed;
+    Armor = Defaults->Armor;
+    MagicResist = Defaults->MagicResist;
+    MaxMana = Defaults->MaxMana;
+    MovementSpeed = Defaults->MovementSpeed;
+    StoppingDistance = Defaults->StoppingDistance;
+    Ability = Defaults->Ability;
+
+    AttackMontage = Defaults->AttackMontage;
+    AbilityMontage = Defaults->AbilityMontage;
+    DeathMontage = Defaults->DeathMontage;
+
+    // Star scaling recaptures its one-star baseline from the restored stats
+    BaseMaxHealth = 0.0f;
+    BaseAttackDamage = 0.0f;
+}
+
+void AUnitBase::CaptureBaseStats()
+{
+    if (BaseMaxHealth > 0.0f)
+    {
+        return;
+    }
+
+    // First star change: the authored stats are the one-star values, or the current star's
+    const int32 AuthoredStarLevel = bStatsIncludeStarLevel ? StarLevel : 1;
+    BaseMaxHealth = MaxHealth / FStarScaling::GetHealthMultiplier(AuthoredStarLevel);
+    BaseAttackDamage = AttackDamage / FStarScaling::GetDamageMultiplier(AuthoredStarLevel);
+}
+
+FName AUnitBase::GetUnitTypeName() const
+{
+    return DefinitionName.IsNone() ? GetClass()->GetFName() : DefinitionName;
+}
+
+void AUnitBase::UpdateStarCombineTracking()
+{
+    if (!StarCombine)
+    {
+        return;
+    }
+
+    // Only the player's units outside the pool are owned copies
+    if (Team == ETeam::Player && !bInPool)
+    {
+        StarCombine->AddUnit(this);
+    }
+    else
+    {
+        StarCombine->RemoveUnit(this);
+    }
+}
+
+FUnitStatStore* AUnitBase::GetStatStore() const
+{
+    return (UnitRegistry && RegistryHandle != INDEX_NONE) ? &UnitRegistry->GetStatStore() : nullptr;
+}
+
+float AUnitBase::GetStat(FUnitStatStore::FStatArray FUnitStatStore::* Field, float Fallback) const
+{
+    const FUnitStatStore* Stats = GetStatStore();
+    return Stats ? (Stats->*Field)[RegistryHandle] : Fallback;
+}
+
+void AUnitBase::SetStat(FUnitStatStore::FStatArray FUnitStatStore::* Field, float& Mirror, float Value)
+{
+    // Blueprints and the health bar read the UPROPERTY mirror
+    Mirror = Value;
+
+    if (FUnitStatStore* Stats = GetStatStore())
+    {
+        (Stats->*Field)[RegistryHandle] = Value;
+    }
+}
+
+float AUnitBase::GetAttackCooldown() const
+{
+    const FUnitStatStore* Stats = GetStatStore();
+    return Stats ? Stats->AttackCooldown[RegistryHandle] : 0.0f;
+}
+
+void AUnitBase::SetAttackCooldown(float Value)
+{
+    if (FUnitStatStore* Stats = GetStatStore())
+    {
+        Stats->AttackCooldown[RegistryHandle] = Value;
+    }
+}
+
+void AUnitBase::UpdateCooldownMask()
+{
+    if (FUnitStatStore* Stats = GetStatStore())
+    {
+        Stats->CooldownMask[RegistryHandle] = IsReadyToThink() ? 1.0f : 0.0f;
+    }
 }
 
 // ============================================================================
@@ -102,26 +542,40 @@ void AUnitBase::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
 
+    // Spatial hash and board cells are kept current by the unit registry's update
+
     // Only think during combat
-    if (!bIsAlive || CurrentState != EUnitState::Combat || bIsCastingAbility)
+    if (!IsReadyToThink())
     {
         return;
     }
 
-    // Reduce attack cooldown
-    if (AttackCooldown > 0.0f)
+    // Attack cooldowns are decremented in one batch by the unit registry
+
+    // Facing is cosmetic; units nobody can see skip it
+    if (CurrentTarget && Significance != EUnitSignificance::Minimal)
     {
-        AttackCooldown -= DeltaTime;
+        FaceTarget(CurrentTarget->GetActorLocation(), DeltaTime);
     }
 
-    // Face target if we have one
-    if (CurrentTarget)
+    // Main AI logic runs on the AI scheduler's time slice when there is one
+    if (!AIScheduler && HasAuthority())
     {
-        FaceTarget(CurrentTarget->GetActorLocation());
+        Think();
     }
+}
 
-    // Main AI logic
-    Think();
+bool AUnitBase::IsReadyToThink() const
+{
+    return bIsAlive && CurrentState == EUnitState::Combat && !bIsCastingAbility && !IsStunned();
+}
+
+void AUnitBase::WakeAI()
+{
+    if (AIScheduler)
+    {
+        AIScheduler->WakeUnit(this);
+    }
 }
 
 // ============================================================================
@@ -130,24 +584,24 @@ void AUnitBase::Tick(float DeltaTime)
 
 void AUnitBase::Think()
 {
+    TFT_COMBAT_SCOPE(Think);
+
     // 1. Check if dead
     if (CurrentHealth <= 0.0f)
     {
         return;
     }
 
-    // 2. Check if we have a valid target
-    if (!CurrentTarget || !CurrentTarget->bIsAlive || CurrentTarget->CurrentState == EUnitState::Bench)
+    // 2. Check if we have a target. Dead or benched targets are replaced by the
+    //    registry as soon as it happens (see RetargetAttackers)
+    if (!CurrentTarget)
     {
         FindNewTarget();
         return;
     }
 
-    // 3. Check distance to target
-    float DistanceToTarget = FVector::Dist(GetActorLocation(), CurrentTarget->GetActorLocation());
-
-    // 4. If too far, move closer
-    if (DistanceToTarget > AttackRange)
+    // 3-4. If out of range, move closer
+    if (!IsTargetInAttackRange())
     {
         MoveToTarget();
         return;
@@ -156,65 +610,92 @@ void AUnitBase::Think()
     // 5. If in range, stop and prepare to attack
     StopMovement();
 
-    // 6. Check if we should cast ability (mana full)
+    // 6. Check if we should cast ability (mana full, e.g. held through a stun)
     if (CurrentMana >= MaxMana)
     {
-        CastAbility();
+        CastOnFullMana();
     }
 
     // 7. Auto attack on cooldown
-    if (AttackCooldown <= 0.0f && bCanAttack)
+    if (GetAttackCooldown() <= 0.0f && bCanAttack && !StatusModifiers.Has(ECrowdControl::Disarm))
     {
         AttemptAutoAttack();
     }
 }
 
+int32 AUnitBase::GetAttackRangeHexes() const
+{
+    if (AttackRangeHexes > 0)
+    {
+        return AttackRangeHexes;
+    }
+
+    const float HexWidth = BoardGrid ? BoardGrid->GetHexWidth() : FHexBoard::DefaultHexWidth;
+    return FMath::Max(1, FMath::RoundToInt(AttackRange / HexWidth));
+}
+
+bool AUnitBase::IsTargetInAttackRange() const
+{
+    // Hex table lookup while both units are on the board
+    bool bInRange = false;
+    if (BoardGrid && BoardGrid->TryIsInRange(this, CurrentTarget, GetAttackRangeHexes(), bInRange))
+    {
+        return bInRange;
+    }
+
+    return FVector::DistSquared(GetActorLocation(), CurrentTarget->GetActorLocation()) <= FMath::Square(AttackRange);
+}
+
 // ============================================================================
 // AI - TARGET FINDING
 // ============================================================================
 
 void AUnitBase::FindNewTarget()
 {
-    CurrentTarget = GetNearestEnemy();
+    TFT_COMBAT_SCOPE(FindNewTarget);
+
+    RetargetTo(GetNearestEnemy());
+}
+
+void AUnitBase::RetargetTo(AUnitBase* NewTarget)
+{
+    SetCurrentTarget(NewTarget);
 
     if (CurrentTarget)
     {
-        UE_LOG(LogTemp, Log, TEXT("🎯 %s found new target: %s"), *UnitName, *CurrentTarget->UnitName);
-        AttackCooldown = 0.0f;
+        TFT_RECORD_COMBAT_EVENT(TargetAcquired, GFrameCounter, RegistryHandle, CurrentTarget->GetUnitHandle());
+        UE_LOG(LogTFTCombat, Verbose, TEXT("🎯 %s found new target: %s"), *UnitName, *CurrentTarget->UnitName);
+        SetAttackCooldown(0.0f);
     }
     else
     {
-        UE_LOG(LogTemp, Warning, TEXT("❌ %s could not find a target!"), *UnitName);
+        TFT_RECORD_COMBAT_EVENT(TargetNotFound, GFrameCounter, RegistryHandle, INDEX_NONE);
+        UE_LOG(LogTFTCombat, Verbose, TEXT("❌ %s could not find a target!"), *UnitName);
     }
 }
 
 AUnitBase* AUnitBase::GetNearestEnemy()
 {
-    TArray<AActor*> AllUnits;
-    UGameplayStatics::GetAllActorsOfClass(GetWorld(), AUnitBase::StaticClass(), AllUnits);
+    return UnitRegistry ? UnitRegistry->FindNearestEnemy(this) : nullptr;
+}
 
-    AUnitBase* BestTarget = nullptr;
-    float BestDistance = FLT_MAX;
+void AUnitBase::SetCurrentTarget(AUnitBase* NewTarget)
+{
+    CurrentTarget = NewTarget;
 
-    for (AActor* Actor : AllUnits)
+    // Keep the registry's "who is targeting me" index in sync
+    if (UnitRegistry && RegistryHandle != INDEX_NONE)
     {
-        AUnitBase* Unit = Cast<AUnitBase>(Actor);
-
-        if (!Unit || Unit == this) continue;
-        if (!Unit->bIsAlive) continue;
-        if (Unit->Team == this->Team) continue;
-        if (Unit->CurrentState != EUnitState::Combat) continue;
-
-        float Distance = FVector::Dist(GetActorLocation(), Unit->GetActorLocation());
-
-        if (Distance < BestDistance)
-        {
-            BestDistance = Distance;
-            BestTarget = Unit;
-        }
+        UnitRegistry->SetUnitTarget(RegistryHandle, NewTarget ? NewTarget->GetUnitHandle() : INDEX_NONE);
     }
+}
 
-    return BestTarget;
+void AUnitBase::RetargetAttackers()
+{
+    if (UnitRegistry && RegistryHandle != INDEX_NONE)
+    {
+        UnitRegistry->RetargetAttackers(RegistryHandle);
+    }
 }
 
 // ============================================================================
@@ -223,26 +704,41 @@ AUnitBase* AUnitBase::GetNearestEnemy()
 
 void AUnitBase::AttemptAutoAttack()
 {
+    TFT_COMBAT_SCOPE(AttemptAutoAttack);
+
     if (!CurrentTarget || !CurrentTarget->bIsAlive)
     {
-        UE_LOG(LogTemp, Warning, TEXT("⚠️ %s tried to attack invalid target"), *UnitName);
+        UE_LOG(LogTFTCombat, Verbose, TEXT("⚠️ %s tried to attack invalid target"), *UnitName);
         return;
     }
 
     if (CurrentTarget->CurrentState == EUnitState::Bench)
     {
-        UE_LOG(LogTemp, Warning, TEXT("⚠️ %s tried to attack benched target"), *UnitName);
+        UE_LOG(LogTFTCombat, Verbose, TEXT("⚠️ %s tried to attack benched target"), *UnitName);
         return;
     }
 
-    FaceTarget(CurrentTarget->GetActorLocation());
+    const float Damage = GetStat(&FUnitStatStore::AttackDamage, AttackDamage);
+
+    FaceTarget(CurrentTarget->GetActorLocation(), GetWorld()->GetDeltaSeconds());
     PlayAnimMontage(AttackMontage);
-    DealDamage(CurrentTarget, AttackDamage, EDamageType::Physical);
-    GainMana(10.0f);
+
+    // Ranged attacks land when the projectile arrives
+    if (ProjectileSpeed <= 0.0f || !Projectiles
+        || !Projectiles->LaunchProjectile(this, CurrentTarget, Damage, EDamageType::Physical, ProjectileSpeed))
+    {
+        DealDamage(CurrentTarget, Damage, EDamageType::Physical);
+    }
+    GainMana(FCombatRules::ManaPerAttack);
     OnAttack.Broadcast(CurrentTarget);
-    AttackCooldown = 1.0f / AttackSpeed;
+    if (EventBus)
+    {
+        EventBus->Push(ECombatEventType::Attack, this, CurrentTarget, Damage);
+    }
+    SetAttackCooldown(FCombatRules::GetAttackInterval(GetStat(&FUnitStatStore::AttackSpeed, AttackSpeed)));
 
-    UE_LOG(LogTemp, Log, TEXT("⚔️ %s attacked %s for %.1f damage"), *UnitName, *CurrentTarget->UnitName, AttackDamage);
+    TFT_RECORD_COMBAT_EVENT(Attack, GFrameCounter, RegistryHandle, CurrentTarget->GetUnitHandle(), Damage);
+    UE_LOG(LogTFTCombat, Verbose, TEXT("⚔️ %s attacked %s for %.1f damage"), *UnitName, *CurrentTarget->UnitName, Damage);
 }
 
 // ============================================================================
@@ -251,36 +747,64 @@ void AUnitBase::AttemptAutoAttack()
 
 void AUnitBase::DealDamage(AUnitBase* Target, float Damage, EDamageType DamageType)
 {
+    TFT_COMBAT_SCOPE(DealDamage);
+
     if (!Target || !Target->bIsAlive)
     {
         return;
     }
 
+    // Resolved with the rest of the frame's hits by the damage subsystem
+    if (DamageSubsystem && DamageSubsystem->QueueDamage(this, Target, Damage, DamageType))
+    {
+        return;
+    }
+
     FDamageInfo DamageInfo(Damage, DamageType, this);
     Target->TakeDamage(DamageInfo);
 }
 
 void AUnitBase::TakeDamage(const FDamageInfo& DamageInfo)
 {
+    TFT_COMBAT_SCOPE(TakeDamage);
+
+    ApplyReducedDamage(DamageInfo, CalculateDamageReduction(DamageInfo.Amount, DamageInfo.Type));
+}
+
+void AUnitBase::ApplyReducedDamage(const FDamageInfo& DamageInfo, float FinalDamage)
+{
+    TFT_COMBAT_SCOPE(ApplyReducedDamage);
+
     if (CurrentState == EUnitState::Bench)
     {
-        UE_LOG(LogTemp, Log, TEXT("🚫 %s is benched and ignored damage"), *UnitName);
+        TFT_RECORD_COMBAT_EVENT(DamageIgnored, GFrameCounter, INDEX_NONE, RegistryHandle, DamageInfo.Amount, (uint8)DamageInfo.Type);
+        UE_LOG(LogTFTCombat, Verbose, TEXT("🚫 %s is benched and ignored damage"), *UnitName);
         return;
     }
 
-    float FinalDamage = CalculateDamageReduction(DamageInfo.Amount, DamageInfo.Type);
-    CurrentHealth -= FinalDamage;
+    // Shields soak damage before health; the hit still counts for mana
+    const float HealthDamage = StatusEffects ? StatusEffects->AbsorbDamage(RegistryHandle, FinalDamage) : FinalDamage;
+    SetStat(&FUnitStatStore::CurrentHealth, CurrentHealth, CurrentHealth - HealthDamage);
+    TFT_COMBAT_COUNTER(DamageEvents, 1);
 
     if (FinalDamage > 0.0f)
     {
-        GainMana(1.0f);
+        GainMana(FCombatRules::ManaPerHitTaken);
+        WakeAI();
     }
 
-    FString DamageTypeStr = DamageInfo.Type == EDamageType::Physical ? TEXT("Physical") :
-        DamageInfo.Type == EDamageType::Magical ? TEXT("Magical") : TEXT("True");
+    if (EventBus)
+    {
+        EventBus->Push(ECombatEventType::Damage, Cast<AUnitBase>(DamageInfo.Causer), this, FinalDamage, (uint8)DamageInfo.Type);
+    }
 
-    UE_LOG(LogTemp, Log, TEXT("💥 %s took %.1f %s damage. HP: %.0f/%.0f"),
-        *UnitName, FinalDamage, *DamageTypeStr, CurrentHealth, MaxHealth);
+#if TFT_WITH_COMBAT_EVENTS
+    const AUnitBase* Causer = Cast<AUnitBase>(DamageInfo.Causer);
+    TFT_RECORD_COMBAT_EVENT(Damage, GFrameCounter, Causer ? Causer->GetUnitHandle() : INDEX_NONE, RegistryHandle,
+        FinalDamage, (uint8)DamageInfo.Type);
+#endif
+    UE_LOG(LogTFTCombat, Verbose, TEXT("💥 %s took %.1f %s damage. HP: %.0f/%.0f"),
+        *UnitName, FinalDamage, *UEnum::GetDisplayValueAsText(DamageInfo.Type).ToString(), CurrentHealth, MaxHealth);
 
     if (CurrentHealth <= 0.0f)
     {
@@ -290,24 +814,8 @@ void AUnitBase::TakeDamage(const FDamageInfo& DamageInfo)
 
 float AUnitBase::CalculateDamageReduction(float IncomingDamage, EDamageType DamageType) const
 {
-    float FinalDamage = IncomingDamage;
-
-    switch (DamageType)
-    {
-    case EDamageType::Physical:
-        FinalDamage = IncomingDamage * (100.0f / (100.0f + Armor));
-        break;
-
-    case EDamageType::Magical:
-        FinalDamage = IncomingDamage * (100.0f / (100.0f + MagicResist));
-        break;
-
-    case EDamageType::TrueDamage:
-        FinalDamage = IncomingDamage;
-        break;
-    }
-
-    return FinalDamage;
+    return FCombatRules::CalculateDamageReduction(IncomingDamage, DamageType,
+        GetStat(&FUnitStatStore::Armor, Armor), GetStat(&FUnitStatStore::MagicResist, MagicResist));
 }
 
 // ============================================================================
@@ -316,42 +824,82 @@ float AUnitBase::CalculateDamageReduction(float IncomingDamage, EDamageType Dama
 
 void AUnitBase::GainMana(float Amount)
 {
-    CurrentMana += Amount;
+    TFT_COMBAT_SCOPE(GainMana);
 
-    UE_LOG(LogTemp, Log, TEXT("✨ %s gained %.1f mana → %.1f/%.1f"), *UnitName, Amount, CurrentMana, MaxMana);
+    SetStat(&FUnitStatStore::CurrentMana, CurrentMana, CurrentMana + Amount);
+
+    TFT_RECORD_COMBAT_EVENT(ManaGained, GFrameCounter, RegistryHandle, INDEX_NONE, Amount);
+    UE_LOG(LogTFTCombat, Verbose, TEXT("✨ %s gained %.1f mana → %.1f/%.1f"), *UnitName, Amount, CurrentMana, MaxMana);
 
     if (CurrentMana >= MaxMana)
     {
-        UE_LOG(LogTemp, Log, TEXT("🌟 %s mana full! Casting ability..."), *UnitName);
-        CastAbility();
-        CurrentMana = 0.0f;
+        UE_LOG(LogTFTCombat, Verbose, TEXT("🌟 %s mana full! Casting ability..."), *UnitName);
+        CastOnFullMana();
+    }
+}
+
+void AUnitBase::CastOnFullMana()
+{
+    if (IsStunned())
+    {
+        return;
     }
+
+    CastAbility();
+    SetStat(&FUnitStatStore::CurrentMana, CurrentMana, 0.0f);
+}
+
+void AUnitBase::Heal(float Amount)
+{
+    if (!bIsAlive || Amount <= 0.0f)
+    {
+        return;
+    }
+
+    SetStat(&FUnitStatStore::CurrentHealth, CurrentHealth, FMath::Min(CurrentHealth + Amount, MaxHealth));
 }
 
 void AUnitBase::CastAbility()
 {
-    if (bIsCastingAbility)
+    TFT_COMBAT_SCOPE(CastAbility);
+
+    // Stuns block casting for Blueprint callers too
+    if (bIsCastingAbility || IsStunned())
     {
         return;
     }
 
     bIsCastingAbility = true;
+    UpdateCooldownMask();
 
     if (CurrentTarget)
     {
-        FaceTarget(CurrentTarget->GetActorLocation());
+        FaceTarget(CurrentTarget->GetActorLocation(), GetWorld()->GetDeltaSeconds());
     }
 
     PlayAnimMontage(AbilityMontage);
 
-    UE_LOG(LogTemp, Log, TEXT("🔮 %s casting ability!"), *UnitName);
+    // Resolved with every other cast of the frame
+    if (Abilities && Ability.Shape != EAbilityShape::None)
+    {
+        const FVector AimLocation = CurrentTarget ? CurrentTarget->GetActorLocation() : GetActorLocation();
+        Abilities->QueueCast(this, Ability, AimLocation);
+    }
 
-    FTimerHandle TimerHandle;
-    GetWorld()->GetTimerManager().SetTimer(TimerHandle, [this]()
-        {
-            bIsCastingAbility = false;
-            UE_LOG(LogTemp, Log, TEXT("✅ %s finished casting ability"), *UnitName);
-        }, 1.5f, false);
+    if (NetReplication)
+    {
+        NetReplication->NotifyAbilityCast(this);
+    }
+
+    if (EventBus)
+    {
+        EventBus->Push(ECombatEventType::CastStarted, this, CurrentTarget);
+    }
+
+    TFT_RECORD_COMBAT_EVENT(CastStarted, GFrameCounter, RegistryHandle, CurrentTarget ? CurrentTarget->GetUnitHandle() : INDEX_NONE);
+    UE_LOG(LogTFTCombat, Verbose, TEXT("🔮 %s casting ability!"), *UnitName);
+
+    ScheduleCombatEvent(ECombatClockEvent::CastEnd, FCombatRules::AbilityCastDuration);
 }
 
 // ============================================================================
@@ -360,16 +908,31 @@ void AUnitBase::CastAbility()
 
 void AUnitBase::MoveToTarget()
 {
-    if (!bCanMove || !AIControllerRef || !CurrentTarget)
+    TFT_COMBAT_SCOPE(MoveToTarget);
+
+    if (!bCanMove || StatusModifiers.Has(ECrowdControl::Root) || !AIControllerRef || !CurrentTarget)
     {
         return;
     }
 
+    // Only reaches the navigation system when the target changed or moved
+    if (MovementSubsystem)
+    {
+        MovementSubsystem->RequestMoveTo(this, AIControllerRef, CurrentTarget, StoppingDistance);
+        return;
+    }
+
     AIControllerRef->MoveToActor(CurrentTarget, StoppingDistance);
 }
 
 void AUnitBase::StopMovement()
 {
+    if (MovementSubsystem)
+    {
+        MovementSubsystem->RequestStop(this, AIControllerRef);
+        return;
+    }
+
     if (AIControllerRef)
     {
         AIControllerRef->StopMovement();
@@ -381,18 +944,28 @@ void AUnitBase::StopMovement()
     }
 }
 
-void AUnitBase::FaceTarget(const FVector& TargetLocation)
+void AUnitBase::FaceTarget(const FVector& TargetLocation, float DeltaTime)
 {
-    FVector Direction = (TargetLocation - GetActorLocation()).GetSafeNormal();
+    TFT_COMBAT_SCOPE(FaceTarget);
+
+    FVector Direction = TargetLocation - GetActorLocation();
     Direction.Z = 0.0f;
 
-    if (!Direction.IsNearlyZero())
+    if (Direction.IsNearlyZero())
+    {
+        return;
+    }
+
+    const FRotator NewRotation = Direction.Rotation();
+    const FRotator CurrentRotation = GetActorRotation();
+
+    // Already facing it: skip the interpolation and the component transform update
+    if (FMath::Abs(FRotator::NormalizeAxis(NewRotation.Yaw - CurrentRotation.Yaw)) <= GUnitFaceTargetTolerance)
     {
-        FRotator NewRotation = Direction.Rotation();
-        FRotator CurrentRotation = GetActorRotation();
-        FRotator SmoothedRotation = FMath::RInterpTo(CurrentRotation, NewRotation, GetWorld()->GetDeltaSeconds(), 10.0f);
-        SetActorRotation(SmoothedRotation);
+        return;
     }
+
+    SetActorRotation(FMath::RInterpTo(CurrentRotation, NewRotation, DeltaTime, 10.0f));
 }
 
 // ============================================================================
@@ -406,6 +979,12 @@ void AUnitBase::PlayAnimMontage(UAnimMontage* Montage)
         return;
     }
 
+    // Attack and ability montages are cosmetic; death still plays so the unit looks dead when seen again
+    if (Significance == EUnitSignificance::Minimal && Montage != DeathMontage)
+    {
+        return;
+    }
+
     UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
     if (AnimInstance)
     {
@@ -419,37 +998,59 @@ void AUnitBase::PlayAnimMontage(UAnimMontage* Montage)
 
 void AUnitBase::SetState(EUnitState NewState)
 {
+    TFT_COMBAT_SCOPE(SetState);
+
     if (CurrentState == NewState)
     {
         return;
     }
 
+    const EUnitState OldState = CurrentState;
     CurrentState = NewState;
+    UpdateCooldownMask();
+
+    // Every state change comes from outside combat, so these are the replay's inputs
+    if (ReplayRecorder)
+    {
+        ReplayRecorder->RecordStateChange(this, OldState, NewState);
+    }
+
+    TFT_RECORD_COMBAT_EVENT(StateChanged, GFrameCounter, RegistryHandle, INDEX_NONE, 0.0f, (uint8)NewState);
     OnStateChanged.Broadcast(NewState);
+    if (EventBus)
+    {
+        EventBus->Push(ECombatEventType::StateChanged, this, nullptr, 0.0f, (uint8)NewState);
+    }
+
+    if (StarCombine && OldState == EUnitState::Combat)
+    {
+        StarCombine->NotifyLeftCombat(this);
+    }
 
     switch (NewState)
     {
     case EUnitState::Bench:
-        CurrentTarget = nullptr;
+        SetCurrentTarget(nullptr);
+        RetargetAttackers();
         bCanMove = false;
         bCanAttack = false;
         StopMovement();
-        UE_LOG(LogTemp, Log, TEXT("🪑 %s benched"), *UnitName);
+        UE_LOG(LogTFTCombat, Verbose, TEXT("🪑 %s benched"), *UnitName);
         break;
 
     case EUnitState::BoardIdle:
         bCanMove = true;
         bCanAttack = true;
-        AttackCooldown = 0.0f;
-        UE_LOG(LogTemp, Log, TEXT("📍 %s placed on board"), *UnitName);
+        SetAttackCooldown(0.0f);
+        UE_LOG(LogTFTCombat, Verbose, TEXT("📍 %s placed on board"), *UnitName);
         break;
 
     case EUnitState::Combat:
-        CurrentTarget = GetNearestEnemy();
-        AttackCooldown = 0.0f;
+        SetCurrentTarget(GetNearestEnemy());
+        SetAttackCooldown(0.0f);
         bCanMove = true;
         bCanAttack = true;
-        UE_LOG(LogTemp, Log, TEXT("⚔️ %s entered combat!"), *UnitName);
+        UE_LOG(LogTFTCombat, Verbose, TEXT("⚔️ %s entered combat!"), *UnitName);
         break;
     }
 }
@@ -460,38 +1061,111 @@ void AUnitBase::SetState(EUnitState NewState)
 
 void AUnitBase::Die()
 {
+    TFT_COMBAT_SCOPE(Die);
+
     if (!bIsAlive)
     {
         return;
     }
 
-    UE_LOG(LogTemp, Warning, TEXT("💀 %s died!"), *UnitName);
+    TFT_RECORD_COMBAT_EVENT(Death, GFrameCounter, RegistryHandle, INDEX_NONE);
+    UE_LOG(LogTFTCombat, Log, TEXT("💀 %s died!"), *UnitName);
 
     bIsAlive = false;
+    SetTargetable(false);
+    ClearStatusEffects();
+    UpdateCooldownMask();
+    SetCurrentTarget(nullptr);
+    RetargetAttackers();
     OnUnitDeath.Broadcast(this);
+    if (EventBus)
+    {
+        EventBus->Push(ECombatEventType::Death, this, nullptr);
+    }
     StopMovement();
-    CurrentTarget = nullptr;
     PlayAnimMontage(DeathMontage);
     GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 
+    if (NetReplication)
+    {
+        NetReplication->NotifyUnitDied(this);
+    }
+
     if (Team == ETeam::Player)
     {
-        FTimerHandle TimerHandle;
-        GetWorld()->GetTimerManager().SetTimer(TimerHandle, [this]()
-            {
-                SetActorHiddenInGame(true);
-                SetActorEnableCollision(false);
-                UE_LOG(LogTemp, Log, TEXT("👻 %s hidden after death"), *UnitName);
-            }, 1.5f, false);
+        ScheduleCombatEvent(ECombatClockEvent::HideAfterDeath, FCombatRules::PlayerHideDelay);
     }
     else
     {
-        FTimerHandle TimerHandle;
-        GetWorld()->GetTimerManager().SetTimer(TimerHandle, [this]()
-            {
-                UE_LOG(LogTemp, Log, TEXT("🗑️ %s destroyed"), *UnitName);
-                Destroy();
-            }, 2.0f, false);
+        ScheduleCombatEvent(ECombatClockEvent::ReleaseAfterDeath, FCombatRules::EnemyDestroyDelay);
+    }
+}
+
+// ============================================================================
+// COMBAT CLOCK
+// ============================================================================
+
+void AUnitBase::ScheduleCombatEvent(ECombatClockEvent Type, float Delay)
+{
+    if (CombatClock && RegistryHandle != INDEX_NONE)
+    {
+        CombatClock->Schedule(RegistryHandle, Type, Delay);
+        return;
+    }
+
+    FTimerHandle& TimerHandle = Type == ECombatClockEvent::CastEnd ? CastTimerHandle : DeathTimerHandle;
+    GetWorldTimerManager().SetTimer(TimerHandle,
+        FTimerDelegate::CreateUObject(this, &AUnitBase::HandleCombatClockEvent, Type), Delay, false);
+}
+
+void AUnitBase::CancelCombatEvents()
+{
+    if (CombatClock && RegistryHandle != INDEX_NONE)
+    {
+        CombatClock->CancelAll(RegistryHandle);
+    }
+
+    GetWorldTimerManager().ClearTimer(CastTimerHandle);
+    GetWorldTimerManager().ClearTimer(DeathTimerHandle);
+}
+
+void AUnitBase::HandleCombatClockEvent(ECombatClockEvent Type)
+{
+    switch (Type)
+    {
+    case ECombatClockEvent::CastEnd:
+        bIsCastingAbility = false;
+        UpdateCooldownMask();
+        WakeAI();
+        if (EventBus)
+        {
+            EventBus->Push(ECombatEventType::CastFinished, this, nullptr);
+        }
+        TFT_RECORD_COMBAT_EVENT(CastFinished, GFrameCounter, RegistryHandle, INDEX_NONE);
+        UE_LOG(LogTFTCombat, Verbose, TEXT("✅ %s finished casting ability"), *UnitName);
+        break;
+
+    case ECombatClockEvent::HideAfterDeath:
+        SetActorHiddenInGame(true);
+        SetActorEnableCollision(false);
+        UE_LOG(LogTFTCombat, Log, TEXT("👻 %s hidden after death"), *UnitName);
+        break;
+
+    case ECombatClockEvent::ReleaseAfterDeath:
+        // Recycled for the next round instead of respawned
+        if (UUnitPoolSubsystem* Pool = GetWorld()->GetSubsystem<UUnitPoolSubsystem>())
+        {
+            UE_LOG(LogTFTCombat, Log, TEXT("♻️ %s returned to pool"), *UnitName);
+            Pool->ReleaseUnit(this);
+            break;
+        }
+
+        UE_LOG(LogTFTCombat, Log, TEXT("🗑️ %s destroyed"), *UnitName);
+        Destroy();
+        break;
+
+    default:
+        break;
     }
 }
 
@@ -501,23 +1175,311 @@ void AUnitBase::Die()
 
 void AUnitBase::ResetAfterCombat()
 {
+    // A hide or cast end from the last round must not land on the reset unit
+    CancelCombatEvents();
+    ClearStatusEffects();
+    RemoveProjectiles();
+
     SetActorHiddenInGame(false);
     SetActorEnableCollision(true);
     bIsAlive = true;
+    SetTargetable(true);
     CurrentHealth = MaxHealth;
     CurrentMana = 0.0f;
-    AttackCooldown = 0.0f;
     bIsCastingAbility = false;
-    CurrentTarget = nullptr;
+    SetAttackCooldown(0.0f);
+    RefreshCombatStats();
+    SetCurrentTarget(nullptr);
     SetState(EUnitState::BoardIdle);
     GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
 
-    UE_LOG(LogTemp, Log, TEXT("🔄 %s reset for new round"), *UnitName);
+    if (EventBus)
+    {
+        EventBus->Push(ECombatEventType::Reset, this, nullptr);
+    }
+
+    TFT_RECORD_COMBAT_EVENT(Reset, GFrameCounter, RegistryHandle, INDEX_NONE);
+    UE_LOG(LogTFTCombat, Log, TEXT("🔄 %s reset for new round"), *UnitName);
+}
+
+void AUnitBase::OnReleasedToPool()
+{
+    bInPool = true;
+
+    // Pending cast or death events must not fire on a pooled unit
+    CancelCombatEvents();
+    ClearStatusEffects();
+    RemoveProjectiles();
+
+    StopMovement();
+    SetState(EUnitState::Bench);
+    SetTargetable(false);
+    bIsCastingAbility = false;
+    UpdateCooldownMask();
+
+    if (BoardGrid)
+    {
+        BoardGrid->RemoveUnit(RegistryHandle);
+    }
+
+    SetActorHiddenInGame(true);
+    SetActorEnableCollision(false);
+    SetActorTickEnabled(false);
+
+    UpdateStarCombineTracking();
+
+    if (ReplayRecorder)
+    {
+        ReplayRecorder->RemoveUnit(this);
+    }
+
+    // Buckets are per class, so the next acquire of any kind must start from the class
+    RestoreClassDefaults();
+}
+
+void AUnitBase::OnAcquiredFromPool(const FTransform& Transform, ETeam NewTeam, int32 NewBoardId)
+{
+    bInPool = false;
+
+    // Same handle, new unit: records keyed by the old life must not match it
+    if (UnitRegistry && RegistryHandle != INDEX_NONE)
+    {
+        UnitRegistry->BumpGeneration(RegistryHandle);
+    }
+
+    SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+    Team = NewTeam;
+    BoardId = NewBoardId;
+    SetActorTickEnabled(true);
+
+    // Same starting point as BeginPlay: class definition and star level, full stats, then straight into combat
+    ApplyNamedDefinition();
+    if (DefinitionIndex == INDEX_NONE)
+    {
+        SetStarLevel(StarLevel);
+    }
+    ResetAfterCombat();
+    SetState(EUnitState::Combat);
+    UpdateStarCombineTracking();
 }
 
 void AUnitBase::FullResetToPrep()
 {
     ResetAfterCombat();
     SetState(EUnitState::Bench);
-    UE_LOG(LogTemp, Log, TEXT("🔄 %s fully reset to prep phase"), *UnitName);
+    UE_LOG(LogTFTCombat, Log, TEXT("🔄 %s fully reset to prep phase"), *UnitName);
+}
+
+// ============================================================================
+// SNAPSHOTS
+// ============================================================================
+
+void AUnitBase::CaptureCombatSnapshot(FUnitCombatSnapshot& OutSnapshot) const
+{
+    OutSnapshot.Handle = RegistryHandle;
+    OutSnapshot.Generation = UnitRegistry ? UnitRegistry->GetGeneration(RegistryHandle) : 0;
+    OutSnapshot.Location = FVector3f(GetActorLocation());
+    OutSnapshot.Yaw = (float)GetActorRotation().Yaw;
+    OutSnapshot.CurrentHealth = CurrentHealth;
+    OutSnapshot.CurrentMana = CurrentMana;
+    OutSnapshot.AttackCooldown = GetAttackCooldown();
+    OutSnapshot.TargetHandle = CurrentTarget ? CurrentTarget->GetUnitHandle() : INDEX_NONE;
+    OutSnapshot.TargetGeneration = UnitRegistry ? UnitRegistry->GetGeneration(OutSnapshot.TargetHandle) : 0;
+    OutSnapshot.State = (uint8)CurrentState;
+
+    OutSnapshot.Flags = EUnitSnapshotFlags::None;
+    OutSnapshot.Flags |= bIsAlive ? EUnitSnapshotFlags::Alive : EUnitSnapshotFlags::None;
+    OutSnapshot.Flags |= bCanMove ? EUnitSnapshotFlags::CanMove : EUnitSnapshotFlags::None;
+    OutSnapshot.Flags |= bCanAttack ? EUnitSnapshotFlags::CanAttack : EUnitSnapshotFlags::None;
+    OutSnapshot.Flags |= bIsCastingAbility ? EUnitSnapshotFlags::CastingAbility : EUnitSnapshotFlags::None;
+    OutSnapshot.Flags |= IsHidden() ? EUnitSnapshotFlags::Hidden : EUnitSnapshotFlags::None;
+}
+
+void AUnitBase::RestoreCombatSnapshot(const FUnitCombatSnapshot& Snapshot)
+{
+    // Effects and flights are not in the snapshot; keeping them would apply them twice
+    CancelCombatEvents();
+    ClearStatusEffects();
+    RemoveProjectiles();
+    StopMovement();
+
+    SetActorLocationAndRotation(FVector(Snapshot.Location), FRotator(0.0f, Snapshot.Yaw, 0.0f), false, nullptr, ETeleportType::ResetPhysics);
+
+    // Assigned directly: SetState would pick a new target and reset the cooldown
+    CurrentState = (EUnitState)Snapshot.State;
+    bIsAlive = EnumHasAnyFlags(Snapshot.Flags, EUnitSnapshotFlags::Alive);
+    bCanMove = EnumHasAnyFlags(Snapshot.Flags, EUnitSnapshotFlags::CanMove);
+    bCanAttack = EnumHasAnyFlags(Snapshot.Flags, EUnitSnapshotFlags::CanAttack);
+    bIsCastingAbility = EnumHasAnyFlags(Snapshot.Flags, EUnitSnapshotFlags::CastingAbility);
+
+    const bool bHidden = EnumHasAnyFlags(Snapshot.Flags, EUnitSnapshotFlags::Hidden);
+    SetActorHiddenInGame(bHidden);
+    SetActorEnableCollision(!bHidden);
+    GetCapsuleComponent()->SetCollisionEnabled(bIsAlive ? ECollisionEnabled::QueryAndPhysics : ECollisionEnabled::NoCollision);
+
+    // A unit rewound to before its death should not stay in the death pose
+    if (bIsAlive && GetMesh() && GetMesh()->GetAnimInstance())
+    {
+        GetMesh()->GetAnimInstance()->StopAllMontages(0.0f);
+    }
+
+    SetTargetable(bIsAlive);
+    SetStat(&FUnitStatStore::CurrentHealth, CurrentHealth, Snapshot.CurrentHealth);
+    SetStat(&FUnitStatStore::CurrentMana, CurrentMana, Snapshot.CurrentMana);
+    SetAttackCooldown(Snapshot.AttackCooldown);
+    UpdateCooldownMask();
+
+    AUnitBase* Target = UnitRegistry ? UnitRegistry->GetUnit(Snapshot.TargetHandle) : nullptr;
+    if (Target && UnitRegistry->GetGeneration(Snapshot.TargetHandle) != Snapshot.TargetGeneration)
+    {
+        Target = nullptr;
+    }
+    SetCurrentTarget(Target);
+
+    for (int32 TypeIndex = 0; TypeIndex < FUnitCombatSnapshot::NumEventTypes; ++TypeIndex)
+    {
+        if (Snapshot.EventDelays[TypeIndex] >= 0.0f)
+        {
+            ScheduleCombatEvent((ECombatClockEvent)TypeIndex, Snapshot.EventDelays[TypeIndex]);
+        }
+    }
+
+    WakeAI();
+}
+
+// ============================================================================
+// REPLAY
+// ============================================================================
+
+void AUnitBase::GetCombatUnitDesc(FCombatUnitDesc& OutDesc) const
+{
+    const FVector Location = GetActorLocation();
+
+    OutDesc.Team = Team;
+    OutDesc.InitialState = CurrentState;
+    OutDesc.Position = FVector2f((float)Location.X, (float)Location.Y);
+    OutDesc.Cell = BoardGrid ? BoardGrid->GetUnitCell(this) : INDEX_NONE;
+    OutDesc.MaxHealth = MaxHealth;
+    OutDesc.AttackDamage = AttackDamage;
+    OutDesc.AttackSpeed = AttackSpeed;
+    OutDesc.AttackRange = AttackRange;
+    OutDesc.AttackRangeHexes = GetAttackRangeHexes();
+    OutDesc.Armor = Armor;
+    OutDesc.MagicResist = MagicResist;
+    OutDesc.MaxMana = MaxMana;
+    OutDesc.MovementSpeed = MovementSpeed;
+    OutDesc.StoppingDistance = StoppingDistance;
+}
+
+bool AUnitBase::CanFightHeadless() const
+{
+    if (Ability.Shape != EAbilityShape::None || ProjectileSpeed > 0.0f)
+    {
+        return false;
+    }
+
+    return !StatusEffects || RegistryHandle == INDEX_NONE || StatusEffects->GetNumEffects(this) == 0;
+}
+
+void AUnitBase::ApplyHeadlessOutcome(bool bSurvived, float Health, float Mana)
+{
+    if (!bSurvived)
+    {
+        SetStat(&FUnitStatStore::CurrentHealth, CurrentHealth, 0.0f);
+        Die();
+        return;
+    }
+
+    SetStat(&FUnitStatStore::CurrentHealth, CurrentHealth, FMath::Clamp(Health, 1.0f, MaxHealth));
+    SetStat(&FUnitStatStore::CurrentMana, CurrentMana, FMath::Clamp(Mana, 0.0f, MaxMana));
+    SetState(EUnitState::BoardIdle);
+}
+
+// ============================================================================
+// SIGNIFICANCE
+// ============================================================================
+
+void AUnitBase::SetSignificance(EUnitSignificance NewSignificance, float TickInterval)
+{
+    // Without the AI scheduler Think() runs from Tick, so the tick rate is gameplay. On a
+    // server, facing replicates to clients that may be watching, and a dedicated server has
+    // no camera to rate against; authoritative gameplay is never reduced there
+    const bool bReplicatesGameplay = HasAuthority() && GetNetMode() != NM_Standalone;
+    if ((!AIScheduler && HasAuthority()) || bReplicatesGameplay)
+    {
+        NewSignificance = EUnitSignificance::Full;
+        TickInterval = 0.0f;
+    }
+
+    Significance = NewSignificance;
+
+    if (GetActorTickInterval() != TickInterval)
+    {
+        SetActorTickInterval(TickInterval);
+        GetMesh()->SetComponentTickInterval(TickInterval);
+    }
+}
+
+// ============================================================================
+// REPLICATION
+// ============================================================================
+
+void AUnitBase::ApplyReplicatedCombatState(const FUnitCombatStateItem& State)
+{
+    const bool bWasAlive = bIsAlive;
+
+    Team = State.Team;
+    MaxHealth = State.MaxHealth;
+    MaxMana = State.MaxMana;
+    CurrentHealth = State.GetHealth();
+    CurrentMana = State.GetMana();
+    bIsAlive = State.IsAlive();
+    bIsCastingAbility = State.IsCastingAbility();
+    SyncReplicatedRegistryState(State.Target);
+
+    if (CurrentState != State.State)
+    {
+        CurrentState = State.State;
+        OnStateChanged.Broadcast(CurrentState);
+        if (EventBus)
+        {
+            EventBus->Push(ECombatEventType::StateChanged, this, nullptr, 0.0f, (uint8)CurrentState);
+        }
+    }
+
+    // Units reset for the next round get their collision back
+    if (bIsAlive && !bWasAlive)
+    {
+        GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+    }
+}
+
+void AUnitBase::PlayReplicatedDeath()
+{
+    bIsAlive = false;
+    SyncReplicatedRegistryState(nullptr);
+    OnUnitDeath.Broadcast(this);
+    if (EventBus)
+    {
+        EventBus->Push(ECombatEventType::Death, this, nullptr);
+    }
+    PlayAnimMontage(DeathMontage);
+    GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+}
+
+void AUnitBase::PlayReplicatedCast()
+{
+    PlayAnimMontage(AbilityMontage);
+}
+
+void AUnitBase::SyncReplicatedRegistryState(AUnitBase* NewTarget)
+{
+    // The server's registry is driven by combat itself
+    if (HasAuthority())
+    {
+        return;
+    }
+
+    SetTargetable(bIsAlive);
+    SetCurrentTarget(bIsAlive ? NewTarget : nullptr);
 }
\ No newline at end of file
@@ -3,68 +3,32 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
+#include "CombatTypes.h"
+#include "UnitStatStore.h"
+#include "StatusEffects.h"
+#include "Abilities.h"
 #include "UnitBase.generated.h"
 
 // Forward declarations
 class UAnimMontage;
 class AAIController;
-
-// ============================================================================
-// ENUMS
-// ============================================================================
-
-UENUM(BlueprintType)
-enum class ETeam : uint8
-{
-    Player UMETA(DisplayName = "Player"),
-    Enemy UMETA(DisplayName = "Enemy"),
-    Neutral UMETA(DisplayName = "Neutral")
-};
-
-UENUM(BlueprintType)
-enum class EUnitState : uint8
-{
-    Bench UMETA(DisplayName = "Bench"),
-    BoardIdle UMETA(DisplayName = "Board Idle"),
-    Combat UMETA(DisplayName = "Combat")
-};
-
-UENUM(BlueprintType)
-enum class EDamageType : uint8
-{
-    Physical UMETA(DisplayName = "Physical"),
-    Magical UMETA(DisplayName = "Magical"),
-    TrueDamage UMETA(DisplayName = "True Damage")
-};
-
-// ============================================================================
-// STRUCTS
-// ============================================================================
-
-USTRUCT(BlueprintType)
-struct FDamageInfo
-{
-    GENERATED_BODY()
-
-    UPROPERTY(BlueprintReadWrite)
-    float Amount;
-
-    UPROPERTY(BlueprintReadWrite)
-    EDamageType Type;
-
-    UPROPERTY(BlueprintReadWrite)
-    AActor* Causer;
-
-    FDamageInfo()
-        : Amount(0.0f), Type(EDamageType::Physical), Causer(nullptr)
-    {
-    }
-
-    FDamageInfo(float InAmount, EDamageType InType, AActor* InCauser = nullptr)
-        : Amount(InAmount), Type(InType), Causer(InCauser)
-    {
-    }
-};
+class UUnitRegistrySubsystem;
+class UCombatDamageSubsystem;
+class UUnitAISchedulerSubsystem;
+class UUnitMovementSubsystem;
+class UBoardGridSubsystem;
+class UCombatClockSubsystem;
+class UStarCombineSubsystem;
+class UCombatReplaySubsystem;
+class UCombatReplicationSubsystem;
+class UCombatEventBusSubsystem;
+class UStatusEffectSubsystem;
+class UProjectileSubsystem;
+class UAbilitySubsystem;
+enum class ECombatClockEvent : uint8;
+struct FUnitCombatSnapshot;
+struct FCombatUnitDesc;
+struct FUnitCombatStateItem;
 
 // ============================================================================
 // MAIN UNIT BASE CLASS
@@ -88,12 +52,39 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Unit Info")
     int32 StarLevel;
 
+    /**
+     * The authored health and attack damage are already those of StarLevel, as in units made
+     * before star scaling. Clear it to author one-star stats and have StarLevel scale them.
+     * Ignored for units with a DefinitionName.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Unit Info")
+    bool bStatsIncludeStarLevel;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Unit Info")
     ETeam Team;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Unit Info")
     int32 TeamID;
 
+    /** Board this unit fights on. Units only target enemies on the same board, so several boards can share a level. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Unit Info", meta = (ClampMin = "0"))
+    int32 BoardId;
+
+    /** Unit type in the cooked unit definition table. When set, BeginPlay takes stats and montages from it. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Unit Info")
+    FName DefinitionName;
+
+    /** Loads stats for StarLevel and montages from a unit definition, and refills health and mana. */
+    UFUNCTION(BlueprintCallable, Category = "Unit Info")
+    bool ApplyUnitDefinition(int32 NewDefinitionIndex, int32 NewStarLevel);
+
+    /** Sets StarLevel and rescales health and damage with FStarScaling, or from the unit definition's star stats. */
+    UFUNCTION(BlueprintCallable, Category = "Unit Info")
+    void SetStarLevel(int32 NewStarLevel);
+
+    /** Definition name, or the class name for units without one. Copies of the same type combine. */
+    FName GetUnitTypeName() const;
+
     // ========================================================================
     // PROPERTIES - Stats
     // ========================================================================
@@ -113,6 +104,21 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats")
     float AttackRange;
 
+    /**
+     * Attack range in board hexes, used while both units stand on the board. AttackRange covers units off it.
+     * 0 derives it from AttackRange and the board's hex width, so units authored in world units keep their reach.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats", meta = (ClampMin = "0"))
+    int32 AttackRangeHexes;
+
+    /** AttackRangeHexes, or the hex range derived from AttackRange when it is 0. */
+    UFUNCTION(BlueprintPure, Category = "Stats")
+    int32 GetAttackRangeHexes() const;
+
+    /** Units per second of the auto attack projectile. 0 hits instantly, as melee units do. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats", meta = (ClampMin = "0"))
+    float ProjectileSpeed;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats")
     float Armor;
 
@@ -125,6 +131,17 @@ public:
     UPROPERTY(BlueprintReadOnly, Category = "Stats|Mana")
     float CurrentMana;
 
+    /**
+     * Pushes the stat properties above, with status effect modifiers applied, into the unit
+     * stat store. The properties stay the unmodified base. Call after changing them at runtime.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Stats")
+    void RefreshCombatStats();
+
+    /** Seconds until the next auto attack, read from the unit stat store. */
+    UFUNCTION(BlueprintPure, Category = "Stats")
+    float GetAttackCooldown() const;
+
     // ========================================================================
     // PROPERTIES - Combat State
     // ========================================================================
@@ -157,6 +174,14 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Animation")
     UAnimMontage* DeathMontage;
 
+    // ========================================================================
+    // PROPERTIES - Ability
+    // ========================================================================
+
+    /** Area and payload of the ability cast on full mana, aimed at the current target. Shape None only plays the montage. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ability")
+    FAbilityDefinition Ability;
+
     // ========================================================================
     // PROPERTIES - Movement
     // ========================================================================
@@ -180,6 +205,16 @@ public:
     UFUNCTION(BlueprintCallable, Category = "AI")
     AUnitBase* GetNearestEnemy();
 
+    /** Switches to NewTarget (or none) as if FindNewTarget had picked it. */
+    void RetargetTo(AUnitBase* NewTarget);
+
+    /** True while the unit is alive, in combat and not locked in a cast. */
+    UFUNCTION(BlueprintPure, Category = "AI")
+    bool IsReadyToThink() const;
+
+    /** Asks the AI scheduler to run Think() for this unit on its next update. */
+    void WakeAI();
+
     // ========================================================================
     // PUBLIC METHODS - Combat
     // ========================================================================
@@ -193,9 +228,16 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Combat")
     void TakeDamage(const FDamageInfo& DamageInfo);
 
+    /** Applies damage that has already been through armor/magic resist reduction. */
+    void ApplyReducedDamage(const FDamageInfo& DamageInfo, float FinalDamage);
+
     UFUNCTION(BlueprintCallable, Category = "Combat")
     void GainMana(float Amount);
 
+    /** Restores health, up to MaxHealth. */
+    UFUNCTION(BlueprintCallable, Category = "Combat")
+    void Heal(float Amount);
+
     UFUNCTION(BlueprintCallable, Category = "Combat")
     virtual void CastAbility();
 
@@ -219,6 +261,9 @@ public:
     UFUNCTION(BlueprintPure, Category = "State")
     EUnitState GetState() const { return CurrentState; }
 
+    /** Unit registry handle, or INDEX_NONE while not in play. */
+    int32 GetUnitHandle() const { return RegistryHandle; }
+
     // ========================================================================
     // PUBLIC METHODS - Reset Functions
     // ========================================================================
@@ -229,6 +274,86 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Reset")
     void FullResetToPrep();
 
+    // ========================================================================
+    // PUBLIC METHODS - Pooling
+    // ========================================================================
+
+    /** Runs a cast-end or post-death step scheduled on the combat clock. */
+    void HandleCombatClockEvent(ECombatClockEvent Type);
+
+    /** Called by UUnitPoolSubsystem. Benches, hides and stops the unit. */
+    void OnReleasedToPool();
+
+    /** Called by UUnitPoolSubsystem before FinishSpawning a prewarmed unit, so BeginPlay leaves it out of combat. */
+    void MarkSpawningIntoPool() { bInPool = true; }
+
+    /** Called by UUnitPoolSubsystem. Brings the unit back as a fresh spawn would start. */
+    void OnAcquiredFromPool(const FTransform& Transform, ETeam NewTeam, int32 NewBoardId);
+
+    UFUNCTION(BlueprintPure, Category = "Pool")
+    bool IsInPool() const { return bInPool; }
+
+    // ========================================================================
+    // PUBLIC METHODS - Status Effects
+    // ========================================================================
+
+    /** Called by UStatusEffectSubsystem when the unit's effects change. Recomputes the cached stats combat reads. */
+    void SetStatusModifiers(const FStatusModifiers& NewModifiers);
+
+    const FStatusModifiers& GetStatusModifiers() const { return StatusModifiers; }
+
+    UFUNCTION(BlueprintPure, Category = "Status Effects")
+    bool IsStunned() const { return StatusModifiers.Has(ECrowdControl::Stun); }
+
+    // ========================================================================
+    // PUBLIC METHODS - Significance
+    // ========================================================================
+
+    /**
+     * Called by UUnitSignificanceSubsystem. Sets the actor and mesh tick interval; units at
+     * Minimal also skip facing and attack/ability montages. Movement, targeting and damage
+     * do not depend on it.
+     */
+    void SetSignificance(EUnitSignificance NewSignificance, float TickInterval);
+
+    UFUNCTION(BlueprintPure, Category = "Significance")
+    EUnitSignificance GetSignificance() const { return Significance; }
+
+    // ========================================================================
+    // PUBLIC METHODS - Snapshots
+    // ========================================================================
+
+    /** Fills everything but the event delays, which UCombatSnapshotSubsystem reads from the combat clock. */
+    void CaptureCombatSnapshot(FUnitCombatSnapshot& OutSnapshot) const;
+
+    /** Puts the unit back into a captured state and reschedules its pending cast end or death step. */
+    void RestoreCombatSnapshot(const FUnitCombatSnapshot& Snapshot);
+
+    /** Current stats, team, position and board cell as an FCombatSimulation unit, for replay logs. */
+    void GetCombatUnitDesc(FCombatUnitDesc& OutDesc) const;
+
+    /**
+     * False when the unit uses mechanics FCombatSimulation does not model (area abilities,
+     * projectiles, active status effects), so its fight must be played with actors.
+     */
+    bool CanFightHeadless() const;
+
+    /** Takes the end state of a headless fight: survivors keep Health and Mana and go idle on the board, the rest die. */
+    void ApplyHeadlessOutcome(bool bSurvived, float Health, float Mana);
+
+    // ========================================================================
+    // PUBLIC METHODS - Replication
+    // ========================================================================
+
+    /** Client side of ABoardCombatState: takes the server's state as is, without running any combat rules. */
+    void ApplyReplicatedCombatState(const FUnitCombatStateItem& State);
+
+    /** Client side of the board's death event: death montage and OnUnitDeath, without Die()'s gameplay. */
+    void PlayReplicatedDeath();
+
+    /** Client side of the board's cast event. */
+    void PlayReplicatedCast();
+
     // ========================================================================
     // PUBLIC METHODS - Death
     // ========================================================================
@@ -254,15 +379,78 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
-    void FaceTarget(const FVector& TargetLocation);
+    void FaceTarget(const FVector& TargetLocation, float DeltaTime);
     float CalculateDamageReduction(float IncomingDamage, EDamageType DamageType) const;
     void PlayAnimMontage(UAnimMontage* Montage);
 
 private:
     EUnitState CurrentState;
-    float AttackCooldown;
     AAIController* AIControllerRef;
+    UUnitRegistrySubsystem* UnitRegistry;
+    UCombatDamageSubsystem* DamageSubsystem;
+    UUnitAISchedulerSubsystem* AIScheduler;
+    UUnitMovementSubsystem* MovementSubsystem;
+    UBoardGridSubsystem* BoardGrid;
+    UCombatClockSubsystem* CombatClock;
+    UStarCombineSubsystem* StarCombine;
+    UCombatReplaySubsystem* ReplayRecorder;
+    UCombatReplicationSubsystem* NetReplication;
+    UCombatEventBusSubsystem* EventBus;
+    UStatusEffectSubsystem* StatusEffects;
+    UProjectileSubsystem* Projectiles;
+    UAbilitySubsystem* Abilities;
+    int32 RegistryHandle;
+    int32 DefinitionIndex;
+    EUnitSignificance Significance;
+    FStatusModifiers StatusModifiers;
+
+    // One-star health and damage of units without a definition; star levels scale from these
+    float BaseMaxHealth;
+    float BaseAttackDamage;
+    bool bInPool;
+
+    // Timer manager fallback for units outside the registry (no combat clock handle)
+    FTimerHandle CastTimerHandle;
+    FTimerHandle DeathTimerHandle;
+
+    void ScheduleCombatEvent(ECombatClockEvent Type, float Delay);
+    void CancelCombatEvents();
+
+    void CaptureBaseStats();
+    void UpdateStarCombineTracking();
+
+    /** Applies DefinitionName from the unit definition table, if set. */
+    void ApplyNamedDefinition();
+
+    /** Puts the name, definition, stats and montages back to the class defaults, dropping any applied definition. */
+    void RestoreClassDefaults();
+
+    void RegisterWithRegistry();
+    void UnregisterFromRegistry();
+    void SetTargetable(bool bTargetable);
+    void ClearStatusEffects();
+
+    /** Casts and empties the mana bar unless stunned; a stunned unit keeps full mana for its next Think. */
+    void CastOnFullMana();
+    void RemoveProjectiles();
+
+    // CurrentTarget is mirrored in the registry's reverse targeting index
+    void SetCurrentTarget(AUnitBase* NewTarget);
+    void RetargetAttackers();
+
+    /** The only registry writes on a network client: targetable while alive, and the server's target. */
+    void SyncReplicatedRegistryState(AUnitBase* NewTarget);
+
+    bool IsTargetInAttackRange() const;
+
+    // Hot stats live in the registry's stat store while the unit is in play
+    FUnitStatStore* GetStatStore() const;
+    float GetStat(FUnitStatStore::FStatArray FUnitStatStore::* Field, float Fallback) const;
+    void SetStat(FUnitStatStore::FStatArray FUnitStatStore::* Field, float& Mirror, float Value);
+    void SetAttackCooldown(float Value);
+    void UpdateCooldownMask();
 
 public:
     virtual void Tick(float DeltaTime) override;
@@ -0,0 +1,103 @@
+// UnitDefinitionSubsystem.cpp
+
+#include "UnitDefinitionSubsystem.h"
+#include "TFTUnrealDemo.h"
+#include "Animation/AnimMontage.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
+
+// ============================================================================
+// CONSOLE VARIABLES
+// ============================================================================
+
+static FString GUnitDefinitionFile = TEXT("Data/UnitDefinitions.tftunits");
+static FAutoConsoleVariableRef CVarUnitDefinitionFile(
+    TEXT("TFT.Units.DefinitionFile"),
+    GUnitDefinitionFile,
+    TEXT("Cooked unit definition file, relative to the project content directory. Read when the game instance starts."));
+
+// ============================================================================
+// AUTHORING ROWS
+// ============================================================================
+
+FUnitDefinitionStats FUnitDefinitionStarStats::ToStats() const
+{
+    FUnitDefinitionStats Stats;
+    Stats.MaxHealth = MaxHealth;
+    Stats.AttackDamage = AttackDamage;
+    Stats.AttackSpeed = AttackSpeed;
+    Stats.AttackRange = AttackRange;
+    Stats.AttackRangeHexes = FMath::Max(1, AttackRangeHexes);
+    Stats.Armor = Armor;
+    Stats.MagicResist = MagicResist;
+    Stats.MaxMana = MaxMana;
+    Stats.MovementSpeed = MovementSpeed;
+    Stats.StoppingDistance = StoppingDistance;
+    return Stats;
+}
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+void UUnitDefinitionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    const FString Filename = FPaths::ProjectContentDir() / GUnitDefinitionFile;
+
+    // A missing file is fine: units then keep their Blueprint stats
+    if (!FPaths::FileExists(Filename))
+    {
+        UE_LOG(LogTFTCombat, Log, TEXT("No unit definition file at %s"), *Filename);
+        return;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    if (Table.LoadFromFile(*Filename))
+    {
+        Montages.SetNumZeroed(Table.Num() * (int32)EUnitDefinitionMontage::Count);
+        MontagesResolved.Init(false, Montages.Num());
+
+        UE_LOG(LogTFTCombat, Log, TEXT("Loaded %d unit definitions from %s in %.2f ms"),
+            Table.Num(), *Filename, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+    }
+}
+
+void UUnitDefinitionSubsystem::Deinitialize()
+{
+    Montages.Reset();
+    MontagesResolved.Reset();
+    Table.Unload();
+
+    Super::Deinitialize();
+}
+
+// ============================================================================
+// MONTAGES
+// ============================================================================
+
+UAnimMontage* UUnitDefinitionSubsystem::GetMontage(int32 DefinitionIndex, EUnitDefinitionMontage Montage)
+{
+    if (!Table.IsValidIndex(DefinitionIndex))
+    {
+        return nullptr;
+    }
+
+    const int32 Slot = DefinitionIndex * (int32)EUnitDefinitionMontage::Count + (int32)Montage;
+
+    if (!MontagesResolved[Slot])
+    {
+        MontagesResolved[Slot] = true;
+
+        const ANSICHAR* Path = Table.GetMontagePath(DefinitionIndex, Montage);
+        if (*Path)
+        {
+            Montages[Slot] = Cast<UAnimMontage>(FSoftObjectPath(UTF8_TO_TCHAR(Path)).TryLoad());
+        }
+    }
+
+    return Montages[Slot];
+}
@@ -0,0 +1,119 @@
+// UnitDefinitionSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Engine/DataTable.h"
+#include "UnitDefinitionTable.h"
+#include "UnitDefinitionSubsystem.generated.h"
+
+// Forward declarations
+class UAnimMontage;
+
+// ============================================================================
+// AUTHORING ROWS
+// ============================================================================
+
+/** Editable mirror of FUnitDefinitionStats for DataTables and CSV. */
+USTRUCT(BlueprintType)
+struct FUnitDefinitionStarStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stats")
+    float MaxHealth = 100.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stats")
+    float AttackDamage = 10.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stats")
+    float AttackSpeed = 1.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stats")
+    float AttackRange = 150.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stats", meta = (ClampMin = "1"))
+    int32 AttackRangeHexes = 1;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stats")
+    float Armor = 0.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stats")
+    float MagicResist = 0.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stats")
+    float MaxMana = 50.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stats")
+    float MovementSpeed = 300.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stats")
+    float StoppingDistance = 50.0f;
+
+    FUnitDefinitionStats ToStats() const;
+};
+
+/**
+ * One unit type as authored in a DataTable (or CSV imported into one). The row name is
+ * the unit name. UCookUnitDefinitionsCommandlet turns a table of these into the binary
+ * file UUnitDefinitionSubsystem maps at startup.
+ */
+USTRUCT(BlueprintType)
+struct FUnitDefinitionRow : public FTableRowBase
+{
+    GENERATED_BODY()
+
+    /** Stats for 1, 2 and 3 stars. Missing levels are scaled from the highest one given by FStarScaling. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Unit")
+    TArray<FUnitDefinitionStarStats> StarLevels;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Animation")
+    TSoftObjectPtr<UAnimMontage> AttackMontage;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Animation")
+    TSoftObjectPtr<UAnimMontage> AbilityMontage;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Animation")
+    TSoftObjectPtr<UAnimMontage> DeathMontage;
+};
+
+// ============================================================================
+// UNIT DEFINITION SUBSYSTEM
+// ============================================================================
+
+/**
+ * Maps the cooked unit definition file (TFT.Units.DefinitionFile, relative to the
+ * project content directory) once per game instance. Units pick their stats by index,
+ * so a roster loads without loading one Blueprint per unit type. Montages are resolved
+ * from their soft paths the first time a unit of that type asks for them.
+ */
+UCLASS()
+class TFTUNREALDEMO_API UUnitDefinitionSubsystem : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    const FUnitDefinitionTable& GetTable() const { return Table; }
+
+    /** Definition index for a unit name, or INDEX_NONE when the name or the file is missing. */
+    UFUNCTION(BlueprintPure, Category = "Units")
+    int32 FindDefinition(FName UnitName) const { return Table.FindIndex(UnitName); }
+
+    UFUNCTION(BlueprintPure, Category = "Units")
+    int32 NumDefinitions() const { return Table.Num(); }
+
+    /** Montage of a unit type, loaded and cached on first use. Null when the definition has none. */
+    UAnimMontage* GetMontage(int32 DefinitionIndex, EUnitDefinitionMontage Montage);
+
+private:
+    FUnitDefinitionTable Table;
+
+    /** NumDefinitions * EUnitDefinitionMontage::Count slots. */
+    UPROPERTY()
+    TArray<UAnimMontage*> Montages;
+
+    TBitArray<> MontagesResolved;
+};
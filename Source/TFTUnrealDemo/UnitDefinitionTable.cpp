@@ -0,0 +1,321 @@
+// UnitDefinitionTable.cpp
+
+#include "UnitDefinitionTable.h"
+#include "CombatSimulation.h"
+#include "TFTUnrealDemo.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Crc.h"
+
+// ============================================================================
+// LOADING
+// ============================================================================
+
+FUnitDefinitionTable::~FUnitDefinitionTable()
+{
+    Unload();
+}
+
+bool FUnitDefinitionTable::LoadFromFile(const TCHAR* Filename)
+{
+    Unload();
+
+    FOpenMappedResult MapResult = FPlatformFileManager::Get().GetPlatformFile().OpenMappedEx(Filename);
+    if (MapResult.HasValue())
+    {
+        MappedFile = MapResult.StealValue();
+        MappedRegion.Reset(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+    }
+
+    const uint8* BlobData = nullptr;
+    int64 BlobSize = 0;
+
+    if (MappedRegion)
+    {
+        BlobData = MappedRegion->GetMappedPtr();
+        BlobSize = MappedRegion->GetMappedSize();
+    }
+    else
+    {
+        MappedFile.Reset();
+
+        if (!FFileHelper::LoadFileToArray(FileData, Filename))
+        {
+            UE_LOG(LogTFTCombat, Warning, TEXT("Could not open unit definitions %s"), Filename);
+            return false;
+        }
+
+        BlobData = FileData.GetData();
+        BlobSize = FileData.Num();
+    }
+
+    if (!Bind(BlobData, BlobSize))
+    {
+        UE_LOG(LogTFTCombat, Warning, TEXT("Rejected unit definitions %s"), Filename);
+        Unload();
+        return false;
+    }
+
+    return true;
+}
+
+bool FUnitDefinitionTable::LoadFromMemory(const uint8* InData, int64 InSize)
+{
+    Unload();
+
+    if (!Bind(InData, InSize))
+    {
+        Unload();
+        return false;
+    }
+
+    return true;
+}
+
+bool FUnitDefinitionTable::Bind(const uint8* InData, int64 InSize)
+{
+    Data = InData;
+    DataSize = InSize;
+
+    FString Error;
+    if (!Validate(Error))
+    {
+        UE_LOG(LogTFTCombat, Warning, TEXT("Invalid unit definition blob: %s"), *Error);
+        return false;
+    }
+
+    Header = reinterpret_cast<const FUnitDefinitionFileHeader*>(Data);
+    Records = reinterpret_cast<const FUnitDefinitionRecord*>(Data + Header->RecordsOffset);
+    Strings = reinterpret_cast<const ANSICHAR*>(Data + Header->StringsOffset);
+
+    Names.Reserve(Header->NumUnits);
+    NameToIndex.Reserve(Header->NumUnits);
+
+    for (int32 Index = 0; Index < (int32)Header->NumUnits; ++Index)
+    {
+        const FName Name(UTF8_TO_TCHAR(GetString(Records[Index].NameOffset)));
+        Names.Add(Name);
+        NameToIndex.Add(Name, Index);
+    }
+
+    return true;
+}
+
+void FUnitDefinitionTable::Unload()
+{
+    Header = nullptr;
+    Records = nullptr;
+    Strings = nullptr;
+    Data = nullptr;
+    DataSize = 0;
+
+    Names.Reset();
+    NameToIndex.Reset();
+
+    // Region before file: the region views the file's mapping
+    MappedRegion.Reset();
+    MappedFile.Reset();
+    FileData.Empty();
+}
+
+bool FUnitDefinitionTable::Validate(FString& OutError) const
+{
+    if (!Data || DataSize < (int64)sizeof(FUnitDefinitionFileHeader))
+    {
+        OutError = TEXT("too small for a header");
+        return false;
+    }
+
+    if (!IsAligned(Data, alignof(FUnitDefinitionRecord)))
+    {
+        OutError = TEXT("blob is not aligned");
+        return false;
+    }
+
+    const FUnitDefinitionFileHeader& FileHeader = *reinterpret_cast<const FUnitDefinitionFileHeader*>(Data);
+
+    if (FileHeader.Magic != Magic)
+    {
+        OutError = TEXT("not a unit definition file");
+        return false;
+    }
+
+    if (FileHeader.Version != Version || FileHeader.RecordSize != sizeof(FUnitDefinitionRecord))
+    {
+        OutError = FString::Printf(TEXT("version %u (record size %u), expected %u (%u); re-cook the unit definitions"),
+            FileHeader.Version, FileHeader.RecordSize, Version, (uint32)sizeof(FUnitDefinitionRecord));
+        return false;
+    }
+
+    const int64 RecordsEnd = (int64)FileHeader.RecordsOffset + (int64)FileHeader.NumUnits * sizeof(FUnitDefinitionRecord);
+    const int64 StringsEnd = (int64)FileHeader.StringsOffset + FileHeader.StringsSize;
+
+    if (FileHeader.RecordsOffset < sizeof(FUnitDefinitionFileHeader) || FileHeader.RecordsOffset % alignof(FUnitDefinitionRecord) != 0
+        || RecordsEnd > FileHeader.StringsOffset || StringsEnd != DataSize
+        || FileHeader.StringsSize == 0 || Data[StringsEnd - 1] != 0)
+    {
+        OutError = TEXT("section offsets are out of bounds");
+        return false;
+    }
+
+#if !UE_BUILD_SHIPPING
+    const uint32 Checksum = FCrc::MemCrc32(Data + sizeof(FUnitDefinitionFileHeader), (int32)(DataSize - sizeof(FUnitDefinitionFileHeader)));
+    if (Checksum != FileHeader.Checksum)
+    {
+        OutError = TEXT("checksum mismatch");
+        return false;
+    }
+#endif
+
+    const FUnitDefinitionRecord* FileRecords = reinterpret_cast<const FUnitDefinitionRecord*>(Data + FileHeader.RecordsOffset);
+
+    for (uint32 Index = 0; Index < FileHeader.NumUnits; ++Index)
+    {
+        const FUnitDefinitionRecord& Record = FileRecords[Index];
+        bool bStringsValid = Record.NameOffset < FileHeader.StringsSize;
+
+        for (const uint32 Offset : Record.MontagePathOffsets)
+        {
+            bStringsValid &= Offset < FileHeader.StringsSize;
+        }
+
+        if (!bStringsValid || Record.NumStarLevels < 1 || Record.NumStarLevels > FUnitDefinitionRecord::MaxStarLevel)
+        {
+            OutError = FString::Printf(TEXT("record %u is malformed"), Index);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// ============================================================================
+// COOKING
+// ============================================================================
+
+bool FUnitDefinitionTable::Cook(TConstArrayView<FSource> Sources, TArray<uint8>& OutBlob, FString& OutError)
+{
+    OutBlob.Reset();
+
+    TArray<FUnitDefinitionRecord> OutRecords;
+    OutRecords.Reserve(Sources.Num());
+
+    // Offset 0 is the empty string shared by every missing montage
+    TArray<ANSICHAR> StringTable;
+    StringTable.Add('\0');
+
+    TSet<FName> SeenNames;
+
+    auto AddString = [&StringTable](const FString& Value) -> uint32
+        {
+            if (Value.IsEmpty())
+            {
+                return 0;
+            }
+
+            const FTCHARToUTF8 Utf8(*Value);
+            const uint32 Offset = StringTable.Num();
+            StringTable.Append(reinterpret_cast<const ANSICHAR*>(Utf8.Get()), Utf8.Length());
+            StringTable.Add('\0');
+            return Offset;
+        };
+
+    for (const FSource& Source : Sources)
+    {
+        bool bAlreadySeen = false;
+        SeenNames.Add(FName(*Source.Name), &bAlreadySeen);
+
+        if (Source.Name.IsEmpty() || bAlreadySeen)
+        {
+            OutError = FString::Printf(TEXT("Unit name '%s' is empty or used twice"), *Source.Name);
+            return false;
+        }
+
+        if (Source.StarLevels.Num() < 1 || Source.StarLevels.Num() > FUnitDefinitionRecord::MaxStarLevel)
+        {
+            OutError = FString::Printf(TEXT("Unit '%s' needs 1 to %d star levels, has %d"),
+                *Source.Name, FUnitDefinitionRecord::MaxStarLevel, Source.StarLevels.Num());
+            return false;
+        }
+
+        FUnitDefinitionRecord& Record = OutRecords.AddDefaulted_GetRef();
+        Record.NameOffset = AddString(Source.Name);
+
+        for (int32 Montage = 0; Montage < (int32)EUnitDefinitionMontage::Count; ++Montage)
+        {
+            Record.MontagePathOffsets[Montage] = AddString(Source.MontagePaths[Montage]);
+        }
+
+        // Levels that were not authored are scaled up from the highest one that was
+        Record.NumStarLevels = Source.StarLevels.Num();
+        for (int32 Star = 1; Star <= FUnitDefinitionRecord::MaxStarLevel; ++Star)
+        {
+            const int32 AuthoredStar = FMath::Min(Star, Source.StarLevels.Num());
+            FUnitDefinitionStats& Stats = Record.StarLevels[Star - 1];
+            Stats = Source.StarLevels[AuthoredStar - 1];
+
+            if (Star > AuthoredStar)
+            {
+                Stats.MaxHealth *= FStarScaling::GetHealthMultiplier(Star) / FStarScaling::GetHealthMultiplier(AuthoredStar);
+                Stats.AttackDamage *= FStarScaling::GetDamageMultiplier(Star) / FStarScaling::GetDamageMultiplier(AuthoredStar);
+            }
+        }
+    }
+
+    FUnitDefinitionFileHeader FileHeader;
+    FileHeader.Magic = Magic;
+    FileHeader.Version = Version;
+    FileHeader.NumUnits = OutRecords.Num();
+    FileHeader.RecordSize = sizeof(FUnitDefinitionRecord);
+    FileHeader.RecordsOffset = sizeof(FUnitDefinitionFileHeader);
+    FileHeader.StringsOffset = FileHeader.RecordsOffset + OutRecords.Num() * sizeof(FUnitDefinitionRecord);
+    FileHeader.StringsSize = StringTable.Num();
+
+    OutBlob.Reserve(FileHeader.StringsOffset + FileHeader.StringsSize);
+    OutBlob.Append(reinterpret_cast<const uint8*>(&FileHeader), sizeof(FileHeader));
+    OutBlob.Append(reinterpret_cast<const uint8*>(OutRecords.GetData()), OutRecords.Num() * sizeof(FUnitDefinitionRecord));
+    OutBlob.Append(reinterpret_cast<const uint8*>(StringTable.GetData()), StringTable.Num());
+
+    const uint32 Checksum = FCrc::MemCrc32(OutBlob.GetData() + sizeof(FileHeader), OutBlob.Num() - sizeof(FileHeader));
+    FMemory::Memcpy(OutBlob.GetData() + offsetof(FUnitDefinitionFileHeader, Checksum), &Checksum, sizeof(Checksum));
+
+    return true;
+}
+
+// ============================================================================
+// LOOKUPS
+// ============================================================================
+
+int32 FUnitDefinitionTable::FindIndex(FName Name) const
+{
+    const int32* Index = NameToIndex.Find(Name);
+    return Index ? *Index : INDEX_NONE;
+}
+
+const FUnitDefinitionStats& FUnitDefinitionTable::GetStats(int32 Index, int32 StarLevel) const
+{
+    const FUnitDefinitionRecord& Record = GetRecord(Index);
+    return Record.StarLevels[FStarScaling::ClampStarLevel(StarLevel) - 1];
+}
+
+const ANSICHAR* FUnitDefinitionTable::GetMontagePath(int32 Index, EUnitDefinitionMontage Montage) const
+{
+    return GetString(GetRecord(Index).MontagePathOffsets[(int32)Montage]);
+}
+
+void FUnitDefinitionTable::FillCombatUnitDesc(int32 Index, int32 StarLevel, FCombatUnitDesc& OutDesc) const
+{
+    const FUnitDefinitionStats& Stats = GetStats(Index, StarLevel);
+
+    OutDesc.MaxHealth = Stats.MaxHealth;
+    OutDesc.AttackDamage = Stats.AttackDamage;
+    OutDesc.AttackSpeed = Stats.AttackSpeed;
+    OutDesc.AttackRange = Stats.AttackRange;
+    OutDesc.AttackRangeHexes = Stats.AttackRangeHexes;
+    OutDesc.Armor = Stats.Armor;
+    OutDesc.MagicResist = Stats.MagicResist;
+    OutDesc.MaxMana = Stats.MaxMana;
+    OutDesc.MovementSpeed = Stats.MovementSpeed;
+    OutDesc.StoppingDistance = Stats.StoppingDistance;
+}
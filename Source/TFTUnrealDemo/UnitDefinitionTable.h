@@ -0,0 +1,155 @@
+// UnitDefinitionTable.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StarScaling.h"
+
+// Forward declarations
+class IMappedFileHandle;
+class IMappedFileRegion;
+struct FCombatUnitDesc;
+
+// ============================================================================
+// BINARY LAYOUT
+// ============================================================================
+
+/** Combat stats of one unit type at one star level. Field order is part of the file format. */
+struct FUnitDefinitionStats
+{
+    float MaxHealth = 100.0f;
+    float AttackDamage = 10.0f;
+    float AttackSpeed = 1.0f;
+    float AttackRange = 150.0f;
+    int32 AttackRangeHexes = 1;
+    float Armor = 0.0f;
+    float MagicResist = 0.0f;
+    float MaxMana = 50.0f;
+    float MovementSpeed = 300.0f;
+    float StoppingDistance = 50.0f;
+};
+
+enum class EUnitDefinitionMontage : uint8
+{
+    Attack,
+    Ability,
+    Death,
+    Count
+};
+
+/** Fixed-size record per unit type. Strings are byte offsets into the file's string table. */
+struct FUnitDefinitionRecord
+{
+    static constexpr int32 MaxStarLevel = FStarScaling::MaxStarLevel;
+
+    uint32 NameOffset = 0;
+    uint32 MontagePathOffsets[(int32)EUnitDefinitionMontage::Count] = {};
+    /** Levels authored by hand. The rest were derived with FStarScaling at cook time. */
+    uint32 NumStarLevels = 0;
+    FUnitDefinitionStats StarLevels[MaxStarLevel];
+};
+
+struct FUnitDefinitionFileHeader
+{
+    uint32 Magic = 0;
+    uint32 Version = 0;
+    uint32 NumUnits = 0;
+    uint32 RecordSize = 0;
+    uint32 RecordsOffset = 0;
+    uint32 StringsOffset = 0;
+    uint32 StringsSize = 0;
+
+    /** CRC of everything after the header. */
+    uint32 Checksum = 0;
+};
+
+static_assert(std::is_trivially_copyable_v<FUnitDefinitionRecord>, "Unit definition records are read in place");
+static_assert(sizeof(FUnitDefinitionStats) == 40 && sizeof(FUnitDefinitionRecord) == 140 && sizeof(FUnitDefinitionFileHeader) == 32,
+    "Changing the binary layout needs a FUnitDefinitionTable::Version bump");
+
+// ============================================================================
+// UNIT DEFINITION TABLE
+// ============================================================================
+
+/**
+ * Read-only table of unit types backed by a cooked, versioned binary blob:
+ * header, fixed-size records, then a string table of null-terminated UTF-8 names and
+ * montage paths. Loading maps the file and validates the header; records and strings
+ * are read in place, so lookups never copy and never touch a UObject.
+ */
+class TFTUNREALDEMO_API FUnitDefinitionTable
+{
+public:
+    static constexpr uint32 Magic = 0x55544654; // 'TFTU'
+    static constexpr uint32 Version = 2;
+
+    /** Authoring-side description of one unit type, input to Cook(). */
+    struct FSource
+    {
+        FString Name;
+        FString MontagePaths[(int32)EUnitDefinitionMontage::Count];
+        TArray<FUnitDefinitionStats> StarLevels;
+    };
+
+    FUnitDefinitionTable() = default;
+    ~FUnitDefinitionTable();
+    UE_NONCOPYABLE(FUnitDefinitionTable);
+
+    // ========================================================================
+    // LOADING
+    // ========================================================================
+
+    /** Memory-maps a cooked file, falling back to a plain read where mapping is unsupported. */
+    bool LoadFromFile(const TCHAR* Filename);
+
+    /** Uses a cooked blob in place. The caller keeps Data alive until Unload(). */
+    bool LoadFromMemory(const uint8* Data, int64 Size);
+
+    void Unload();
+    bool IsLoaded() const { return Header != nullptr; }
+
+    /** Builds a cooked blob. Fails on empty or duplicate names and on units without star levels. */
+    static bool Cook(TConstArrayView<FSource> Sources, TArray<uint8>& OutBlob, FString& OutError);
+
+    // ========================================================================
+    // LOOKUPS
+    // ========================================================================
+
+    int32 Num() const { return Header ? (int32)Header->NumUnits : 0; }
+    bool IsValidIndex(int32 Index) const { return Index >= 0 && Index < Num(); }
+
+    /** Definition index for a unit name, or INDEX_NONE. */
+    int32 FindIndex(FName Name) const;
+
+    const FUnitDefinitionRecord& GetRecord(int32 Index) const { check(IsValidIndex(Index)); return Records[Index]; }
+    FName GetName(int32 Index) const { return Names[Index]; }
+
+    /** Stats at StarLevel, clamped to 1..MaxStarLevel. */
+    const FUnitDefinitionStats& GetStats(int32 Index, int32 StarLevel) const;
+
+    /** Soft object path of a montage as UTF-8, empty when the unit has none. */
+    const ANSICHAR* GetMontagePath(int32 Index, EUnitDefinitionMontage Montage) const;
+
+    /** Copies the stats of a unit type at StarLevel into a headless simulation descriptor. */
+    void FillCombatUnitDesc(int32 Index, int32 StarLevel, FCombatUnitDesc& OutDesc) const;
+
+private:
+    /** Points the table at a blob whose storage is already owned or borrowed. */
+    bool Bind(const uint8* InData, int64 InSize);
+    bool Validate(FString& OutError) const;
+    const ANSICHAR* GetString(uint32 Offset) const { return Strings + Offset; }
+
+    const uint8* Data = nullptr;
+    int64 DataSize = 0;
+
+    const FUnitDefinitionFileHeader* Header = nullptr;
+    const FUnitDefinitionRecord* Records = nullptr;
+    const ANSICHAR* Strings = nullptr;
+
+    TUniquePtr<IMappedFileHandle> MappedFile;
+    TUniquePtr<IMappedFileRegion> MappedRegion;
+    TArray64<uint8> FileData;
+
+    // Built once at load; names are the only thing converted out of the blob
+    TArray<FName> Names;
+    TMap<FName, int32> NameToIndex;
+};
@@ -0,0 +1,312 @@
+// UnitMovementSubsystem.cpp
+
+#include "UnitMovementSubsystem.h"
+#include "CombatStats.h"
+#include "UnitBase.h"
+#include "AIController.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "NavFilters/NavigationQueryFilter.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+// ============================================================================
+// CONSOLE VARIABLES
+// ============================================================================
+
+static float GUnitRepathDistance = 50.0f;
+static FAutoConsoleVariableRef CVarUnitRepathDistance(
+    TEXT("TFT.Movement.RepathDistance"),
+    GUnitRepathDistance,
+    TEXT("How far a move goal has to travel before a unit already moving towards it requests a new path."));
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+void UUnitMovementSubsystem::Deinitialize()
+{
+    if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+    {
+        for (const TPair<uint32, int32>& Query : InFlightQueries)
+        {
+            NavSys->AbortAsyncFindPathRequest(Query.Key);
+        }
+    }
+
+    Entries.Reset();
+    QueuedHandles.Reset();
+    InFlightQueries.Reset();
+
+    Super::Deinitialize();
+}
+
+TStatId UUnitMovementSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UUnitMovementSubsystem, STATGROUP_Tickables);
+}
+
+bool UUnitMovementSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+// ============================================================================
+// ENTRIES
+// ============================================================================
+
+UUnitMovementSubsystem::FMoveEntry* UUnitMovementSubsystem::FindEntry(const AUnitBase* Unit)
+{
+    const int32 Handle = Unit ? Unit->GetUnitHandle() : INDEX_NONE;
+    return Entries.IsValidIndex(Handle) && Entries[Handle].Unit == Unit ? &Entries[Handle] : nullptr;
+}
+
+UUnitMovementSubsystem::FMoveEntry& UUnitMovementSubsystem::FindOrAddEntry(AUnitBase* Unit)
+{
+    const int32 Handle = Unit->GetUnitHandle();
+    if (Handle >= Entries.Num())
+    {
+        Entries.SetNum(Handle + 1);
+    }
+
+    FMoveEntry& Entry = Entries[Handle];
+    if (Entry.Unit != Unit)
+    {
+        // Handle was recycled from another unit
+        CancelPathQuery(Entry);
+        Entry = FMoveEntry();
+        Entry.Unit = Unit;
+    }
+
+    return Entry;
+}
+
+void UUnitMovementSubsystem::RemoveUnit(const AUnitBase* Unit)
+{
+    if (!Unit)
+    {
+        return;
+    }
+
+    for (FMoveEntry& Entry : Entries)
+    {
+        // Nobody should keep walking towards a unit that left play
+        if (Entry.Unit == Unit || Entry.Goal == Unit)
+        {
+            CancelPathQuery(Entry);
+            Entry.bQueued = false;
+            Entry.bMoveActive = false;
+            Entry.Goal = nullptr;
+        }
+    }
+
+    if (FMoveEntry* Entry = FindEntry(Unit))
+    {
+        *Entry = FMoveEntry();
+    }
+}
+
+// ============================================================================
+// REQUESTS
+// ============================================================================
+
+void UUnitMovementSubsystem::RequestMoveTo(AUnitBase* Unit, AAIController* Controller, AUnitBase* Goal, float AcceptanceRadius)
+{
+    if (!Unit || !Controller || !Goal)
+    {
+        return;
+    }
+
+    // Units outside the registry have no entry; move them directly
+    if (Unit->GetUnitHandle() == INDEX_NONE)
+    {
+        Controller->MoveToActor(Goal, AcceptanceRadius);
+        ++FrameStats.MovesIssued;
+        TFT_COMBAT_COUNTER(MoveRequests, 1);
+        return;
+    }
+
+    FMoveEntry& Entry = FindOrAddEntry(Unit);
+    Entry.Controller = Controller;
+
+    const FVector GoalLocation = Goal->GetNavAgentLocation();
+    const bool bPending = Entry.bQueued || Entry.PathQueryId != INVALID_NAVQUERYID;
+
+    if (Entry.Goal == Goal && Entry.AcceptanceRadius == AcceptanceRadius
+        && FVector::DistSquared(Entry.GoalLocation, GoalLocation) <= FMath::Square(GUnitRepathDistance))
+    {
+        // Path following can finish on its own (goal reached, then the goal walked away)
+        if (bPending || (Entry.bMoveActive && Controller->GetMoveStatus() != EPathFollowingStatus::Idle))
+        {
+            ++FrameStats.MovesSkipped;
+            return;
+        }
+    }
+
+    if (bPending)
+    {
+        CancelPathQuery(Entry);
+        ++FrameStats.MovesCoalesced;
+    }
+
+    Entry.Goal = Goal;
+    Entry.GoalLocation = GoalLocation;
+    Entry.AcceptanceRadius = AcceptanceRadius;
+
+    if (!Entry.bQueued)
+    {
+        Entry.bQueued = true;
+        QueuedHandles.Add(Unit->GetUnitHandle());
+    }
+}
+
+void UUnitMovementSubsystem::RequestStop(AUnitBase* Unit, AAIController* Controller)
+{
+    if (!Unit)
+    {
+        return;
+    }
+
+    UCharacterMovementComponent* MovementComp = Unit->GetCharacterMovement();
+    FMoveEntry* Entry = FindEntry(Unit);
+
+    const bool bMoving = (Entry && (Entry->bQueued || Entry->bMoveActive || Entry->PathQueryId != INVALID_NAVQUERYID))
+        || (Controller && Controller->GetMoveStatus() != EPathFollowingStatus::Idle)
+        || (MovementComp && !MovementComp->Velocity.IsNearlyZero());
+
+    if (!bMoving)
+    {
+        ++FrameStats.StopsSkipped;
+        return;
+    }
+
+    if (Entry)
+    {
+        CancelPathQuery(*Entry);
+        Entry->bQueued = false;
+        Entry->bMoveActive = false;
+        Entry->Goal = nullptr;
+    }
+
+    if (Controller)
+    {
+        Controller->StopMovement();
+    }
+
+    if (MovementComp)
+    {
+        MovementComp->StopMovementImmediately();
+    }
+
+    ++FrameStats.StopsIssued;
+}
+
+// ============================================================================
+// PATH QUERIES
+// ============================================================================
+
+void UUnitMovementSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+    TFT_COMBAT_FRAME_SCOPE(MovementBatch);
+
+    // Everything requested since the last update goes out as one batch of async queries
+    for (const int32 Handle : QueuedHandles)
+    {
+        if (Entries.IsValidIndex(Handle) && Entries[Handle].bQueued)
+        {
+            IssuePathQuery(Handle, Entries[Handle]);
+        }
+    }
+    QueuedHandles.Reset();
+
+    FrameStats.PathQueriesInFlight = InFlightQueries.Num();
+    LastFrameStats = FrameStats;
+    FrameStats = FUnitMovementFrameStats();
+}
+
+void UUnitMovementSubsystem::CancelPathQuery(FMoveEntry& Entry)
+{
+    if (Entry.PathQueryId == INVALID_NAVQUERYID)
+    {
+        return;
+    }
+
+    if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+    {
+        NavSys->AbortAsyncFindPathRequest(Entry.PathQueryId);
+    }
+
+    InFlightQueries.Remove(Entry.PathQueryId);
+    Entry.PathQueryId = INVALID_NAVQUERYID;
+}
+
+void UUnitMovementSubsystem::IssuePathQuery(int32 Handle, FMoveEntry& Entry)
+{
+    Entry.bQueued = false;
+
+    if (!Entry.Unit || !Entry.Controller || !Entry.Goal)
+    {
+        return;
+    }
+
+    ++FrameStats.MovesIssued;
+    TFT_COMBAT_COUNTER(MoveRequests, 1);
+
+    UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+    const FNavAgentProperties& AgentProperties = Entry.Unit->GetNavAgentPropertiesRef();
+    const ANavigationData* NavData = NavSys ? NavSys->GetNavDataForProps(AgentProperties, Entry.Unit->GetNavAgentLocation()) : nullptr;
+
+    if (!NavData)
+    {
+        // No navmesh (e.g. the benchmark world): walk straight at the goal
+        Entry.bMoveActive = Entry.Controller->MoveToActor(Entry.Goal, Entry.AcceptanceRadius, true, false) != EPathFollowingRequestResult::Failed;
+        return;
+    }
+
+    FPathFindingQuery Query(Entry.Controller, *NavData, Entry.Unit->GetNavAgentLocation(), Entry.GoalLocation,
+        UNavigationQueryFilter::GetQueryFilter(*NavData, Entry.Controller, Entry.Controller->GetDefaultNavigationFilterClass()));
+
+    Entry.PathQueryId = NavSys->FindPathAsync(AgentProperties, Query,
+        FNavPathQueryDelegate::CreateUObject(this, &UUnitMovementSubsystem::HandlePathFound));
+
+    if (Entry.PathQueryId != INVALID_NAVQUERYID)
+    {
+        InFlightQueries.Add(Entry.PathQueryId, Handle);
+    }
+}
+
+void UUnitMovementSubsystem::HandlePathFound(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path)
+{
+    int32 Handle = INDEX_NONE;
+    if (!InFlightQueries.RemoveAndCopyValue(QueryId, Handle) || !Entries.IsValidIndex(Handle))
+    {
+        return;
+    }
+
+    FMoveEntry& Entry = Entries[Handle];
+    if (Entry.PathQueryId != QueryId)
+    {
+        return;
+    }
+
+    Entry.PathQueryId = INVALID_NAVQUERYID;
+
+    if (Result != ENavigationQueryResult::Success || !Path.IsValid() || !Entry.Controller || !Entry.Goal)
+    {
+        ++FrameStats.PathsFailed;
+        Entry.bMoveActive = false;
+        return;
+    }
+
+    // Same goal tracking MoveToActor sets up, so small goal moves are followed without a new query
+    Path->SetGoalActorObservation(*Entry.Goal, GUnitRepathDistance);
+    Path->EnableRecalculationOnInvalidation(true);
+
+    FAIMoveRequest MoveRequest(Entry.Goal);
+    MoveRequest.SetAcceptanceRadius(Entry.AcceptanceRadius);
+
+    Entry.bMoveActive = Entry.Controller->RequestMove(MoveRequest, Path).IsValid();
+}
@@ -0,0 +1,123 @@
+// UnitMovementSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NavigationSystemTypes.h"
+#include "UnitMovementSubsystem.generated.h"
+
+// Forward declarations
+class AUnitBase;
+class AAIController;
+
+// ============================================================================
+// STRUCTS
+// ============================================================================
+
+/** Movement requests handled in the coordinator's last update. */
+USTRUCT(BlueprintType)
+struct FUnitMovementFrameStats
+{
+    GENERATED_BODY()
+
+    /** Path queries sent to the navigation system. */
+    UPROPERTY(BlueprintReadOnly, Category = "Movement")
+    int32 MovesIssued = 0;
+
+    /** Move requests dropped because the active move already covers them. */
+    UPROPERTY(BlueprintReadOnly, Category = "Movement")
+    int32 MovesSkipped = 0;
+
+    /** Move requests that replaced a queued or in-flight request for the same unit. */
+    UPROPERTY(BlueprintReadOnly, Category = "Movement")
+    int32 MovesCoalesced = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Movement")
+    int32 StopsIssued = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Movement")
+    int32 StopsSkipped = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Movement")
+    int32 PathsFailed = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Movement")
+    int32 PathQueriesInFlight = 0;
+};
+
+// ============================================================================
+// MOVEMENT SUBSYSTEM
+// ============================================================================
+
+/**
+ * Coordinates unit move-to-target and stop requests. Each unit's active request is
+ * tracked so repeated requests only reach the navigation system when the goal changes
+ * or moves further than TFT.Movement.RepathDistance. Requests queued during a frame are
+ * flushed together as async path queries on the next update.
+ */
+UCLASS()
+class TFTUNREALDEMO_API UUnitMovementSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // ========================================================================
+    // REQUESTS
+    // ========================================================================
+
+    /** Moves Unit towards Goal unless it is already doing so. */
+    void RequestMoveTo(AUnitBase* Unit, AAIController* Controller, AUnitBase* Goal, float AcceptanceRadius);
+
+    /** Stops Unit unless it is already standing still. */
+    void RequestStop(AUnitBase* Unit, AAIController* Controller);
+
+    /** Forgets the unit and cancels its pending path query. */
+    void RemoveUnit(const AUnitBase* Unit);
+
+    // ========================================================================
+    // STATS
+    // ========================================================================
+
+    UFUNCTION(BlueprintPure, Category = "Movement")
+    FUnitMovementFrameStats GetLastFrameStats() const { return LastFrameStats; }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FMoveEntry
+    {
+        AUnitBase* Unit = nullptr;
+        AAIController* Controller = nullptr;
+        AUnitBase* Goal = nullptr;
+        FVector GoalLocation = FVector::ZeroVector;
+        float AcceptanceRadius = 0.0f;
+
+        /** Waiting for the next flush. */
+        bool bQueued = false;
+
+        /** Path following was started for Goal. */
+        bool bMoveActive = false;
+
+        uint32 PathQueryId = INVALID_NAVQUERYID;
+    };
+
+    FMoveEntry* FindEntry(const AUnitBase* Unit);
+    FMoveEntry& FindOrAddEntry(AUnitBase* Unit);
+
+    void CancelPathQuery(FMoveEntry& Entry);
+    void IssuePathQuery(int32 Handle, FMoveEntry& Entry);
+    void HandlePathFound(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path);
+
+    /** Entries are indexed by unit registry handle. */
+    TArray<FMoveEntry> Entries;
+    TArray<int32> QueuedHandles;
+    TMap<uint32, int32> InFlightQueries;
+
+    FUnitMovementFrameStats FrameStats;
+    FUnitMovementFrameStats LastFrameStats;
+};
@@ -0,0 +1,196 @@
+// UnitPoolSubsystem.cpp
+
+#include "UnitPoolSubsystem.h"
+#include "UnitBase.h"
+#include "TFTUnrealDemo.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+// ============================================================================
+// CONSOLE VARIABLES
+// ============================================================================
+
+static int32 GUnitPoolPrewarmPerFrame = 4;
+static FAutoConsoleVariableRef CVarUnitPoolPrewarmPerFrame(
+    TEXT("TFT.Pool.PrewarmPerFrame"),
+    GUnitPoolPrewarmPerFrame,
+    TEXT("How many pooled units Prewarm() may spawn per frame."));
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+void UUnitPoolSubsystem::Deinitialize()
+{
+    Buckets.Reset();
+    PrewarmQueue.Reset();
+    Stats = FUnitPoolStats();
+
+    Super::Deinitialize();
+}
+
+TStatId UUnitPoolSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UUnitPoolSubsystem, STATGROUP_Tickables);
+}
+
+bool UUnitPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UUnitPoolSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    int32 Budget = FMath::Max(GUnitPoolPrewarmPerFrame, 1);
+
+    while (Budget > 0 && PrewarmQueue.Num() > 0)
+    {
+        FPrewarmRequest& Request = PrewarmQueue[0];
+
+        if (Request.Remaining > 0 && SpawnUnit(Request.UnitClass, FTransform::Identity, ETeam::Enemy, 0, true))
+        {
+            ++Stats.Prewarmed;
+            --Request.Remaining;
+            --Budget;
+        }
+        else
+        {
+            // Done, or the class cannot be spawned
+            Request.Remaining = 0;
+        }
+
+        if (Request.Remaining == 0)
+        {
+            PrewarmQueue.RemoveAt(0);
+        }
+    }
+}
+
+// ============================================================================
+// POOL
+// ============================================================================
+
+AUnitBase* UUnitPoolSubsystem::AcquireUnit(TSubclassOf<AUnitBase> UnitClass, const FTransform& Transform, ETeam Team, int32 BoardId)
+{
+    if (!UnitClass)
+    {
+        return nullptr;
+    }
+
+    AUnitBase* Unit = nullptr;
+
+    if (FUnitPoolBucket* Bucket = Buckets.Find(UnitClass))
+    {
+        while (!Unit && Bucket->Units.Num() > 0)
+        {
+            AUnitBase* Candidate = Bucket->Units.Pop(EAllowShrinking::No);
+            --Stats.NumPooled;
+
+            // Pooled actors can still be destroyed from outside (level unload, editor)
+            if (IsValid(Candidate))
+            {
+                Unit = Candidate;
+            }
+        }
+    }
+
+    if (Unit)
+    {
+        ++Stats.Hits;
+        Unit->OnAcquiredFromPool(Transform, Team, BoardId);
+        return Unit;
+    }
+
+    ++Stats.Misses;
+    UE_LOG(LogTFTCombat, Verbose, TEXT("Unit pool miss for %s, spawning"), *UnitClass->GetName());
+    return SpawnUnit(UnitClass, Transform, Team, BoardId, false);
+}
+
+AUnitBase* UUnitPoolSubsystem::AcquireDefinedUnit(TSubclassOf<AUnitBase> UnitClass, int32 DefinitionIndex, int32 StarLevel, const FTransform& Transform, ETeam Team, int32 BoardId)
+{
+    AUnitBase* Unit = AcquireUnit(UnitClass, Transform, Team, BoardId);
+
+    if (Unit && !Unit->ApplyUnitDefinition(DefinitionIndex, StarLevel))
+    {
+        UE_LOG(LogTFTCombat, Warning, TEXT("Unit definition %d not found, %s keeps its class defaults"), DefinitionIndex, *Unit->UnitName);
+    }
+
+    return Unit;
+}
+
+void UUnitPoolSubsystem::ReleaseUnit(AUnitBase* Unit)
+{
+    if (!IsValid(Unit) || Unit->IsInPool())
+    {
+        return;
+    }
+
+    Unit->OnReleasedToPool();
+    Buckets.FindOrAdd(Unit->GetClass()).Units.Add(Unit);
+    ++Stats.Released;
+    ++Stats.NumPooled;
+}
+
+void UUnitPoolSubsystem::Prewarm(TSubclassOf<AUnitBase> UnitClass, int32 Count)
+{
+    if (!UnitClass)
+    {
+        return;
+    }
+
+    const FUnitPoolBucket* Bucket = Buckets.Find(UnitClass);
+    int32 Missing = Count - (Bucket ? Bucket->Units.Num() : 0);
+
+    for (const FPrewarmRequest& Request : PrewarmQueue)
+    {
+        if (Request.UnitClass == UnitClass)
+        {
+            Missing -= Request.Remaining;
+        }
+    }
+
+    if (Missing > 0)
+    {
+        PrewarmQueue.Add({ UnitClass.Get(), Missing });
+    }
+}
+
+AUnitBase* UUnitPoolSubsystem::SpawnUnit(UClass* UnitClass, const FTransform& Transform, ETeam Team, int32 BoardId, bool bIntoPool)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    AUnitBase* Unit = GetWorld()->SpawnActorDeferred<AUnitBase>(UnitClass, Transform, nullptr, nullptr,
+        ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+
+    if (!Unit)
+    {
+        return nullptr;
+    }
+
+    Unit->Team = Team;
+    Unit->BoardId = BoardId;
+    if (bIntoPool)
+    {
+        Unit->MarkSpawningIntoPool();
+    }
+
+    Unit->FinishSpawning(Transform);
+
+    // Released only now: BeginPlay and tick registration would undo an earlier release
+    if (bIntoPool)
+    {
+        Unit->OnReleasedToPool();
+        Buckets.FindOrAdd(UnitClass).Units.Add(Unit);
+        ++Stats.NumPooled;
+    }
+
+    const float SpawnMilliseconds = (float)((FPlatformTime::Seconds() - StartTime) * 1000.0);
+    ++Stats.NumSpawned;
+    Stats.LastSpawnMilliseconds = SpawnMilliseconds;
+    Stats.MaxSpawnMilliseconds = FMath::Max(Stats.MaxSpawnMilliseconds, SpawnMilliseconds);
+    Stats.TotalSpawnMilliseconds += SpawnMilliseconds;
+
+    return Unit;
+}
@@ -0,0 +1,127 @@
+// UnitPoolSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatTypes.h"
+#include "UnitPoolSubsystem.generated.h"
+
+// Forward declarations
+class AUnitBase;
+
+// ============================================================================
+// STRUCTS
+// ============================================================================
+
+USTRUCT(BlueprintType)
+struct FUnitPoolStats
+{
+    GENERATED_BODY()
+
+    /** Acquires served from the pool. */
+    UPROPERTY(BlueprintReadOnly, Category = "Pool")
+    int32 Hits = 0;
+
+    /** Acquires that had to spawn a new actor. */
+    UPROPERTY(BlueprintReadOnly, Category = "Pool")
+    int32 Misses = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Pool")
+    int32 Prewarmed = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Pool")
+    int32 Released = 0;
+
+    /** Units waiting in the pool right now. */
+    UPROPERTY(BlueprintReadOnly, Category = "Pool")
+    int32 NumPooled = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Pool")
+    int32 NumSpawned = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Pool")
+    float LastSpawnMilliseconds = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Pool")
+    float MaxSpawnMilliseconds = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Pool")
+    float TotalSpawnMilliseconds = 0.0f;
+};
+
+/** Idle units of one class. */
+USTRUCT()
+struct FUnitPoolBucket
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TArray<AUnitBase*> Units;
+};
+
+// ============================================================================
+// UNIT POOL SUBSYSTEM
+// ============================================================================
+
+/**
+ * Recycles AUnitBase actors between rounds instead of destroying and respawning them.
+ * Released units stay registered but sit benched, hidden and untargetable with ticking
+ * off. Acquired units come back the way a fresh spawn starts: full health, in combat.
+ * Prewarm() spreads spawning over frames (TFT.Pool.PrewarmPerFrame) so it can run
+ * during the prep phase without a hitch.
+ */
+UCLASS()
+class TFTUNREALDEMO_API UUnitPoolSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // ========================================================================
+    // POOL
+    // ========================================================================
+
+    /** Returns a pooled unit of UnitClass (or spawns one) placed at Transform on Team and board BoardId. */
+    UFUNCTION(BlueprintCallable, Category = "Pool")
+    AUnitBase* AcquireUnit(TSubclassOf<AUnitBase> UnitClass, const FTransform& Transform, ETeam Team, int32 BoardId = 0);
+
+    /** AcquireUnit, then loads stats and montages from the unit definition table. */
+    UFUNCTION(BlueprintCallable, Category = "Pool")
+    AUnitBase* AcquireDefinedUnit(TSubclassOf<AUnitBase> UnitClass, int32 DefinitionIndex, int32 StarLevel, const FTransform& Transform, ETeam Team, int32 BoardId = 0);
+
+    /** Parks the unit in the pool. Replaces Destroy() for units that may come back. */
+    UFUNCTION(BlueprintCallable, Category = "Pool")
+    void ReleaseUnit(AUnitBase* Unit);
+
+    /** Makes sure at least Count units of UnitClass are pooled, spawning the rest over the next frames. */
+    UFUNCTION(BlueprintCallable, Category = "Pool")
+    void Prewarm(TSubclassOf<AUnitBase> UnitClass, int32 Count);
+
+    UFUNCTION(BlueprintPure, Category = "Pool")
+    bool IsPrewarming() const { return PrewarmQueue.Num() > 0; }
+
+    UFUNCTION(BlueprintPure, Category = "Pool")
+    FUnitPoolStats GetStats() const { return Stats; }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FPrewarmRequest
+    {
+        UClass* UnitClass = nullptr;
+        int32 Remaining = 0;
+    };
+
+    /** Deferred spawn so pooled units start benched and hidden before BeginPlay runs. */
+    AUnitBase* SpawnUnit(UClass* UnitClass, const FTransform& Transform, ETeam Team, int32 BoardId, bool bIntoPool);
+
+    UPROPERTY()
+    TMap<UClass*, FUnitPoolBucket> Buckets;
+
+    TArray<FPrewarmRequest> PrewarmQueue;
+    FUnitPoolStats Stats;
+};
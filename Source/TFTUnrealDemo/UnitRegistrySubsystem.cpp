@@ -0,0 +1,404 @@
+// UnitRegistrySubsystem.cpp
+
+#include "UnitRegistrySubsystem.h"
+#include "CombatStats.h"
+#include "UnitBase.h"
+#include "BoardGridSubsystem.h"
+#include "Engine/World.h"
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+void UUnitRegistrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    BoardGrid = Collection.InitializeDependency<UBoardGridSubsystem>();
+}
+
+void UUnitRegistrySubsystem::Deinitialize()
+{
+    Slots.Reset();
+    Generations.Reset();
+    PendingFreeHandles.Reset();
+    RetargetHandles.Reset();
+    RetargetResults.Reset();
+    NumRegistered = 0;
+    BoardHashes.Reset();
+    StatStore.Reset();
+    BoardGrid = nullptr;
+
+    Super::Deinitialize();
+}
+
+void UUnitRegistrySubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+    TFT_COMBAT_FRAME_SCOPE(RegistryUpdate);
+
+    for (const int32 Handle : PendingFreeHandles)
+    {
+        StatStore.Free(Handle);
+    }
+    PendingFreeHandles.Reset();
+
+    SyncUnitLocations();
+    StatStore.DecrementCooldowns(DeltaTime);
+}
+
+TStatId UUnitRegistrySubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UUnitRegistrySubsystem, STATGROUP_Tickables);
+}
+
+bool UUnitRegistrySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+// ============================================================================
+// REGISTRATION
+// ============================================================================
+
+int32 UUnitRegistrySubsystem::RegisterUnit(AUnitBase* Unit)
+{
+    check(Unit);
+
+    // Registry slots share their handle with the stat store
+    const int32 Handle = StatStore.Allocate();
+    if (Handle >= Slots.Num())
+    {
+        Slots.SetNum(Handle + 1);
+    }
+
+    FUnitSlot& Slot = Slots[Handle];
+    Slot.Unit = Unit;
+    ++NumRegistered;
+    BumpGeneration(Handle);
+
+    SetUnitTargetable(Handle, true);
+    return Handle;
+}
+
+void UUnitRegistrySubsystem::BumpGeneration(int32 Handle)
+{
+    if (Handle < 0)
+    {
+        return;
+    }
+
+    if (Handle >= Generations.Num())
+    {
+        Generations.SetNumZeroed(Handle + 1);
+    }
+    ++Generations[Handle];
+}
+
+void UUnitRegistrySubsystem::UnregisterUnit(int32 Handle)
+{
+    if (!Slots.IsValidIndex(Handle) || !Slots[Handle].Unit)
+    {
+        return;
+    }
+
+    SetUnitTargetable(Handle, false);
+    RetargetAttackers(Handle);
+    SetUnitTarget(Handle, INDEX_NONE);
+    Slots[Handle] = FUnitSlot();
+    --NumRegistered;
+
+    // Queued hits may still reference this handle; recycle it next frame
+    PendingFreeHandles.Add(Handle);
+}
+
+void UUnitRegistrySubsystem::SetUnitTargetable(int32 Handle, bool bTargetable)
+{
+    if (!Slots.IsValidIndex(Handle) || !Slots[Handle].Unit)
+    {
+        return;
+    }
+
+    FUnitSlot& Slot = Slots[Handle];
+    if (Slot.bTargetable == bTargetable)
+    {
+        return;
+    }
+
+    if (bTargetable)
+    {
+        Slot.BoardId = ClampBoardId(Slot.Unit->BoardId);
+        FUnitSpatialHash& SpatialHash = GetBoardHash(Slot.BoardId);
+        Slot.Cell = SpatialHash.GetCell(Slot.Unit->GetActorLocation());
+        Slot.TeamIndex = (int32)Slot.Unit->Team;
+        SpatialHash.Add(Handle, Slot.TeamIndex, Slot.Cell);
+    }
+    else
+    {
+        GetBoardHash(Slot.BoardId).Remove(Handle, Slot.TeamIndex, Slot.Cell);
+    }
+
+    Slot.bTargetable = bTargetable;
+}
+
+void UUnitRegistrySubsystem::UpdateUnit(int32 Handle)
+{
+    if (!Slots.IsValidIndex(Handle) || !Slots[Handle].bTargetable)
+    {
+        return;
+    }
+
+    FUnitSlot& Slot = Slots[Handle];
+    const int32 NewBoardId = ClampBoardId(Slot.Unit->BoardId);
+    const int32 NewTeamIndex = (int32)Slot.Unit->Team;
+
+    // Removed before the new board is looked up, which can grow the hash array
+    if (NewBoardId != Slot.BoardId || NewTeamIndex != Slot.TeamIndex)
+    {
+        GetBoardHash(Slot.BoardId).Remove(Handle, Slot.TeamIndex, Slot.Cell);
+    }
+
+    FUnitSpatialHash& SpatialHash = GetBoardHash(NewBoardId);
+    const FIntPoint NewCell = SpatialHash.GetCell(Slot.Unit->GetActorLocation());
+
+    if (NewBoardId != Slot.BoardId || NewTeamIndex != Slot.TeamIndex)
+    {
+        SpatialHash.Add(Handle, NewTeamIndex, NewCell);
+    }
+    else
+    {
+        SpatialHash.Move(Handle, Slot.TeamIndex, Slot.Cell, NewCell);
+    }
+
+    Slot.Cell = NewCell;
+    Slot.TeamIndex = NewTeamIndex;
+    Slot.BoardId = NewBoardId;
+}
+
+FUnitSpatialHash& UUnitRegistrySubsystem::GetBoardHash(int32 BoardId)
+{
+    BoardId = ClampBoardId(BoardId);
+    while (BoardHashes.Num() <= BoardId)
+    {
+        BoardHashes.Emplace(DefaultCellSize);
+    }
+    return BoardHashes[BoardId];
+}
+
+const FUnitSpatialHash* UUnitRegistrySubsystem::FindBoardHash(int32 BoardId) const
+{
+    return BoardHashes.IsValidIndex(BoardId) ? &BoardHashes[BoardId] : nullptr;
+}
+
+void UUnitRegistrySubsystem::SyncUnitLocations()
+{
+    // Runs here rather than in the unit's actor tick, which significance LOD slows down
+    for (int32 Handle = 0; Handle < Slots.Num(); ++Handle)
+    {
+        const AUnitBase* Unit = Slots[Handle].Unit;
+        if (!Unit || Unit->IsInPool())
+        {
+            continue;
+        }
+
+        UpdateUnit(Handle);
+
+        if (BoardGrid)
+        {
+            BoardGrid->UpdateUnit(Handle, Unit->BoardId, Unit->GetActorLocation());
+        }
+    }
+}
+
+AUnitBase* UUnitRegistrySubsystem::GetUnit(int32 Handle) const
+{
+    return Slots.IsValidIndex(Handle) ? Slots[Handle].Unit : nullptr;
+}
+
+// ============================================================================
+// TARGETING
+// ============================================================================
+
+void UUnitRegistrySubsystem::SetUnitTarget(int32 Handle, int32 TargetHandle)
+{
+    if (!Slots.IsValidIndex(Handle) || !Slots[Handle].Unit)
+    {
+        return;
+    }
+
+    if (!Slots.IsValidIndex(TargetHandle) || !Slots[TargetHandle].Unit)
+    {
+        TargetHandle = INDEX_NONE;
+    }
+
+    const int32 OldTargetHandle = Slots[Handle].TargetHandle;
+    if (OldTargetHandle == TargetHandle)
+    {
+        return;
+    }
+
+    if (OldTargetHandle != INDEX_NONE)
+    {
+        Slots[OldTargetHandle].Attackers.RemoveSingleSwap(Handle, EAllowShrinking::No);
+    }
+
+    if (TargetHandle != INDEX_NONE)
+    {
+        Slots[TargetHandle].Attackers.Add(Handle);
+    }
+
+    Slots[Handle].TargetHandle = TargetHandle;
+}
+
+TConstArrayView<int32> UUnitRegistrySubsystem::GetAttackers(int32 Handle) const
+{
+    return Slots.IsValidIndex(Handle) ? TConstArrayView<int32>(Slots[Handle].Attackers) : TConstArrayView<int32>();
+}
+
+void UUnitRegistrySubsystem::RetargetAttackers(int32 Handle)
+{
+    TFT_COMBAT_SCOPE(RetargetAttackers);
+
+    if (!Slots.IsValidIndex(Handle) || Slots[Handle].Attackers.Num() == 0)
+    {
+        return;
+    }
+
+    // Detach the whole group first; retargeting re-enters SetUnitTarget
+    RetargetHandles.Reset();
+    Swap(RetargetHandles, Slots[Handle].Attackers);
+    for (const int32 AttackerHandle : RetargetHandles)
+    {
+        Slots[AttackerHandle].TargetHandle = INDEX_NONE;
+    }
+
+    FindNearestEnemies(Slots[Handle].Unit->GetActorLocation(), RetargetHandles, RetargetResults);
+
+    for (int32 Index = 0; Index < RetargetHandles.Num(); ++Index)
+    {
+        if (AUnitBase* Attacker = Slots[RetargetHandles[Index]].Unit)
+        {
+            Attacker->RetargetTo(GetUnit(RetargetResults[Index]));
+            Attacker->WakeAI();
+        }
+    }
+}
+
+// ============================================================================
+// QUERIES
+// ============================================================================
+
+AUnitBase* UUnitRegistrySubsystem::FindNearestEnemy(const AUnitBase* Unit) const
+{
+    TFT_COMBAT_SCOPE(GetNearestEnemy);
+
+    if (!Unit)
+    {
+        return nullptr;
+    }
+
+    // Registered units search the board they are bucketed on
+    const int32 Handle = Unit->GetUnitHandle();
+    const int32 BoardId = Slots.IsValidIndex(Handle) && Slots[Handle].Unit == Unit ? Slots[Handle].BoardId : ClampBoardId(Unit->BoardId);
+    const FUnitSpatialHash* SpatialHash = FindBoardHash(BoardId);
+    if (!SpatialHash)
+    {
+        return nullptr;
+    }
+
+    const FVector Origin = Unit->GetActorLocation();
+    int32 NumScanned = 0;
+
+    const int32 BestHandle = SpatialHash->FindNearest(Origin, (int32)Unit->Team,
+        [this, Unit, &Origin, &NumScanned](int32 Handle, double& OutDistanceSq)
+        {
+            ++NumScanned;
+            const AUnitBase* Candidate = Slots[Handle].Unit;
+
+            if (!Candidate || Candidate == Unit) return false;
+            if (!Candidate->bIsAlive) return false;
+            if (Candidate->GetState() != EUnitState::Combat) return false;
+
+            OutDistanceSq = FVector::DistSquared(Origin, Candidate->GetActorLocation());
+            return true;
+        });
+
+    TFT_COMBAT_COUNTER(TargetsSearched, 1);
+    TFT_COMBAT_COUNTER(UnitsScanned, NumScanned);
+
+    return GetUnit(BestHandle);
+}
+
+void UUnitRegistrySubsystem::FindNearestEnemies(const FVector& Center, TConstArrayView<int32> Handles, TArray<int32>& OutTargets) const
+{
+    OutTargets.Init(INDEX_NONE, Handles.Num());
+    TFT_COMBAT_COUNTER(TargetsSearched, Handles.Num());
+
+    int32 NumScanned = 0;
+    auto IsCandidate = [this, &NumScanned](int32 Handle, FVector& OutLocation)
+    {
+        ++NumScanned;
+        const AUnitBase* Candidate = Slots[Handle].Unit;
+
+        if (!Candidate) return false;
+        if (!Candidate->bIsAlive) return false;
+        if (Candidate->GetState() != EUnitState::Combat) return false;
+
+        OutLocation = Candidate->GetActorLocation();
+        return true;
+    };
+
+    // Attackers normally share one board, but every board they stand on gets searched
+    TArray<int32, TInlineAllocator<4>> BoardIds;
+    for (const int32 Handle : Handles)
+    {
+        if (Slots.IsValidIndex(Handle) && Slots[Handle].Unit)
+        {
+            BoardIds.AddUnique(Slots[Handle].BoardId);
+        }
+    }
+
+    // One query per board and team, since each team excludes its own bucket
+    TArray<int32, TInlineAllocator<16>> GroupIndices;
+    TArray<FVector, TInlineAllocator<16>> GroupOrigins;
+    TArray<int32> GroupTargets;
+
+    for (const int32 BoardId : BoardIds)
+    {
+        const FUnitSpatialHash* SpatialHash = FindBoardHash(BoardId);
+        if (!SpatialHash)
+        {
+            continue;
+        }
+
+        for (int32 TeamIndex = 0; TeamIndex < FUnitSpatialHash::MaxTeams; ++TeamIndex)
+        {
+            GroupIndices.Reset();
+            GroupOrigins.Reset();
+
+            for (int32 Index = 0; Index < Handles.Num(); ++Index)
+            {
+                const FUnitSlot* Slot = Slots.IsValidIndex(Handles[Index]) ? &Slots[Handles[Index]] : nullptr;
+                if (Slot && Slot->Unit && Slot->BoardId == BoardId && (int32)Slot->Unit->Team == TeamIndex)
+                {
+                    GroupIndices.Add(Index);
+                    GroupOrigins.Add(Slot->Unit->GetActorLocation());
+                }
+            }
+
+            if (GroupIndices.Num() == 0)
+            {
+                continue;
+            }
+
+            SpatialHash->FindNearestBatch(Center, GroupOrigins, TeamIndex, IsCandidate, GroupTargets);
+
+            for (int32 Index = 0; Index < GroupIndices.Num(); ++Index)
+            {
+                OutTargets[GroupIndices[Index]] = GroupTargets[Index];
+            }
+        }
+    }
+
+    TFT_COMBAT_COUNTER(UnitsScanned, NumScanned);
+}
@@ -0,0 +1,146 @@
+// UnitRegistrySubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UnitSpatialHash.h"
+#include "UnitStatStore.h"
+#include "UnitRegistrySubsystem.generated.h"
+
+// Forward declarations
+class AUnitBase;
+class UBoardGridSubsystem;
+
+// ============================================================================
+// UNIT REGISTRY SUBSYSTEM
+// ============================================================================
+
+/**
+ * Owns every unit's handle for the lifetime of the actor. Hot combat stats live in a
+ * structure-of-arrays store indexed by that handle, and targetable units sit in
+ * per-team spatial hash buckets so target queries only touch nearby cells.
+ * Every board (AUnitBase::BoardId) has its own spatial hash, so units only ever
+ * find enemies on their own board.
+ */
+UCLASS()
+class TFTUNREALDEMO_API UUnitRegistrySubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** Board hex width in world units; one hash cell covers one hex. */
+    static constexpr float DefaultCellSize = 200.0f;
+
+    /** Board ids run from 0 to MaxBoards - 1; a lobby of 8 players uses one board each. */
+    static constexpr int32 MaxBoards = 16;
+
+    static int32 ClampBoardId(int32 BoardId) { return FMath::Clamp(BoardId, 0, MaxBoards - 1); }
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // ========================================================================
+    // REGISTRATION
+    // ========================================================================
+
+    /** Adds a unit and returns its handle. The unit starts out targetable. */
+    int32 RegisterUnit(AUnitBase* Unit);
+
+    void UnregisterUnit(int32 Handle);
+
+    /** Adds or removes the unit from the spatial hash (e.g. on death and revival). */
+    void SetUnitTargetable(int32 Handle, bool bTargetable);
+
+    /** Re-buckets the unit if it crossed a cell boundary or changed team or board. */
+    void UpdateUnit(int32 Handle);
+
+    AUnitBase* GetUnit(int32 Handle) const;
+
+    /**
+     * Handles are recycled, so records that outlive a unit store the generation next to the
+     * handle. It changes on every registration and every acquire from the pool.
+     */
+    uint32 GetGeneration(int32 Handle) const { return Generations.IsValidIndex(Handle) ? Generations[Handle] : 0; }
+
+    /** Called when a pooled unit comes back as a new one under its old handle. */
+    void BumpGeneration(int32 Handle);
+
+    /** Handles run from 0 to GetNumHandles() - 1; GetUnit returns null for free ones. */
+    int32 GetNumHandles() const { return Slots.Num(); }
+
+    // ========================================================================
+    // TARGETING
+    // ========================================================================
+
+    /** Records that Handle is attacking TargetHandle (INDEX_NONE clears it) in the reverse index. */
+    void SetUnitTarget(int32 Handle, int32 TargetHandle);
+
+    /** Units currently targeting Handle. */
+    TConstArrayView<int32> GetAttackers(int32 Handle) const;
+
+    /**
+     * Gives every unit targeting Handle a new target from one batched nearest-enemy query.
+     * Called when the unit dies, is benched or leaves the registry.
+     */
+    void RetargetAttackers(int32 Handle);
+
+    UFUNCTION(BlueprintPure, Category = "Units")
+    int32 GetNumRegisteredUnits() const { return NumRegistered; }
+
+    // ========================================================================
+    // STATS
+    // ========================================================================
+
+    FUnitStatStore& GetStatStore() { return StatStore; }
+    const FUnitStatStore& GetStatStore() const { return StatStore; }
+
+    // ========================================================================
+    // QUERIES
+    // ========================================================================
+
+    /** Nearest living, in-combat unit on Unit's board and a different team. */
+    AUnitBase* FindNearestEnemy(const AUnitBase* Unit) const;
+
+    /** FindNearestEnemy for every unit in Handles, searched outward from Center on each unit's board. */
+    void FindNearestEnemies(const FVector& Center, TConstArrayView<int32> Handles, TArray<int32>& OutTargets) const;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FUnitSlot
+    {
+        AUnitBase* Unit = nullptr;
+        FIntPoint Cell = FIntPoint::ZeroValue;
+        int32 TeamIndex = 0;
+        int32 BoardId = 0;
+        bool bTargetable = false;
+
+        /** Reverse targeting index: who this unit attacks and who attacks it. */
+        int32 TargetHandle = INDEX_NONE;
+        TArray<int32> Attackers;
+    };
+
+    /** Moves every unit in play to its current spatial hash and board cell. */
+    void SyncUnitLocations();
+
+    /** Spatial hash of a board, created on first use. */
+    FUnitSpatialHash& GetBoardHash(int32 BoardId);
+    const FUnitSpatialHash* FindBoardHash(int32 BoardId) const;
+
+    TArray<FUnitSlot> Slots;
+
+    /** Per handle; kept when a slot is freed so the next owner gets a new value. */
+    TArray<uint32> Generations;
+    TArray<int32> PendingFreeHandles;
+    TArray<int32> RetargetHandles;
+    TArray<int32> RetargetResults;
+    int32 NumRegistered = 0;
+    TArray<FUnitSpatialHash> BoardHashes;
+    FUnitStatStore StatStore;
+
+    UPROPERTY()
+    UBoardGridSubsystem* BoardGrid;
+};
@@ -0,0 +1,164 @@
+// UnitSignificanceSubsystem.cpp
+
+#include "UnitSignificanceSubsystem.h"
+#include "UnitRegistrySubsystem.h"
+#include "UnitBase.h"
+#include "Camera/PlayerCameraManager.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+// ============================================================================
+// CONSOLE VARIABLES
+// ============================================================================
+
+static bool GUnitLODEnabled = true;
+static FAutoConsoleVariableRef CVarUnitLODEnabled(
+    TEXT("TFT.LOD.Enable"),
+    GUnitLODEnabled,
+    TEXT("Lower tick rate and cosmetic work for units that are off-screen or far from the camera."));
+
+static float GUnitLODUpdateInterval = 0.25f;
+static FAutoConsoleVariableRef CVarUnitLODUpdateInterval(
+    TEXT("TFT.LOD.UpdateInterval"),
+    GUnitLODUpdateInterval,
+    TEXT("Seconds between unit significance updates."));
+
+static float GUnitLODReducedDistance = 3000.0f;
+static FAutoConsoleVariableRef CVarUnitLODReducedDistance(
+    TEXT("TFT.LOD.ReducedDistance"),
+    GUnitLODReducedDistance,
+    TEXT("Camera distance beyond which on-screen units drop to reduced significance."));
+
+static float GUnitLODReducedTickInterval = 0.1f;
+static FAutoConsoleVariableRef CVarUnitLODReducedTickInterval(
+    TEXT("TFT.LOD.ReducedTickInterval"),
+    GUnitLODReducedTickInterval,
+    TEXT("Actor and mesh tick interval of units at reduced significance."));
+
+static float GUnitLODMinimalTickInterval = 0.5f;
+static FAutoConsoleVariableRef CVarUnitLODMinimalTickInterval(
+    TEXT("TFT.LOD.MinimalTickInterval"),
+    GUnitLODMinimalTickInterval,
+    TEXT("Actor and mesh tick interval of units nobody can see."));
+
+static float GUnitLODRenderedTolerance = 0.2f;
+static FAutoConsoleVariableRef CVarUnitLODRenderedTolerance(
+    TEXT("TFT.LOD.RenderedTolerance"),
+    GUnitLODRenderedTolerance,
+    TEXT("Seconds since a unit was last rendered for it to still count as on-screen."));
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+void UUnitSignificanceSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    UnitRegistry = Collection.InitializeDependency<UUnitRegistrySubsystem>();
+}
+
+void UUnitSignificanceSubsystem::Deinitialize()
+{
+    UnitRegistry = nullptr;
+    Stats = FUnitSignificanceStats();
+
+    Super::Deinitialize();
+}
+
+TStatId UUnitSignificanceSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UUnitSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+bool UUnitSignificanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+// ============================================================================
+// UPDATE
+// ============================================================================
+
+void UUnitSignificanceSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    TimeSinceUpdate += DeltaTime;
+    if (TimeSinceUpdate >= GUnitLODUpdateInterval)
+    {
+        UpdateSignificance();
+    }
+}
+
+void UUnitSignificanceSubsystem::UpdateSignificance()
+{
+    TimeSinceUpdate = 0.0f;
+    Stats = FUnitSignificanceStats();
+
+    if (!UnitRegistry)
+    {
+        return;
+    }
+
+    // Dedicated servers and headless runs have no viewer, so nothing is on screen
+    const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+    const APlayerCameraManager* CameraManager = PlayerController ? PlayerController->PlayerCameraManager.Get() : nullptr;
+    const FVector ViewLocation = CameraManager ? CameraManager->GetCameraLocation() : FVector::ZeroVector;
+    const float ReducedDistanceSq = FMath::Square(GUnitLODReducedDistance);
+
+    for (int32 Handle = 0; Handle < UnitRegistry->GetNumHandles(); ++Handle)
+    {
+        AUnitBase* Unit = UnitRegistry->GetUnit(Handle);
+        if (!Unit || Unit->IsInPool())
+        {
+            continue;
+        }
+
+        EUnitSignificance Significance = EUnitSignificance::Full;
+
+        if (GUnitLODEnabled)
+        {
+            if (!CameraManager || !Unit->WasRecentlyRendered(GUnitLODRenderedTolerance))
+            {
+                Significance = EUnitSignificance::Minimal;
+            }
+            else if (FVector::DistSquared(ViewLocation, Unit->GetActorLocation()) > ReducedDistanceSq)
+            {
+                Significance = EUnitSignificance::Reduced;
+            }
+        }
+
+        switch (Significance)
+        {
+        case EUnitSignificance::Full:
+            Unit->SetSignificance(Significance, 0.0f);
+            break;
+
+        case EUnitSignificance::Reduced:
+            Unit->SetSignificance(Significance, GUnitLODReducedTickInterval);
+            break;
+
+        case EUnitSignificance::Minimal:
+            Unit->SetSignificance(Significance, GUnitLODMinimalTickInterval);
+            break;
+        }
+
+        // Counted after the unit had its say; servers keep their units at Full
+        switch (Unit->GetSignificance())
+        {
+        case EUnitSignificance::Full:
+            ++Stats.NumFull;
+            break;
+
+        case EUnitSignificance::Reduced:
+            ++Stats.NumReduced;
+            break;
+
+        case EUnitSignificance::Minimal:
+            ++Stats.NumMinimal;
+            break;
+        }
+    }
+}
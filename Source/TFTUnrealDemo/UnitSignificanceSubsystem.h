@@ -0,0 +1,70 @@
+// UnitSignificanceSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatTypes.h"
+#include "UnitSignificanceSubsystem.generated.h"
+
+// Forward declarations
+class UUnitRegistrySubsystem;
+
+// ============================================================================
+// STRUCTS
+// ============================================================================
+
+/** Units at each significance level after the last update. */
+USTRUCT(BlueprintType)
+struct FUnitSignificanceStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Significance")
+    int32 NumFull = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Significance")
+    int32 NumReduced = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Significance")
+    int32 NumMinimal = 0;
+};
+
+// ============================================================================
+// UNIT SIGNIFICANCE SUBSYSTEM
+// ============================================================================
+
+/**
+ * Rates every unit in play against the local player's camera a few times per second
+ * (TFT.LOD.UpdateInterval). Units rendered near the camera stay at Full; rendered units
+ * past TFT.LOD.ReducedDistance drop to Reduced; units off-screen (other players' boards
+ * included) or in a world without a viewer drop to Minimal. Lower levels only slow the
+ * actor and mesh ticks and skip cosmetic work, so fights play out the same at any level.
+ */
+UCLASS()
+class TFTUNREALDEMO_API UUnitSignificanceSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    /** Re-rates every unit now instead of at the next interval. */
+    UFUNCTION(BlueprintCallable, Category = "Significance")
+    void UpdateSignificance();
+
+    UFUNCTION(BlueprintPure, Category = "Significance")
+    FUnitSignificanceStats GetStats() const { return Stats; }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    UPROPERTY()
+    UUnitRegistrySubsystem* UnitRegistry;
+
+    FUnitSignificanceStats Stats;
+    float TimeSinceUpdate = 0.0f;
+};
@@ -0,0 +1,98 @@
+// UnitSpatialHash.cpp
+
+#include "UnitSpatialHash.h"
+
+FUnitSpatialHash::FUnitSpatialHash(float InCellSize)
+{
+    SetCellSize(InCellSize);
+}
+
+void FUnitSpatialHash::SetCellSize(float InCellSize)
+{
+    check(InCellSize > 0.0f);
+    checkf(Buckets[0].Count + Buckets[1].Count + Buckets[2].Count == 0, TEXT("Cannot resize a populated spatial hash"));
+
+    CellSize = InCellSize;
+    InvCellSize = 1.0f / InCellSize;
+}
+
+FIntPoint FUnitSpatialHash::GetCell(const FVector& Location) const
+{
+    return FIntPoint(
+        FMath::FloorToInt32(Location.X * InvCellSize),
+        FMath::FloorToInt32(Location.Y * InvCellSize));
+}
+
+void FUnitSpatialHash::Add(int32 Handle, int32 TeamIndex, const FIntPoint& Cell)
+{
+    check(TeamIndex >= 0 && TeamIndex < MaxTeams);
+
+    FTeamBucket& Bucket = Buckets[TeamIndex];
+    Bucket.Cells.FindOrAdd(Cell).Add(Handle);
+    Bucket.BoundsMin = Bucket.BoundsMin.ComponentMin(Cell);
+    Bucket.BoundsMax = Bucket.BoundsMax.ComponentMax(Cell);
+    ++Bucket.Count;
+}
+
+void FUnitSpatialHash::Remove(int32 Handle, int32 TeamIndex, const FIntPoint& Cell)
+{
+    check(TeamIndex >= 0 && TeamIndex < MaxTeams);
+
+    FTeamBucket& Bucket = Buckets[TeamIndex];
+    if (TArray<int32>* Handles = Bucket.Cells.Find(Cell))
+    {
+        if (Handles->RemoveSingleSwap(Handle, EAllowShrinking::No) > 0)
+        {
+            --Bucket.Count;
+        }
+    }
+
+    // Bounds are grow-only; the board is finite so they settle after the first round
+    if (Bucket.Count == 0)
+    {
+        Bucket.BoundsMin = FIntPoint(MAX_int32, MAX_int32);
+        Bucket.BoundsMax = FIntPoint(MIN_int32, MIN_int32);
+    }
+}
+
+void FUnitSpatialHash::Move(int32 Handle, int32 TeamIndex, const FIntPoint& OldCell, const FIntPoint& NewCell)
+{
+    if (OldCell == NewCell)
+    {
+        return;
+    }
+
+    Remove(Handle, TeamIndex, OldCell);
+    Add(Handle, TeamIndex, NewCell);
+}
+
+void FUnitSpatialHash::Reset()
+{
+    for (FTeamBucket& Bucket : Buckets)
+    {
+        Bucket = FTeamBucket();
+    }
+}
+
+
+bool FUnitSpatialHash::GetSearchBounds(int32 ExcludedTeam, FIntPoint& OutMin, FIntPoint& OutMax) const
+{
+    OutMin = FIntPoint(MAX_int32, MAX_int32);
+    OutMax = FIntPoint(MIN_int32, MIN_int32);
+    bool bAnyCandidates = false;
+
+    for (int32 TeamIndex = 0; TeamIndex < MaxTeams; ++TeamIndex)
+    {
+        const FTeamBucket& Bucket = Buckets[TeamIndex];
+        if (TeamIndex == ExcludedTeam || Bucket.Count == 0)
+        {
+            continue;
+        }
+
+        OutMin = OutMin.ComponentMin(Bucket.BoundsMin);
+        OutMax = OutMax.ComponentMax(Bucket.BoundsMax);
+        bAnyCandidates = true;
+    }
+
+    return bAnyCandidates;
+}
@@ -0,0 +1,255 @@
+// UnitSpatialHash.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+// ============================================================================
+// SPATIAL HASH
+// ============================================================================
+
+/**
+ * Uniform 2D grid of unit handles, bucketed per team.
+ * Cells are never freed once created, so steady-state moves and queries do not allocate.
+ */
+class TFTUNREALDEMO_API FUnitSpatialHash
+{
+public:
+    static constexpr int32 MaxTeams = 3;
+
+    explicit FUnitSpatialHash(float InCellSize = 200.0f);
+
+    /** Changes the cell size. Only valid while the hash is empty. */
+    void SetCellSize(float InCellSize);
+    float GetCellSize() const { return CellSize; }
+
+    FIntPoint GetCell(const FVector& Location) const;
+
+    void Add(int32 Handle, int32 TeamIndex, const FIntPoint& Cell);
+    void Remove(int32 Handle, int32 TeamIndex, const FIntPoint& Cell);
+    void Move(int32 Handle, int32 TeamIndex, const FIntPoint& OldCell, const FIntPoint& NewCell);
+    void Reset();
+
+    int32 Num(int32 TeamIndex) const { return Buckets[TeamIndex].Count; }
+
+    /**
+     * Returns the closest handle belonging to any team other than ExcludedTeam, or INDEX_NONE.
+     * DistanceSquaredFunc(Handle, OutDistanceSquared) returns false to reject a candidate.
+     * Ties are broken towards the lower handle so results do not depend on bucket order.
+     */
+    template <typename DistanceFuncType>
+    int32 FindNearest(const FVector& Origin, int32 ExcludedTeam, DistanceFuncType&& DistanceSquaredFunc) const;
+
+    /**
+     * FindNearest for a group of origins clustered around Center, e.g. every attacker of a unit
+     * that just died. Cells are walked outward from Center once and CandidateFunc(Handle, OutLocation)
+     * is called once per candidate, returning false to reject it. OutHandles[i] is the handle
+     * FindNearest would return for Origins[i].
+     */
+    template <typename CandidateFuncType>
+    void FindNearestBatch(const FVector& Center, TConstArrayView<FVector> Origins, int32 ExcludedTeam,
+        CandidateFuncType&& CandidateFunc, TArray<int32>& OutHandles) const;
+
+private:
+    struct FTeamBucket
+    {
+        TMap<FIntPoint, TArray<int32>> Cells;
+        FIntPoint BoundsMin = FIntPoint(MAX_int32, MAX_int32);
+        FIntPoint BoundsMax = FIntPoint(MIN_int32, MIN_int32);
+        int32 Count = 0;
+    };
+
+    /** Cell range covering every team except ExcludedTeam. False if there are no candidates. */
+    bool GetSearchBounds(int32 ExcludedTeam, FIntPoint& OutMin, FIntPoint& OutMax) const;
+
+    /** Calls CellFunc(Cell) for every cell exactly Ring cells away from Center (Chebyshev distance). */
+    template <typename CellFuncType>
+    static void ForEachCellInRing(const FIntPoint& Center, int32 Ring, CellFuncType&& CellFunc);
+
+    template <typename HandleFuncType>
+    void ForEachCandidateInCell(const FIntPoint& Cell, int32 ExcludedTeam, HandleFuncType&& HandleFunc) const;
+
+    template <typename DistanceFuncType>
+    void VisitCell(const FIntPoint& Cell, int32 ExcludedTeam, DistanceFuncType& DistanceSquaredFunc,
+        int32& BestHandle, double& BestDistanceSq) const;
+
+    float CellSize;
+    float InvCellSize;
+    FTeamBucket Buckets[MaxTeams];
+};
+
+// ============================================================================
+// TEMPLATE IMPLEMENTATION
+// ============================================================================
+
+template <typename CellFuncType>
+void FUnitSpatialHash::ForEachCellInRing(const FIntPoint& Center, int32 Ring, CellFuncType&& CellFunc)
+{
+    if (Ring == 0)
+    {
+        CellFunc(Center);
+        return;
+    }
+
+    for (int32 X = Center.X - Ring; X <= Center.X + Ring; ++X)
+    {
+        CellFunc(FIntPoint(X, Center.Y - Ring));
+        CellFunc(FIntPoint(X, Center.Y + Ring));
+    }
+
+    for (int32 Y = Center.Y - Ring + 1; Y <= Center.Y + Ring - 1; ++Y)
+    {
+        CellFunc(FIntPoint(Center.X - Ring, Y));
+        CellFunc(FIntPoint(Center.X + Ring, Y));
+    }
+}
+
+template <typename HandleFuncType>
+void FUnitSpatialHash::ForEachCandidateInCell(const FIntPoint& Cell, int32 ExcludedTeam, HandleFuncType&& HandleFunc) const
+{
+    for (int32 TeamIndex = 0; TeamIndex < MaxTeams; ++TeamIndex)
+    {
+        if (TeamIndex == ExcludedTeam || Buckets[TeamIndex].Count == 0)
+        {
+            continue;
+        }
+
+        if (const TArray<int32>* Handles = Buckets[TeamIndex].Cells.Find(Cell))
+        {
+            for (const int32 Handle : *Handles)
+            {
+                HandleFunc(Handle);
+            }
+        }
+    }
+}
+
+template <typename DistanceFuncType>
+void FUnitSpatialHash::VisitCell(const FIntPoint& Cell, int32 ExcludedTeam, DistanceFuncType& DistanceSquaredFunc,
+    int32& BestHandle, double& BestDistanceSq) const
+{
+    ForEachCandidateInCell(Cell, ExcludedTeam, [&](int32 Handle)
+    {
+        double DistanceSq = 0.0;
+        if (!DistanceSquaredFunc(Handle, DistanceSq))
+        {
+            return;
+        }
+
+        if (DistanceSq < BestDistanceSq || (DistanceSq == BestDistanceSq && Handle < BestHandle))
+        {
+            BestDistanceSq = DistanceSq;
+            BestHandle = Handle;
+        }
+    });
+}
+
+template <typename DistanceFuncType>
+int32 FUnitSpatialHash::FindNearest(const FVector& Origin, int32 ExcludedTeam, DistanceFuncType&& DistanceSquaredFunc) const
+{
+    // Only walk as far as the furthest occupied cell of any candidate team
+    FIntPoint SearchMin;
+    FIntPoint SearchMax;
+    if (!GetSearchBounds(ExcludedTeam, SearchMin, SearchMax))
+    {
+        return INDEX_NONE;
+    }
+
+    const FIntPoint Center = GetCell(Origin);
+    const int32 MaxRing = FMath::Max(
+        FMath::Max(FMath::Abs(Center.X - SearchMin.X), FMath::Abs(SearchMax.X - Center.X)),
+        FMath::Max(FMath::Abs(Center.Y - SearchMin.Y), FMath::Abs(SearchMax.Y - Center.Y)));
+
+    int32 BestHandle = INDEX_NONE;
+    double BestDistanceSq = TNumericLimits<double>::Max();
+
+    for (int32 Ring = 0; Ring <= MaxRing; ++Ring)
+    {
+        // Every cell in this ring is at least (Ring - 1) cells away from the origin
+        if (BestHandle != INDEX_NONE && Ring > 1)
+        {
+            const double RingDistance = (Ring - 1) * (double)CellSize;
+            if (RingDistance * RingDistance > BestDistanceSq)
+            {
+                break;
+            }
+        }
+
+        ForEachCellInRing(Center, Ring, [&](const FIntPoint& Cell)
+        {
+            VisitCell(Cell, ExcludedTeam, DistanceSquaredFunc, BestHandle, BestDistanceSq);
+        });
+    }
+
+    return BestHandle;
+}
+
+template <typename CandidateFuncType>
+void FUnitSpatialHash::FindNearestBatch(const FVector& Center, TConstArrayView<FVector> Origins, int32 ExcludedTeam,
+    CandidateFuncType&& CandidateFunc, TArray<int32>& OutHandles) const
+{
+    OutHandles.Init(INDEX_NONE, Origins.Num());
+
+    FIntPoint SearchMin;
+    FIntPoint SearchMax;
+    if (Origins.Num() == 0 || !GetSearchBounds(ExcludedTeam, SearchMin, SearchMax))
+    {
+        return;
+    }
+
+    const FIntPoint CenterCell = GetCell(Center);
+    const int32 MaxRing = FMath::Max(
+        FMath::Max(FMath::Abs(CenterCell.X - SearchMin.X), FMath::Abs(SearchMax.X - CenterCell.X)),
+        FMath::Max(FMath::Abs(CenterCell.Y - SearchMin.Y), FMath::Abs(SearchMax.Y - CenterCell.Y)));
+
+    TArray<double, TInlineAllocator<16>> BestDistanceSq;
+    TArray<double, TInlineAllocator<16>> CenterOffsets;
+    BestDistanceSq.Init(TNumericLimits<double>::Max(), Origins.Num());
+    CenterOffsets.SetNumUninitialized(Origins.Num());
+    for (int32 Index = 0; Index < Origins.Num(); ++Index)
+    {
+        CenterOffsets[Index] = FVector::Dist2D(Origins[Index], Center);
+    }
+
+    for (int32 Ring = 0; Ring <= MaxRing; ++Ring)
+    {
+        // Cells in this ring are at least (Ring - 1) cells from Center, so no closer than
+        // that minus the origin's own offset from Center
+        if (Ring > 1)
+        {
+            bool bAllResolved = true;
+            for (int32 Index = 0; Index < Origins.Num() && bAllResolved; ++Index)
+            {
+                const double RingDistance = (Ring - 1) * (double)CellSize - CenterOffsets[Index];
+                bAllResolved = OutHandles[Index] != INDEX_NONE && RingDistance > 0.0
+                    && RingDistance * RingDistance > BestDistanceSq[Index];
+            }
+
+            if (bAllResolved)
+            {
+                break;
+            }
+        }
+
+        ForEachCellInRing(CenterCell, Ring, [&](const FIntPoint& Cell)
+        {
+            ForEachCandidateInCell(Cell, ExcludedTeam, [&](int32 Handle)
+            {
+                FVector Location;
+                if (!CandidateFunc(Handle, Location))
+                {
+                    return;
+                }
+
+                for (int32 Index = 0; Index < Origins.Num(); ++Index)
+                {
+                    const double DistanceSq = FVector::DistSquared(Origins[Index], Location);
+                    if (DistanceSq < BestDistanceSq[Index] || (DistanceSq == BestDistanceSq[Index] && Handle < OutHandles[Index]))
+                    {
+                        BestDistanceSq[Index] = DistanceSq;
+                        OutHandles[Index] = Handle;
+                    }
+                }
+            });
+        });
+    }
+}
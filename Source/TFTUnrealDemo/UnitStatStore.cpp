@@ -0,0 +1,115 @@
+// UnitStatStore.cpp
+
+#include "UnitStatStore.h"
+#include "CombatSnapshot.h"
+#include "Math/VectorRegister.h"
+
+// ============================================================================
+// HANDLES
+// ============================================================================
+
+int32 FUnitStatStore::Allocate()
+{
+    if (FreeHandles.Num() > 0)
+    {
+        return FreeHandles.Pop(EAllowShrinking::No);
+    }
+
+    if (NumSlots == NumPadded())
+    {
+        Grow();
+    }
+
+    return NumSlots++;
+}
+
+void FUnitStatStore::Free(int32 Handle)
+{
+    check(Handle >= 0 && Handle < NumSlots);
+
+    ZeroSlot(Handle);
+    FreeHandles.Add(Handle);
+}
+
+void FUnitStatStore::Reset()
+{
+    ForEachArray([](FStatArray& Array) { Array.Reset(); });
+
+    FreeHandles.Reset();
+    NumSlots = 0;
+}
+
+void FUnitStatStore::Serialize(FArchive& Ar)
+{
+    Ar << NumSlots;
+    CombatSnapshot::SerializeRawArray(Ar, FreeHandles);
+    ForEachArray([&Ar](FStatArray& Array) { CombatSnapshot::SerializeRawArray(Ar, Array); });
+
+    if (Ar.IsLoading() && (NumPadded() % SimdWidth != 0 || NumSlots > NumPadded()))
+    {
+        Ar.SetError();
+    }
+}
+
+void FUnitStatStore::Grow()
+{
+    ForEachArray([](FStatArray& Array) { Array.AddZeroed(SimdWidth); });
+}
+
+void FUnitStatStore::ZeroSlot(int32 Handle)
+{
+    ForEachArray([Handle](FStatArray& Array) { Array[Handle] = 0.0f; });
+}
+
+// ============================================================================
+// BATCH KERNELS
+// ============================================================================
+
+void FUnitStatStore::DecrementCooldowns(float DeltaTime)
+{
+    const VectorRegister4Float Delta = VectorSetFloat1(DeltaTime);
+    const VectorRegister4Float Zero = VectorZeroFloat();
+
+    float* Cooldowns = AttackCooldown.GetData();
+    const float* Mask = CooldownMask.GetData();
+
+    for (int32 Index = 0; Index < NumPadded(); Index += SimdWidth)
+    {
+        const VectorRegister4Float Cooldown = VectorLoadAligned(Cooldowns + Index);
+        const VectorRegister4Float Active = VectorBitwiseAnd(
+            VectorCompareGT(VectorLoadAligned(Mask + Index), Zero),
+            VectorCompareGT(Cooldown, Zero));
+
+        VectorStoreAligned(VectorSelect(Active, VectorSubtract(Cooldown, Delta), Cooldown), Cooldowns + Index);
+    }
+}
+
+void FUnitStatStore::ComputeInRange(const float* DistanceSq, float* OutMask) const
+{
+    const VectorRegister4Float One = VectorSetFloat1(1.0f);
+    const VectorRegister4Float Zero = VectorZeroFloat();
+
+    const float* Ranges = AttackRange.GetData();
+
+    for (int32 Index = 0; Index < NumPadded(); Index += SimdWidth)
+    {
+        const VectorRegister4Float Range = VectorLoadAligned(Ranges + Index);
+        const VectorRegister4Float InRange = VectorCompareLE(VectorLoad(DistanceSq + Index), VectorMultiply(Range, Range));
+
+        VectorStore(VectorSelect(InRange, One, Zero), OutMask + Index);
+    }
+}
+
+void FUnitStatStore::ReduceDamage(const float* Amounts, const float* Resists, float* OutDamage, int32 Num)
+{
+    check(Num % SimdWidth == 0);
+
+    // Same operation order as FCombatRules::CalculateDamageReduction so results are bit-identical
+    const VectorRegister4Float Hundred = VectorSetFloat1(100.0f);
+
+    for (int32 Index = 0; Index < Num; Index += SimdWidth)
+    {
+        const VectorRegister4Float Multiplier = VectorDivide(Hundred, VectorAdd(Hundred, VectorLoad(Resists + Index)));
+        VectorStore(VectorMultiply(VectorLoad(Amounts + Index), Multiplier), OutDamage + Index);
+    }
+}
@@ -0,0 +1,79 @@
+// UnitStatStore.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/ContainerAllocationPolicies.h"
+
+// ============================================================================
+// UNIT STAT STORE
+// ============================================================================
+
+/**
+ * Structure-of-arrays storage for hot per-unit combat stats, indexed by unit handle.
+ * Every array is 16-byte aligned and padded to a multiple of the SIMD width so the
+ * batch kernels can run over whole vector registers without scalar tails.
+ * Padding and free slots hold zeroes and are masked out of every kernel.
+ */
+struct TFTUNREALDEMO_API FUnitStatStore
+{
+    static constexpr int32 SimdWidth = 4;
+
+    using FStatArray = TArray<float, TAlignedHeapAllocator<16>>;
+
+    FStatArray CurrentHealth;
+    FStatArray CurrentMana;
+    FStatArray AttackCooldown;
+    FStatArray Armor;
+    FStatArray MagicResist;
+    FStatArray AttackSpeed;
+    FStatArray AttackDamage;
+    FStatArray AttackRange;
+
+    /** 1.0 for units whose cooldowns run this frame (alive, in combat, not casting), otherwise 0.0. */
+    FStatArray CooldownMask;
+
+    // ========================================================================
+    // HANDLES
+    // ========================================================================
+
+    /** Returns a zeroed slot. */
+    int32 Allocate();
+    void Free(int32 Handle);
+    void Reset();
+
+    /** Number of slots including padding; always a multiple of SimdWidth. */
+    int32 NumPadded() const { return CurrentHealth.Num(); }
+
+    /** Saves or restores every array and the free list; handles stay valid across a restore. */
+    void Serialize(FArchive& Ar);
+
+    // ========================================================================
+    // BATCH KERNELS
+    // ========================================================================
+
+    /** Cooldown -= DeltaTime for every masked-in unit whose cooldown is still positive. */
+    void DecrementCooldowns(float DeltaTime);
+
+    /** OutMask[i] = DistanceSq[i] <= AttackRange[i]^2 ? 1 : 0. DistanceSq must be NumPadded() long. */
+    void ComputeInRange(const float* DistanceSq, float* OutMask) const;
+
+    /** Out[i] = Amount[i] * 100 / (100 + Resist[i]). Num must be a multiple of SimdWidth. */
+    static void ReduceDamage(const float* Amounts, const float* Resists, float* OutDamage, int32 Num);
+
+private:
+    void Grow();
+    void ZeroSlot(int32 Handle);
+
+    template <typename FuncType>
+    void ForEachArray(FuncType&& Func)
+    {
+        for (FStatArray* Array : { &CurrentHealth, &CurrentMana, &AttackCooldown, &Armor, &MagicResist,
+            &AttackSpeed, &AttackDamage, &AttackRange, &CooldownMask })
+        {
+            Func(*Array);
+        }
+    }
+
+    TArray<int32> FreeHandles;
+    int32 NumSlots = 0;
+};